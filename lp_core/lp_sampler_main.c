@@ -0,0 +1,46 @@
+/*******************************************************************************
+ * LP-core sampling program (ESP32-C6 low-power RISC-V core)
+ *
+ * Runs once per LP timer period while the HP core is in deep sleep:
+ * reads the tank and brightness (ignition) channels, decimates them into
+ * the ring buffer in LP SRAM and wakes the HP core when a threshold is
+ * crossed or the buffer fills. All decision logic lives in the shared
+ * header src/sensor/lp_sample_logic.h, which is unit-tested natively.
+ *
+ * Not built by PlatformIO's Arduino framework. In an ESP-IDF build, embed
+ * it from the main component with:
+ *   ulp_embed_binary(lp_sampler "../lp_core/lp_sampler_main.c" "main.cpp")
+ * and add src/ to the LP include path so config.h is found.
+ ******************************************************************************/
+
+#include <stdint.h>
+#include "ulp_lp_core_utils.h"
+#include "ulp_lp_core_lp_adc_shared.h"
+#include "config.h"
+#include "sensor/lp_sample_logic.h"
+
+// Shared with the HP core as ulp_lp_shared (configured before sleep)
+LpSampleState lp_shared;
+
+// On the C6, GPIO0-6 map to ADC1 channels 0-6
+static uint16_t lp_read_channel(int gpio) {
+    int raw = 0;
+    if (lp_core_lp_adc_read_channel_raw(ADC_UNIT_1, (adc_channel_t)gpio, &raw) != ESP_OK) {
+        return 0;
+    }
+    return (uint16_t)raw;
+}
+
+int main(void) {
+    uint16_t raw[LP_CHANNELS];
+    raw[LP_CH_TANK1] = lp_read_channel(PIN_TANK1_ADC);
+    raw[LP_CH_TANK2] = lp_read_channel(PIN_TANK2_ADC);
+    raw[LP_CH_IGNITION] = lp_read_channel(PIN_BRIGHTNESS_ADC);
+
+    if (lp_logic_push(&lp_shared, raw) != LP_WAKE_NONE) {
+        ulp_lp_core_wakeup_main_processor();
+    }
+
+    // Returning halts the LP core until the next LP timer wake-up
+    return 0;
+}
@@ -33,6 +33,7 @@
 
 // Debug mode settings (only used when MODE_DEBUG = 1)
 #define DEBUG_UPDATE_RATE_MS  200     // How often to update debug info
+#define DEBUG_HYSTERESIS_STEPS 1.0f   // Overlay values change only past a rounding boundary by this many display steps
 
 //==============================================================================
 // HARDWARE PINS - LCD (Fixed by Waveshare hardware, do not change)
@@ -133,6 +134,7 @@
 
 #define SENDER_R_FULL         33.0f   // Resistance when tank is FULL (ohms)
 #define SENDER_R_EMPTY        240.0f  // Resistance when tank is EMPTY (ohms)
+#define SENDER_R_TOLERANCE    10.0f   // Readings this far outside the range are still valid (ohms)
 
 //==============================================================================
 // ADC CONFIGURATION
@@ -146,24 +148,119 @@
 // SIGNAL FILTERING / SMOOTHING
 //==============================================================================
 // Exponential Moving Average (EMA) smoothing for fuel sensor readings
-// Lower alpha = smoother but slower response
-// Higher alpha = faster response but more noise
-// Range: 0.0 to 1.0
+// The filter gain is computed from the real time between samples, so the
+// response is set in seconds and does not change with loop or render timing:
+//   alpha = 1 - exp(-dt / tau)
+// Larger tau = smoother but slower response (63% of a step after tau seconds)
 
 #define FUEL_DAMPING_ENABLE   1         // 1=Enable EMA damping, 0=Disable
-#define FUEL_DAMPING_ALPHA    0.10f     // EMA smoothing factor (0.05=very smooth, 0.5=fast response)
-#define MIN_CHANGE_PERCENT    1         // Minimum % change to trigger display update
+#define FUEL_DAMPING_TAU_S    0.5f      // EMA time constant in seconds (2.0=very smooth, 0.1=fast)
+
+// Display hysteresis: a shown value (bar pixel, gallons, percent) that turns
+// back changes only once the level has passed its rounding boundary by this
+// much, so a level sitting on a boundary does not flicker (0 = plain rounding)
+#define MIN_CHANGE_PERCENT    0.25f     // Hysteresis past a rounding boundary (% of tank)
+
+//==============================================================================
+// MULTI-TANK SUMMARY (Total / Balance / Transfer)
+//==============================================================================
+// Aggregates the already-filtered tank levels - no extra ADC reads.
+// A transfer is reported when one tank rises while the other falls, each
+// by at least TRANSFER_MIN_RATE_GPM over the measurement window.
+
+#define TANK_SUMMARY_ENABLE     1         // 1=Show summary column between bars, 0=Hide
+#define TRANSFER_RATE_WINDOW_MS 5000      // Window for measuring tank level rates (ms)
+#define TRANSFER_MIN_RATE_GPM   0.2f      // Minimum rate per tank to count as a transfer (gal/min)
+
+//==============================================================================
+// TRIP COMPUTER (Vehicle Speed Sensor)
+//==============================================================================
+// Counts VSS pulses in hardware (PCNT) - no per-pulse interrupt work.
+// Distance and fuel used are kept as integer accumulators (pulses and
+// milligallons) so they never drift; miles/MPG/range are derived on display.
+//
+// The VSS signal must be conditioned to 3.3V logic (opto-isolator or divider).
+
+#define TRIP_COMPUTER_ENABLE    1         // 1=Enable trip page and pulse counting
+#define PIN_SPEED_PULSE         21        // GPIO21 (spare) - vehicle speed sensor input
+#define SPEED_PULSES_PER_MILE   4000      // VSS pulses per mile (4000 is common for GM)
+#define SPEED_PCNT_GLITCH_NS    1000      // Ignore pulses shorter than this (ns)
+#define TRIP_REFUEL_GALLONS     2.0f      // Level rise treated as a refuel (gallons)
+#define TRIP_RESET_ON_REFUEL    1         // 1=Trip restarts at each refuel, 0=Manual only
+#define TRIP_MIN_MILES_FOR_MPG  1         // Distance before trip MPG is used for range
+#define TRIP_SAVE_INTERVAL_MS   300000    // Lifetime totals saved to flash this often (ms)
+
+//==============================================================================
+// FUEL HISTORY PAGE
+//==============================================================================
+// Strip chart of the filtered levels. Each zoom level keeps its own ring of
+// samples, every one the average of HISTORY_ZOOM_FACTOR samples of the level
+// below. New samples scroll in with the panel's hardware vertical scroll.
+
+#define HISTORY_PAGE_ENABLE     1         // 1=Enable the history page (BOOT steps through zoom levels)
+#define HISTORY_SAMPLE_MS       10000     // Zoom 0 sample interval (ms)
+#define HISTORY_SAMPLES         280       // Samples kept per zoom level (one per chart row)
+#define HISTORY_ZOOM_LEVELS     3         // Zoom levels (10 s, 1 min, 6 min per row by default)
+#define HISTORY_ZOOM_FACTOR     6         // Samples averaged into one sample of the next level
+
+//==============================================================================
+// LOW-POWER CORE SAMPLING (Ignition Off)
+//==============================================================================
+// With ignition off the HP core deep-sleeps while the ESP32-C6 LP RISC-V core
+// keeps sampling the tank and brightness (ignition/dimmer) channels on its
+// timer. Decimated samples are kept in LP SRAM; the HP core is woken on
+// ignition on, a level drop, or a full buffer, and ingests the batch.
+//
+// Requires an ESP-IDF build with the LP core enabled
+// (CONFIG_ULP_COPROC_ENABLED, CONFIG_ULP_COPROC_TYPE_LP_CORE) and the
+// program in lp_core/ embedded with ulp_embed_binary(). DISABLED BY DEFAULT.
+
+#define LP_SAMPLER_ENABLE       0         // 0=Disabled, 1=Enabled
+#define LP_SAMPLE_PERIOD_MS     500       // LP timer period between raw samples (ms)
+#define LP_DECIMATION           8         // Raw samples averaged per stored sample
+#define LP_BUFFER_SIZE          32        // Decimated samples kept in LP SRAM
+#define LP_IGNITION_ON_VOLTS    10.0f     // Brightness input above this = ignition on (V)
+#define LP_IGNITION_OFF_DELAY_MS 30000    // Ignition must stay off this long before sleep (ms)
+#define LP_LEVEL_DROP_PERCENT   5.0f      // Wake if a tank falls this much while asleep (%)
 
 //==============================================================================
 // DISPLAY CONFIGURATION
 //==============================================================================
-#define SCREEN_WIDTH          170     // LCD width in pixels
-#define SCREEN_HEIGHT         320     // LCD height in pixels
+// Board (Waveshare ESP32-C6 ST7789 module; sets panel size and RAM offsets)
+#define BOARD_LCD_1_9         0       // 1.9"  170x320
+#define BOARD_LCD_1_69        1       // 1.69" 240x280
+#define BOARD_LCD_1_47        2       // 1.47" 172x320
+#define BOARD_LCD             BOARD_LCD_1_9
+
 #define SCREEN_ROTATION       0       // 0=Portrait, 1=Landscape, 2=Portrait180, 3=Landscape180
 
+// Screen size after rotation (from the board descriptor, do not edit)
+#define SCREEN_WIDTH          ((SCREEN_ROTATION & 1) ? LCD_PANEL_HEIGHT : LCD_PANEL_WIDTH)
+#define SCREEN_HEIGHT         ((SCREEN_ROTATION & 1) ? LCD_PANEL_WIDTH : LCD_PANEL_HEIGHT)
+
 // Backlight
 #define BACKLIGHT_ACTIVE_LOW  1       // 1 = LOW turns on backlight, 0 = HIGH turns on
 
+// Rendering
+#define GAUGE_SPRITE_ENABLE   1       // 1 = Compose each gauge off-screen (~40KB RAM per buffer), push with one DMA transfer
+#define DISPLAY_CANVAS_BUFFERS 2      // Canvases used in turn: one is drawn while the last push is on the bus
+#define DISPLAY_BATCH_ENABLE  1       // 1 = Queue and coalesce fills per frame, flush in one bus transaction
+#define DISPLAY_BATCH_MAX_CMDS 96     // Queued commands before an early flush
+#define DISPLAY_CLIP_MAX      4       // Excluded regions on the clip stack
+#define GAUGE_BAR_STREAM_ENABLE 1     // 1 = Uncomposed bars stream one color per row through one window
+#define GLYPH_CACHE_ENABLE    1       // 1 = Readouts blit pre-rendered glyphs (~5KB RAM), changed chars only
+#define PAGE_CACHE_ENABLE     1       // 1 = Page backgrounds kept run-length encoded, restored in one push
+#define PAGE_CACHE_BYTES      24576   // RAM for cached page backgrounds (4 bytes per run)
+#define PAGE_CACHE_BAND_ROWS  32      // Canvas rows used while encoding a background
+#define PAGE_MAX              4       // Pages the compositor can hold
+#define UI_WIDGET_MAX         12      // Widgets in the retained UI tree (at most 32)
+#define UI_DAMAGE_MAX         8       // Damage rects per frame before they are merged
+#define UI_BAND_ROWS          16      // Row band height of the widget lookup index
+#define DISPLAY_INDEXED_ENABLE 0      // 1 = Draw into a 4 bpp full-screen frame (~34KB RAM), push changed rows
+#define DISPLAY_INDEXED_CHUNK_ROWS 8  // Rows expanded to RGB565 per DMA transfer (two buffers)
+#define DISPLAY_ASYNC_ENABLE  1       // 1 = Indexed frames pushed by a background task; no effect while DISPLAY_INDEXED_ENABLE is 0
+#define ASSET_SPLASH_ENABLE   1       // 1 = Boot splash (flash asset) while sensors initialize
+
 //==============================================================================
 // GAUGE APPEARANCE
 //==============================================================================
@@ -171,6 +268,16 @@
 #define GAUGE_BORDER_WIDTH    2       // Border thickness around bars
 #define GAUGE_SEGMENTS        20      // Number of visual segment lines
 #define GAUGE_SEGMENT_LINE_W  1       // Segment divider line width (pixels)
+#define GAUGE_GRADIENT_ENABLE 0       // 1 = Smooth red->yellow->green blend, 0 = discrete zones
+
+// Gauge widget
+#define GAUGE_STYLE_BAR       0       // Two vertical bars side by side
+#define GAUGE_STYLE_DIAL      1       // Two round dials stacked
+#define GAUGE_STYLE           GAUGE_STYLE_BAR
+#define DIAL_RADIUS           72      // Outer radius of the dial band (pixels)
+#define DIAL_THICKNESS        14      // Width of the dial band (pixels)
+#define DIAL_SWEEP_DEG        270     // Arc sweep, gap centred at the bottom
+#define DIAL_STEPS            200     // Fill resolution over the sweep (max 254)
 
 //==============================================================================
 // COLOR THRESHOLDS (Percentage)
@@ -184,6 +291,22 @@
 #define THRESHOLD_YELLOW_MAX  40      // 20-40% = Yellow zone
                                       // 40-100% = Green zone
 
+//==============================================================================
+// LOW FUEL ALERT
+//==============================================================================
+// Below the alert level the lit red zone of that tank's bar animates. Only
+// those rows are repainted on each toggle; the rest of the bar is untouched.
+#define LOW_FUEL_ALERT_ENABLE 1       // 1 = Animate the red zone of a low tank (bar style)
+#define LOW_FUEL_ALERT_PERCENT 15     // Alert starts below this level (%)
+#define LOW_FUEL_ALERT_CLEAR  18      // Alert ends above this level (%)
+#define LOW_FUEL_EFFECT_BLINK  0      // Red zone flashes to the empty color
+#define LOW_FUEL_EFFECT_PULSE  1      // Red zone fades toward empty and back
+#define LOW_FUEL_EFFECT_INVERT 2      // Red zone flashes in its inverted color
+#define LOW_FUEL_ALERT_EFFECT LOW_FUEL_EFFECT_BLINK
+#define LOW_FUEL_BLINK_MS     500     // Time between blink/invert toggles
+#define LOW_FUEL_PULSE_MS     1600    // Full fade out and back
+#define LOW_FUEL_PULSE_STEPS  8       // Color steps per fade (each one repaint)
+
 //==============================================================================
 // COLORS (RGB565 Format)
 //==============================================================================
@@ -220,6 +343,9 @@
 #define MAIN_LOOP_INTERVAL_MS 50      // Main loop update interval
 #define DISPLAY_REFRESH_MS    50      // Display update interval
 #define SENSOR_READ_MS        50      // Sensor reading interval
+#define GAUGE_ANIM_ENABLE     1       // 1 = Tween bars toward new levels between sensor updates
+#define GAUGE_ANIM_FRAME_MS   16      // Animation frame interval while a bar is moving (~60 fps)
+#define GAUGE_ANIM_DURATION_MS 400    // Time for a bar to reach a new level
 
 //==============================================================================
 // TANK LABELS
@@ -241,6 +367,7 @@
 #define LCD_PIN_CS            PIN_LCD_CS
 #define LCD_PIN_RST           PIN_LCD_RST
 #define LCD_PIN_BL            PIN_LCD_BL
+#define LCD_SPI_WRITE_HZ      40000000  // Panel write clock
 
 // ADC Pins
 #define ADC_PIN_TANK1         PIN_TANK1_ADC
@@ -250,8 +377,29 @@
 #define LCD_WIDTH             SCREEN_WIDTH
 #define LCD_HEIGHT            SCREEN_HEIGHT
 #define LCD_ROTATION          SCREEN_ROTATION
+
+// Board descriptors: visible panel (portrait) and its position in the
+// controller's 240x320 RAM
+#define LCD_MEMORY_WIDTH      240
+#define LCD_MEMORY_HEIGHT     320
+#if BOARD_LCD == BOARD_LCD_1_9
+#define LCD_PANEL_WIDTH       170
+#define LCD_PANEL_HEIGHT      320
 #define LCD_COL_OFFSET        35
 #define LCD_ROW_OFFSET        0
+#elif BOARD_LCD == BOARD_LCD_1_69
+#define LCD_PANEL_WIDTH       240
+#define LCD_PANEL_HEIGHT      280
+#define LCD_COL_OFFSET        0
+#define LCD_ROW_OFFSET        20
+#elif BOARD_LCD == BOARD_LCD_1_47
+#define LCD_PANEL_WIDTH       172
+#define LCD_PANEL_HEIGHT      320
+#define LCD_COL_OFFSET        34
+#define LCD_ROW_OFFSET        0
+#else
+#error "Unknown BOARD_LCD"
+#endif
 
 // Voltage divider
 #define VOLTAGE_DIVIDER_R_REF DIVIDER_R_REFERENCE
@@ -277,7 +425,7 @@
 // Gauge dimensions
 #define GAUGE_WIDTH           GAUGE_BAR_WIDTH
 #define GAUGE_SEGMENT_COUNT   GAUGE_SEGMENTS
-#define GAUGE_SEGMENT_HEIGHT  13
+#define GAUGE_SEGMENT_HEIGHT_MAX 13   // Longest segment; shorter screens get the longest that fits (layout.h)
 #define GAUGE_SEGMENT_GAP     1
 
 // Text sizes
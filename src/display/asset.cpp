@@ -0,0 +1,158 @@
+#include "asset.h"
+#include "display.h"
+
+#define RLE_RUN_MAX           128     // Repeats or literals per RLE565 token
+#define PALETTE_SHORT_MAX     15      // Repeats held in a palette token's high nibble
+#define PALETTE_RUN_MAX       271     // 16 + one extension byte
+
+// ============================================================================
+// Decoding
+// ============================================================================
+
+// Walk an asset's stream, writing it into the open window when draw is set.
+// Returns pixels decoded, or -1 if the stream is malformed.
+static int32_t decode(const Asset* asset, bool draw) {
+    const uint8_t* p = asset->data;
+    const uint8_t* end = p + asset->size;
+    uint32_t total = (uint32_t)asset->width * asset->height;
+    uint32_t done = 0;
+    uint16_t literals[RLE_RUN_MAX];
+
+    while (p < end) {
+        uint8_t t = *p++;
+        uint32_t n;
+        if (asset->format == ASSET_FORMAT_PALETTE) {
+            n = (t >> 4) + 1;
+            if ((t >> 4) == PALETTE_SHORT_MAX) {
+                if (p >= end) return -1;
+                n = 16 + *p++;
+            }
+            uint8_t index = t & 0x0F;
+            if (index >= asset->palette_count || done + n > total) return -1;
+            if (draw) {
+                display_window_write_run(asset->palette[index], n);
+            }
+        } else if (t & 0x80) {
+            n = (t & 0x7F) + 1;
+            if (end - p < 2 || done + n > total) return -1;
+            if (draw) {
+                display_window_write_run((uint16_t)(p[0] | (p[1] << 8)), n);
+            }
+            p += 2;
+        } else {
+            n = t + 1;
+            if (end - p < (int32_t)(2 * n) || done + n > total) return -1;
+            if (draw) {
+                for (uint32_t i = 0; i < n; i++) {
+                    literals[i] = (uint16_t)(p[2 * i] | (p[2 * i + 1] << 8));
+                }
+                display_window_write_pixels(literals, n);
+            }
+            p += 2 * n;
+        }
+        done += n;
+    }
+    return (int32_t)done;
+}
+
+static bool known_format(const Asset* asset) {
+    return asset->format == ASSET_FORMAT_RLE565 ||
+           (asset->format == ASSET_FORMAT_PALETTE && asset->palette &&
+            asset->palette_count <= ASSET_PALETTE_MAX);
+}
+
+bool asset_valid(const Asset* asset) {
+    return known_format(asset) &&
+           decode(asset, false) == (int32_t)((uint32_t)asset->width * asset->height);
+}
+
+bool asset_draw(const Asset* asset, int16_t x, int16_t y) {
+    if (!known_format(asset)) {
+        return false;
+    }
+    display_window_begin(x, y, asset->width, asset->height);
+    int32_t done = decode(asset, true);
+    display_window_end();
+    return done == (int32_t)((uint32_t)asset->width * asset->height);
+}
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+static uint32_t encode_rle565(const uint16_t* px, uint32_t n, uint8_t* out, uint32_t out_size) {
+    uint32_t len = 0;
+    uint32_t i = 0;
+    while (i < n) {
+        uint32_t run = 1;
+        while (i + run < n && run < RLE_RUN_MAX && px[i + run] == px[i]) {
+            run++;
+        }
+        if (run >= 2) {
+            if (len + 3 > out_size) return 0;
+            out[len++] = (uint8_t)(0x80 | (run - 1));
+            out[len++] = (uint8_t)(px[i] & 0xFF);
+            out[len++] = (uint8_t)(px[i] >> 8);
+            i += run;
+            continue;
+        }
+
+        // Literals up to the start of the next repeat
+        uint32_t j = i + 1;
+        while (j < n && j - i < RLE_RUN_MAX && !(j + 1 < n && px[j + 1] == px[j])) {
+            j++;
+        }
+        if (len + 1 + 2 * (j - i) > out_size) return 0;
+        out[len++] = (uint8_t)(j - i - 1);
+        for (; i < j; i++) {
+            out[len++] = (uint8_t)(px[i] & 0xFF);
+            out[len++] = (uint8_t)(px[i] >> 8);
+        }
+    }
+    return len;
+}
+
+static uint32_t encode_palette(const uint16_t* px, uint32_t n, uint16_t* palette,
+                               uint8_t* palette_count, uint8_t* out, uint32_t out_size) {
+    // Palette in order of first use
+    uint8_t count = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        uint8_t k = 0;
+        while (k < count && palette[k] != px[i]) k++;
+        if (k == count) {
+            if (count == ASSET_PALETTE_MAX) return 0;
+            palette[count++] = px[i];
+        }
+    }
+    *palette_count = count;
+
+    uint32_t len = 0;
+    uint32_t i = 0;
+    while (i < n) {
+        uint32_t run = 1;
+        while (i + run < n && run < PALETTE_RUN_MAX && px[i + run] == px[i]) {
+            run++;
+        }
+        uint8_t index = 0;
+        while (palette[index] != px[i]) index++;
+        if (run <= PALETTE_SHORT_MAX) {
+            if (len + 1 > out_size) return 0;
+            out[len++] = (uint8_t)(((run - 1) << 4) | index);
+        } else {
+            if (len + 2 > out_size) return 0;
+            out[len++] = (uint8_t)((PALETTE_SHORT_MAX << 4) | index);
+            out[len++] = (uint8_t)(run - 16);
+        }
+        i += run;
+    }
+    return len;
+}
+
+uint32_t asset_encode(const uint16_t* pixels, uint16_t width, uint16_t height, uint8_t format,
+                      uint16_t* palette, uint8_t* palette_count, uint8_t* out, uint32_t out_size) {
+    uint32_t n = (uint32_t)width * height;
+    if (format == ASSET_FORMAT_PALETTE) {
+        return encode_palette(pixels, n, palette, palette_count, out, out_size);
+    }
+    return encode_rle565(pixels, n, out, out_size);
+}
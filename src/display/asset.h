@@ -0,0 +1,70 @@
+#ifndef ASSET_H
+#define ASSET_H
+
+/*******************************************************************************
+ * Compressed RGB565 images in flash
+ *
+ * Icons, outlines and the boot splash are converted from PNGs in assets/ at
+ * build time (tools/asset_pack.py) into byte streams in asset_data.cpp. Both
+ * formats decode front to back into one address window, with runs written
+ * straight into the SPI stream, so drawing an asset needs no frame or row
+ * buffer.
+ *
+ * ASSET_FORMAT_RLE565, one token byte t then:
+ *   t & 0x80: one color (2 bytes, little-endian) repeated (t & 0x7F) + 1 times
+ *   else:     (t + 1) literal colors (2 bytes each)
+ *
+ * ASSET_FORMAT_PALETTE (up to 16 colors), one token byte t:
+ *   index t & 0x0F repeated (t >> 4) + 1 times, except (t >> 4) == 15,
+ *   where the next byte n gives 16 + n repeats (16-271)
+ ******************************************************************************/
+
+#include <stdint.h>
+
+#define ASSET_FORMAT_RLE565   0       // Runs and literals of RGB565 colors
+#define ASSET_FORMAT_PALETTE  1       // Runs of 4-bit palette indexes
+#define ASSET_PALETTE_MAX     16      // Colors in a palette asset
+
+/**
+ * @brief One compressed image (all pointers into flash)
+ */
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint8_t format;                     // ASSET_FORMAT_*
+    uint8_t palette_count;              // Palette format only
+    const uint16_t* palette;            // Palette format only, else nullptr
+    const uint8_t* data;                // Token stream
+    uint32_t size;                      // Bytes in data
+} Asset;
+
+/**
+ * @brief Draw an asset with its top-left corner at (x, y)
+ * The whole image is one address window; excluded regions are honoured.
+ * @return false if the stream is malformed (drawing stops where it breaks)
+ */
+bool asset_draw(const Asset* asset, int16_t x, int16_t y);
+
+/**
+ * @brief Check that an asset's stream decodes to exactly width x height pixels
+ */
+bool asset_valid(const Asset* asset);
+
+/**
+ * @brief Compress an RGB565 image (same encoder as tools/asset_pack.py)
+ * Lets images generated at runtime or in tests use the same decoder.
+ * @param pixels width x height colors in raster order
+ * @param width Image width
+ * @param height Image height
+ * @param format ASSET_FORMAT_*
+ * @param palette Output: up to ASSET_PALETTE_MAX colors (palette format only)
+ * @param palette_count Output: colors used (palette format only)
+ * @param out Output stream
+ * @param out_size Capacity of out in bytes
+ * @return Bytes written, 0 if the stream does not fit or the image has too
+ *         many colors for a palette
+ */
+uint32_t asset_encode(const uint16_t* pixels, uint16_t width, uint16_t height, uint8_t format,
+                      uint16_t* palette, uint8_t* palette_count, uint8_t* out, uint32_t out_size);
+
+#endif // ASSET_H
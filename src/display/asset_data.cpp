@@ -0,0 +1,80 @@
+// Generated by tools/asset_pack.py from assets/*.png - do not edit
+
+#include "asset_data.h"
+
+static const uint16_t asset_fuel_pump_palette[] = {
+    0x0000, 0x07FF,
+};
+
+static const uint8_t asset_fuel_pump_data[] = {
+    0xF0, 0x01, 0x71, 0x70, 0x01, 0x50, 0x01, 0x00, 0x11, 0x40, 0x01, 0x50,
+    0x01, 0x10, 0x11, 0x30, 0x01, 0x50, 0x01, 0x20, 0x01, 0x30, 0x71, 0x20,
+    0x01, 0x30, 0x71, 0x20, 0x01, 0x30, 0x71, 0x00, 0x01, 0x00, 0x01, 0x30,
+    0x81, 0x10, 0x01, 0x30, 0x71, 0x20, 0x01, 0x30, 0x71, 0x20, 0x01, 0x30,
+    0x71, 0x10, 0x11, 0x30, 0x71, 0x00, 0x11, 0x40, 0x71, 0x60, 0x91, 0x50,
+    0x91, 0x50,
+};
+
+const Asset asset_fuel_pump = {
+    16, 16, ASSET_FORMAT_PALETTE, 2, asset_fuel_pump_palette,
+    asset_fuel_pump_data, sizeof(asset_fuel_pump_data)
+};
+
+static const uint16_t asset_splash_palette[] = {
+    0x0000, 0x07FF, 0xFFFF, 0x39E7, 0x07E0, 0xFFE0, 0xF800,
+};
+
+static const uint8_t asset_splash_data[] = {
+    0xF0, 0xFF, 0xE0, 0xF1, 0x00, 0xF0, 0x58, 0xF1, 0x00, 0xF0, 0x58, 0x11,
+    0xB0, 0x11, 0x10, 0x31, 0xF0, 0x52, 0x11, 0xB0, 0x11, 0x10, 0x31, 0xF0,
+    0x52, 0x11, 0xB0, 0x11, 0x30, 0x31, 0xF0, 0x50, 0x11, 0xB0, 0x11, 0x30,
+    0x31, 0xF0, 0x50, 0x11, 0xB0, 0x11, 0x50, 0x11, 0xF0, 0x50, 0x11, 0xB0,
+    0x11, 0x50, 0x11, 0xF0, 0x50, 0xF1, 0x00, 0x50, 0x11, 0xF0, 0x50, 0xF1,
+    0x00, 0x50, 0x11, 0xF0, 0x50, 0xF1, 0x00, 0x50, 0x11, 0xF0, 0x50, 0xF1,
+    0x00, 0x50, 0x11, 0xF0, 0x50, 0xF1, 0x00, 0x10, 0x11, 0x10, 0x11, 0xF0,
+    0x50, 0xF1, 0x00, 0x10, 0x11, 0x10, 0x11, 0xF0, 0x50, 0xF1, 0x02, 0x30,
+    0x11, 0xF0, 0x50, 0xF1, 0x02, 0x30, 0x11, 0xF0, 0x50, 0xF1, 0x00, 0x50,
+    0x11, 0xF0, 0x50, 0xF1, 0x00, 0x50, 0x11, 0xF0, 0x50, 0xF1, 0x00, 0x50,
+    0x11, 0xF0, 0x50, 0xF1, 0x00, 0x50, 0x11, 0xF0, 0x50, 0xF1, 0x00, 0x30,
+    0x31, 0xF0, 0x50, 0xF1, 0x00, 0x30, 0x31, 0xF0, 0x50, 0xF1, 0x00, 0x10,
+    0x31, 0xF0, 0x52, 0xF1, 0x00, 0x10, 0x31, 0xF0, 0x52, 0xF1, 0x00, 0xF0,
+    0x58, 0xF1, 0x00, 0xF0, 0x56, 0xF1, 0x04, 0xF0, 0x54, 0xF1, 0x04, 0xF0,
+    0x54, 0xF1, 0x04, 0xF0, 0x54, 0xF1, 0x04, 0xF0, 0xFF, 0xF0, 0x65, 0xB2,
+    0xF0, 0x5C, 0xB2, 0xF0, 0x5C, 0xB2, 0xF0, 0x5C, 0xB2, 0xF0, 0x5C, 0xB2,
+    0xF0, 0x5C, 0xB2, 0xF0, 0x0C, 0xF2, 0x50, 0xF0, 0x06, 0xF2, 0x54, 0xF0,
+    0x02, 0x32, 0xF0, 0x50, 0x32, 0xF0, 0x00, 0x12, 0xF0, 0x54, 0x12, 0xE0,
+    0x12, 0xF0, 0x56, 0x12, 0xD0, 0x12, 0xF0, 0x56, 0x12, 0xC0, 0x12, 0xF0,
+    0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58, 0x12,
+    0xB0, 0x12, 0xF3, 0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58, 0x12, 0xB0, 0x12,
+    0xF0, 0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58,
+    0x12, 0xB0, 0x12, 0xF0, 0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58, 0x12, 0xB0,
+    0x12, 0xF3, 0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58, 0x12, 0xB0, 0x12, 0xF0,
+    0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58, 0x12,
+    0xB0, 0x12, 0xF0, 0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58, 0x12, 0xB0, 0x12,
+    0xF0, 0x58, 0x12, 0xB0, 0x12, 0xF4, 0x58, 0x12, 0xB0, 0x12, 0xF4, 0x58,
+    0x12, 0xB0, 0x12, 0xF4, 0x58, 0x12, 0xB0, 0x12, 0xF4, 0x58, 0x12, 0xB0,
+    0x12, 0xF4, 0x58, 0x12, 0xB0, 0x12, 0xF4, 0x58, 0x12, 0xB0, 0x12, 0xF0,
+    0x58, 0x12, 0xB0, 0x12, 0xF4, 0x58, 0x12, 0xB0, 0x12, 0xF4, 0x58, 0x12,
+    0xB0, 0x12, 0xF4, 0x58, 0x12, 0xB0, 0x12, 0xF4, 0x58, 0x12, 0xB0, 0x12,
+    0xF4, 0x58, 0x12, 0xB0, 0x12, 0xF4, 0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58,
+    0x12, 0xB0, 0x12, 0xF4, 0x58, 0x12, 0xB0, 0x12, 0xF4, 0x58, 0x12, 0xB0,
+    0x12, 0xF4, 0x58, 0x12, 0xB0, 0x12, 0xF4, 0x58, 0x12, 0xB0, 0x12, 0xF4,
+    0x58, 0x12, 0xB0, 0x12, 0xF5, 0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58, 0x12,
+    0xB0, 0x12, 0xF5, 0x58, 0x12, 0xB0, 0x12, 0xF5, 0x58, 0x12, 0xB0, 0x12,
+    0xF5, 0x58, 0x12, 0xB0, 0x12, 0xF5, 0x58, 0x12, 0xB0, 0x12, 0xF5, 0x58,
+    0x12, 0xB0, 0x12, 0xF5, 0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58, 0x12, 0xB0,
+    0x12, 0xF5, 0x58, 0x12, 0xB0, 0x12, 0xF5, 0x58, 0x12, 0xB0, 0x12, 0xF5,
+    0x58, 0x12, 0xB0, 0x12, 0xF5, 0x58, 0x12, 0xB0, 0x12, 0xF6, 0x58, 0x12,
+    0xB0, 0x12, 0xF6, 0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58, 0x12, 0xB0, 0x12,
+    0xF6, 0x58, 0x12, 0xB0, 0x12, 0xF6, 0x58, 0x12, 0xB0, 0x12, 0xF6, 0x58,
+    0x12, 0xB0, 0x12, 0xF6, 0x58, 0x12, 0xB0, 0x12, 0xF6, 0x58, 0x12, 0xB0,
+    0x12, 0xF6, 0x58, 0x12, 0xB0, 0x12, 0xF0, 0x58, 0x12, 0xC0, 0x12, 0xF6,
+    0x56, 0x12, 0xD0, 0x12, 0xF6, 0x56, 0x12, 0xE0, 0x12, 0xF6, 0x54, 0x12,
+    0xF0, 0x00, 0x32, 0xF6, 0x50, 0x32, 0xF0, 0x02, 0xF2, 0x54, 0xF0, 0x06,
+    0xF2, 0x50, 0xB0,
+};
+
+const Asset asset_splash = {
+    120, 112, ASSET_FORMAT_PALETTE, 7, asset_splash_palette,
+    asset_splash_data, sizeof(asset_splash_data)
+};
@@ -0,0 +1,11 @@
+#ifndef ASSET_DATA_H
+#define ASSET_DATA_H
+
+// Generated by tools/asset_pack.py from assets/*.png - do not edit
+
+#include "asset.h"
+
+extern const Asset asset_fuel_pump;         // 16x16
+extern const Asset asset_splash;            // 120x112
+
+#endif // ASSET_DATA_H
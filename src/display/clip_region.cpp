@@ -0,0 +1,74 @@
+#include "clip_region.h"
+
+bool clip_push(ClipStack* stack, int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (stack->count >= DISPLAY_CLIP_MAX) {
+        return false;
+    }
+    ClipRect* r = &stack->rects[stack->count++];
+    r->x = x;
+    r->y = y;
+    r->w = w;
+    r->h = h;
+    return true;
+}
+
+void clip_pop(ClipStack* stack) {
+    if (stack->count > 0) {
+        stack->count--;
+    }
+}
+
+static bool overlaps(const ClipRect* a, int16_t x, int16_t y, int16_t w, int16_t h) {
+    return a->x < x + w && x < a->x + a->w && a->y < y + h && y < a->y + a->h;
+}
+
+bool clip_intersects(const ClipStack* stack, int16_t x, int16_t y, int16_t w, int16_t h) {
+    for (int i = 0; i < stack->count; i++) {
+        if (overlaps(&stack->rects[i], x, y, w, h)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Append r to out if non-empty and there is room
+static void add_piece(ClipRect* out, int* n, int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (w > 0 && h > 0 && *n < CLIP_MAX_PIECES) {
+        ClipRect* r = &out[(*n)++];
+        r->x = x;
+        r->y = y;
+        r->w = w;
+        r->h = h;
+    }
+}
+
+int clip_visible(const ClipStack* stack, int16_t x, int16_t y, int16_t w, int16_t h,
+                 ClipRect* out) {
+    int n = 0;
+    add_piece(out, &n, x, y, w, h);
+
+    for (int i = 0; i < stack->count; i++) {
+        const ClipRect* e = &stack->rects[i];
+        ClipRect pieces[CLIP_MAX_PIECES];
+        int count = 0;
+        for (int p = 0; p < n; p++) {
+            const ClipRect* r = &out[p];
+            if (!overlaps(e, r->x, r->y, r->w, r->h)) {
+                add_piece(pieces, &count, r->x, r->y, r->w, r->h);
+                continue;
+            }
+            // Band above, left and right of the exclusion, band below
+            int16_t top = e->y > r->y ? e->y : r->y;
+            int16_t bottom = (e->y + e->h) < (r->y + r->h) ? (e->y + e->h) : (r->y + r->h);
+            add_piece(pieces, &count, r->x, r->y, r->w, top - r->y);
+            add_piece(pieces, &count, r->x, top, e->x - r->x, bottom - top);
+            add_piece(pieces, &count, e->x + e->w, top, (r->x + r->w) - (e->x + e->w), bottom - top);
+            add_piece(pieces, &count, r->x, bottom, r->w, (r->y + r->h) - bottom);
+        }
+        for (int p = 0; p < count; p++) {
+            out[p] = pieces[p];
+        }
+        n = count;
+    }
+    return n;
+}
@@ -0,0 +1,57 @@
+#ifndef CLIP_REGION_H
+#define CLIP_REGION_H
+
+#include "config.h"
+#include <stdint.h>
+
+/**
+ * @brief Screen rectangle
+ */
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+} ClipRect;
+
+/**
+ * @brief Stack of excluded screen regions
+ *
+ * Everything sent to the panel is clipped against every rect on the stack.
+ * LovyanGFX's setClipRect() only keeps drawing inside one rect, so the
+ * display layer subtracts exclusions itself and sends the visible pieces.
+ */
+typedef struct {
+    ClipRect rects[DISPLAY_CLIP_MAX];
+    int count;
+} ClipStack;
+
+// Most pieces a rect can be split into (4 per exclusion, bounded)
+#define CLIP_MAX_PIECES       (4 * DISPLAY_CLIP_MAX + 1)
+
+/**
+ * @brief Push an excluded region
+ * @return false if the stack is full
+ */
+bool clip_push(ClipStack* stack, int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * @brief Pop the most recently pushed region
+ */
+void clip_pop(ClipStack* stack);
+
+/**
+ * @brief Check whether a rect touches any excluded region
+ */
+bool clip_intersects(const ClipStack* stack, int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * @brief Split a rect into the pieces outside every excluded region
+ * Pieces are disjoint and cover exactly the visible area. A rect clear of all exclusions comes back as a single piece.
+ * @param out Output pieces (CLIP_MAX_PIECES entries)
+ * @return Number of pieces (0 if fully hidden)
+ */
+int clip_visible(const ClipStack* stack, int16_t x, int16_t y, int16_t w, int16_t h,
+                 ClipRect* out);
+
+#endif // CLIP_REGION_H
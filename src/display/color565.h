@@ -0,0 +1,17 @@
+#ifndef COLOR565_H
+#define COLOR565_H
+
+#include <stdint.h>
+
+/**
+ * @brief Blend two RGB565 colors per channel
+ * @param t Weight of b, 0 (all a) to 256 (all b)
+ */
+static inline uint16_t color_blend_565(uint16_t a, uint16_t b, int t) {
+    int r = ((a >> 11) * (256 - t) + (b >> 11) * t) >> 8;
+    int g = (((a >> 5) & 0x3F) * (256 - t) + ((b >> 5) & 0x3F) * t) >> 8;
+    int bl = ((a & 0x1F) * (256 - t) + (b & 0x1F) * t) >> 8;
+    return (uint16_t)((r << 11) | (g << 5) | bl);
+}
+
+#endif // COLOR565_H
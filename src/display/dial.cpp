@@ -0,0 +1,267 @@
+#include "dial.h"
+#include "display.h"
+#include "gauge.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if DIAL_STEPS > 254
+#error "DIAL_STEPS must fit a step tag (max 254)"
+#endif
+
+// Dial bounding box and band radii
+#define DIAL_SIZE             (2 * DIAL_RADIUS + 1)
+#define DIAL_INNER_RADIUS     (DIAL_RADIUS - DIAL_THICKNESS)
+
+// Step tag of band pixels in the bottom gap (never lit)
+#define DIAL_STEP_NONE        255
+
+// Readouts inside the band: percentage above the centre, gallons below
+#define DIAL_PCT_DY           (-18)
+#define DIAL_GAL_DY           4
+#define DIAL_LABEL_DY         (DIAL_RADIUS - 14)
+
+/**
+ * Band pixels of one half row (left or right of the centre column)
+ */
+typedef struct {
+    int16_t dx;                         // First pixel, relative to the centre
+    uint8_t len;                        // Pixels in the span (0 = none)
+    uint16_t first;                     // Index of the first step tag
+} DialSpan;
+
+// [row][0] = left of centre, [row][1] = centre column and right
+static DialSpan spans[DIAL_SIZE][2];
+static uint8_t* steps = nullptr;        // Step tag per band pixel
+static bool dial_ready = false;
+
+// Levels on screen per dial, with hysteresis (fill invalid = unknown, full redraw)
+static GaugeShown shown[2];
+static bool shown_ready = false;
+
+static int dial_index(int tank_number) {
+    return (tank_number == 2) ? 1 : 0;
+}
+
+static GaugeShown* dial_shown(int idx) {
+    if (!shown_ready) {
+        gauge_shown_init(&shown[0], DIAL_STEPS);
+        gauge_shown_init(&shown[1], DIAL_STEPS);
+        shown_ready = true;
+    }
+    return &shown[idx];
+}
+
+// ============================================================================
+// Span table
+// ============================================================================
+
+static bool in_band(int dx, int dy) {
+    int d2 = dx * dx + dy * dy;
+    return d2 >= DIAL_INNER_RADIUS * DIAL_INNER_RADIUS && d2 < DIAL_RADIUS * DIAL_RADIUS;
+}
+
+// Fill step at which a band pixel lights (clockwise from the bottom left)
+static uint8_t pixel_step(int dx, int dy) {
+    // Angle clockwise from straight down, 0-360
+    float deg = atan2f((float)-dx, (float)dy) * (180.0f / 3.14159265f);
+    if (deg < 0.0f) deg += 360.0f;
+    const float gap = (360.0f - DIAL_SWEEP_DEG) / 2.0f;
+    if (deg < gap || deg > 360.0f - gap) {
+        return DIAL_STEP_NONE;
+    }
+    int step = (int)((deg - gap) / DIAL_SWEEP_DEG * DIAL_STEPS);
+    return (uint8_t)(step < DIAL_STEPS ? step : DIAL_STEPS - 1);
+}
+
+bool dial_init() {
+    if (dial_ready) {
+        return true;
+    }
+
+    // First pass: span extents and the number of band pixels
+    int total = 0;
+    for (int row = 0; row < DIAL_SIZE; row++) {
+        int dy = row - DIAL_RADIUS;
+        for (int side = 0; side < 2; side++) {
+            int from = side ? 0 : -DIAL_RADIUS;
+            int to = side ? DIAL_RADIUS : -1;
+            DialSpan* s = &spans[row][side];
+            s->len = 0;
+            s->first = (uint16_t)total;
+            for (int dx = from; dx <= to; dx++) {
+                if (!in_band(dx, dy)) {
+                    continue;
+                }
+                if (s->len == 0) {
+                    s->dx = (int16_t)dx;
+                }
+                s->len = (uint8_t)(dx - s->dx + 1);
+            }
+            total += s->len;
+        }
+    }
+
+    steps = (uint8_t*)malloc(total);
+    if (!steps) {
+        return false;
+    }
+
+    // Second pass: tag every pixel (in_band spans are contiguous per side)
+    for (int row = 0; row < DIAL_SIZE; row++) {
+        int dy = row - DIAL_RADIUS;
+        for (int side = 0; side < 2; side++) {
+            const DialSpan* s = &spans[row][side];
+            for (int i = 0; i < s->len; i++) {
+                steps[s->first + i] = pixel_step(s->dx + i, dy);
+            }
+        }
+    }
+    dial_ready = true;
+    return true;
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+int dial_get_fill_steps(float percent) {
+    if (percent < 0.0f) percent = 0.0f;
+    if (percent > 100.0f) percent = 100.0f;
+    return (int)(percent / 100.0f * DIAL_STEPS + 0.5f);
+}
+
+int16_t dial_center_x(int tank_number) {
+    return ScreenLayout::dial_x(dial_index(tank_number));
+}
+
+int16_t dial_center_y(int tank_number) {
+    return ScreenLayout::dial_y(dial_index(tank_number));
+}
+
+// Lit color of a step, from the bar's zone table (same zones and gradient)
+static uint16_t step_color(int step) {
+    return gauge_get_row_color(step * (GAUGE_SEGMENT_COUNT * GAUGE_SEGMENT_HEIGHT) / DIAL_STEPS);
+}
+
+static uint16_t pixel_color(uint8_t step, int fill_steps) {
+    if (step == DIAL_STEP_NONE) {
+        return UI_COLOR_BACKGROUND;
+    }
+    return (step < fill_steps) ? step_color(step) : UI_COLOR_EMPTY;
+}
+
+// One row of the bounding box
+static uint16_t row_buf[DIAL_SIZE];
+
+static void draw_band(int16_t cx, int16_t cy, int fill_steps) {
+    display_window_begin(cx - DIAL_RADIUS, cy - DIAL_RADIUS, DIAL_SIZE, DIAL_SIZE);
+    for (int row = 0; row < DIAL_SIZE; row++) {
+        for (int i = 0; i < DIAL_SIZE; i++) {
+            row_buf[i] = UI_COLOR_BACKGROUND;
+        }
+        for (int side = 0; side < 2; side++) {
+            const DialSpan* s = &spans[row][side];
+            for (int i = 0; i < s->len; i++) {
+                row_buf[DIAL_RADIUS + s->dx + i] = pixel_color(steps[s->first + i], fill_steps);
+            }
+        }
+        display_window_write_row(row_buf);
+    }
+    display_window_end();
+}
+
+void dial_update_spans(int16_t cx, int16_t cy, int old_steps, int new_steps) {
+    if (old_steps == new_steps || !dial_init()) {
+        return;
+    }
+    int lo = (old_steps < new_steps) ? old_steps : new_steps;
+    int hi = (old_steps < new_steps) ? new_steps : old_steps;
+
+    for (int row = 0; row < DIAL_SIZE; row++) {
+        int16_t y = cy - DIAL_RADIUS + row;
+        for (int side = 0; side < 2; side++) {
+            const DialSpan* s = &spans[row][side];
+            const uint8_t* tag = steps + s->first;
+            // Runs of changed pixels with the same new color, one fill each
+            int i = 0;
+            while (i < s->len) {
+                if (tag[i] < lo || tag[i] >= hi) {
+                    i++;
+                    continue;
+                }
+                uint16_t color = pixel_color(tag[i], new_steps);
+                int start = i;
+                while (i < s->len && tag[i] >= lo && tag[i] < hi &&
+                       pixel_color(tag[i], new_steps) == color) {
+                    i++;
+                }
+                display_fill_rect(cx + s->dx + start, y, i - start, 1, color);
+            }
+        }
+    }
+}
+
+static void dial_draw_label(int16_t cx, int16_t cy, int tank_number) {
+    const char* label = (tank_number == 2) ? TANK2_LABEL : TANK1_LABEL;
+    int16_t w = (int16_t)(strlen(label) * 6);
+    display_set_text_size(1);
+    display_set_text_color(COLOR_SEGMENT_LINE);
+    display_set_cursor(cx - w / 2, cy + DIAL_LABEL_DY);
+    display_print(label);
+}
+
+ClipRect dial_bounds(int16_t cx, int16_t cy) {
+    ClipRect r = {(int16_t)(cx - DIAL_RADIUS), (int16_t)(cy - DIAL_RADIUS), DIAL_SIZE, DIAL_SIZE};
+    return r;
+}
+
+void dial_draw(int16_t cx, int16_t cy, float percent, int tank_number) {
+    if (!dial_init()) {
+        return;
+    }
+    int fill = dial_get_fill_steps(percent);
+    draw_band(cx, cy, fill);
+    gauge_shown_set(dial_shown(dial_index(tank_number)), fill, percent);
+
+    // The window cleared the readout fields
+    int16_t field_x = cx - GAUGE_WIDTH / 2;
+    gauge_readout_invalidate(field_x, cy + DIAL_PCT_DY);
+    gauge_readout_invalidate(field_x, cy + DIAL_GAL_DY);
+    gauge_draw_percentage(field_x, cy + DIAL_PCT_DY, percent);
+    gauge_draw_gallons(field_x, cy + DIAL_GAL_DY, percent);
+    dial_draw_label(cx, cy, tank_number);
+}
+
+bool dial_update_if_changed(int16_t cx, int16_t cy, float old_percent,
+                            float new_percent, int tank_number) {
+    (void)old_percent;
+    GaugeShown* shown_levels = dial_shown(dial_index(tank_number));
+    if (!shown_levels->fill.valid) {
+        // Dial state unknown - redraw the whole dial
+        dial_draw(cx, cy, new_percent, tank_number);
+        return true;
+    }
+
+    int old_steps = shown_levels->fill.level;
+    uint8_t changed = gauge_shown_update(shown_levels, new_percent);
+    if (changed == 0) {
+        return false;
+    }
+
+    if (changed & GAUGE_SHOWN_FILL) {
+        dial_update_spans(cx, cy, old_steps, shown_levels->fill.level);
+    }
+    int16_t field_x = cx - GAUGE_WIDTH / 2;
+    if (changed & GAUGE_SHOWN_PERCENT) {
+        gauge_draw_percentage(field_x, cy + DIAL_PCT_DY, new_percent);
+    }
+    if (changed & GAUGE_SHOWN_GALLONS) {
+        gauge_draw_gallons(field_x, cy + DIAL_GAL_DY, new_percent);
+    }
+    return true;
+}
+
+void dial_invalidate(int tank_number) {
+    shown_value_invalidate(&dial_shown(dial_index(tank_number))->fill);
+}
@@ -0,0 +1,84 @@
+#ifndef DIAL_H
+#define DIAL_H
+
+/*******************************************************************************
+ * Round dial gauge (GAUGE_STYLE_DIAL)
+ *
+ * A DIAL_SWEEP_DEG arc band that fills clockwise from the bottom left. The
+ * band is described once at boot as a span table: for each row of the dial,
+ * a left and a right span of band pixels, each pixel tagged with the fill
+ * step at which it turns on. Drawing never uses trig. A level change
+ * repaints only the pixels whose step lies between the old and new fill.
+ ******************************************************************************/
+
+#include "config.h"
+#include "clip_region.h"
+#include <stdint.h>
+
+/**
+ * @brief Build the span table (trig runs here, once)
+ * Called on first use by the draw functions.
+ * @return false if the table could not be allocated
+ */
+bool dial_init();
+
+/**
+ * @brief Number of fill steps lit for a given percentage
+ * @param percent Fuel percentage (0-100)
+ * @return 0 to DIAL_STEPS
+ */
+int dial_get_fill_steps(float percent);
+
+/**
+ * @brief Centre column of a tank's dial (from the screen layout)
+ * @param tank_number Tank identifier (1 or 2)
+ */
+int16_t dial_center_x(int tank_number);
+
+/**
+ * @brief Centre row of a tank's dial (stacked in portrait, side by side in landscape)
+ * @param tank_number Tank identifier (1 or 2)
+ */
+int16_t dial_center_y(int tank_number);
+
+/**
+ * @brief Screen area a dial paints (its bounding box, readouts included)
+ * @param cx Centre X
+ * @param cy Centre Y
+ */
+ClipRect dial_bounds(int16_t cx, int16_t cy);
+
+/**
+ * @brief Draw a complete dial with its readouts and label
+ * The band and its bounding box go out as one pixel window.
+ * @param cx Centre X
+ * @param cy Centre Y
+ * @param percent Current fuel percentage (0-100)
+ * @param tank_number Tank identifier (1 or 2)
+ */
+void dial_draw(int16_t cx, int16_t cy, float percent, int tank_number);
+
+/**
+ * @brief Repaint only the band pixels between two fill levels
+ * @param cx Centre X
+ * @param cy Centre Y
+ * @param old_steps Fill currently on screen (dial_get_fill_steps)
+ * @param new_steps Fill to show
+ */
+void dial_update_spans(int16_t cx, int16_t cy, int old_steps, int new_steps);
+
+/**
+ * @brief Update a dial only where its displayed value changed
+ * Mirrors gauge_update_if_changed(): band spans between the last drawn and
+ * the new fill, readouts only when their digits change.
+ * @return true if anything was redrawn
+ */
+bool dial_update_if_changed(int16_t cx, int16_t cy, float old_percent,
+                            float new_percent, int tank_number);
+
+/**
+ * @brief Forget the drawn state of a dial so the next update redraws fully
+ */
+void dial_invalidate(int tank_number);
+
+#endif // DIAL_H
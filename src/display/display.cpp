@@ -1,12 +1,335 @@
 #include "display.h"
+#include "clip_region.h"
+#include "draw_batch.h"
+#include "font_glcd.h"
+#include "indexed_frame.h"
+#include "push_pipeline.h"
+#include "text_format.h"
 #include <stdint.h>
 #include <string.h>
-#include <Arduino.h>
 
 #ifndef NATIVE_BUILD
+#include <Arduino.h>
+#if DISPLAY_ASYNC_ENABLE
+#include "esp_timer.h"
+#include "freertos/event_groups.h"
+#endif
+
 // LovyanGFX display instance
 static LGFX *gfx = nullptr;
 
+// Current draw target: the panel, or the off-screen canvas while composing
+static lgfx::LovyanGFX* target = nullptr;
+static int16_t target_x = 0;        // Target origin in screen coordinates
+static int16_t target_y = 0;
+
+// Canvases are used in turn: one is composed while the last one pushed is
+// still on the bus
+static LGFX_Sprite* canvases[DISPLAY_CANVAS_BUFFERS] = {};
+static int canvas_slot = 0;
+static LGFX_Sprite* canvas = nullptr;       // Open, or last opened
+static LGFX_Sprite* canvas_on_bus = nullptr;
+static bool canvas_dma_open = false;        // startWrite() held for its DMA
+static uint32_t dma_pixels = 0;             // Canvas pixels handed to DMA
+static uint32_t frame_dma_start = 0;
+static int16_t canvas_x = 0;
+static int16_t canvas_y = 0;
+
+// Text state (applied to whichever target is printed to)
+static int16_t cursor_x = 0;
+static int16_t cursor_y = 0;
+static uint16_t text_color = UI_COLOR_TEXT;
+static uint8_t text_size = 1;
+
+static DisplayStats stats = {0, 0, 0};
+static uint32_t clear_count = 0;
+
+// Excluded regions
+static ClipStack clip = {};
+
+// Open pixel window
+static int16_t window_x = 0;
+static int16_t window_y = 0;
+static int16_t window_w = 0;
+static int16_t window_h = 0;
+static int16_t window_row = 0;
+static uint32_t window_pos = 0;     // Pixels written by runs so far
+static bool window_clipped = false;
+
+// Frame command queue
+static DrawBatch batch;
+static bool frame_open = false;
+static DisplayStats frame_start = {0, 0, 0};
+
+// Indexed shadow frame: while active, panel drawing lands here instead
+static IndexedFrame* frame = nullptr;
+static bool indexed = false;
+static PushPipeline pipeline;
+
+// Frame timing
+static DisplayTiming timing = {0, 0, 0, 0, 0, 0};     // Last frame on the panel
+static DisplayTiming frame_timing = {0, 0, 0, 0, 0, 0};
+static uint32_t frame_begin_us = 0;
+static bool frame_pushing = false;  // The pipeline carries that frame
+static bool push_waiting = false;
+static uint32_t wait_start_us = 0;
+static DisplayFrameDoneFn frame_done = nullptr;
+static void* frame_done_context = nullptr;
+
+#if DISPLAY_ASYNC_ENABLE
+// Push task: each chunk starts once the one before it is seen done, not
+// from loop(). Between looks at dmaBusy() it sleeps on a one-shot timer.
+#define PUSH_TASK_PRIORITY  2           // Above loopTask (1)
+#define PUSH_POLL_US        25          // Next look at a chunk still on the bus
+#define PUSH_IDLE_BIT       (1 << 0)
+static TaskHandle_t push_task = nullptr;
+static EventGroupHandle_t push_events = nullptr;
+static esp_timer_handle_t chunk_timer = nullptr;
+
+// Timing, the wait marks and the traffic counters are shared with the task
+static portMUX_TYPE push_lock = portMUX_INITIALIZER_UNLOCKED;
+#define PUSH_LOCK()         portENTER_CRITICAL(&push_lock)
+#define PUSH_UNLOCK()       portEXIT_CRITICAL(&push_lock)
+#else
+#define PUSH_LOCK()
+#define PUSH_UNLOCK()
+#endif
+
+// Count panel traffic (canvas and indexed frame drawing are RAM-only)
+static void count_transaction(uint32_t pixels) {
+    if (target == canvas || indexed) {
+        return;
+    }
+    stats.transactions++;
+    stats.pixels += pixels;
+}
+
+// Send queued fills to the panel in address order
+static void flush_batch() {
+    if (batch.count == 0) {
+        return;
+    }
+    draw_batch_sort(&batch);
+    for (int i = 0; i < batch.count; i++) {
+        const DrawCommand* c = &batch.cmds[i];
+        gfx->fillRect(c->x, c->y, c->w, c->h, c->color);
+        count_transaction((uint32_t)c->w * c->h);
+    }
+    batch.count = 0;
+}
+
+// ============================================================================
+// Indexed frame push
+// ============================================================================
+
+static bool bus_busy(void* context) {
+    (void)context;
+    return gfx->dmaBusy();
+}
+
+// One expanded chunk of the indexed frame: one full-width DMA transfer,
+// started without waiting for it
+static void bus_start(void* context, int16_t y, int16_t rows, const uint16_t* pixels) {
+    (void)context;
+    uint32_t n = (uint32_t)rows * LCD_WIDTH;
+    gfx->pushImageDMA(0, y, LCD_WIDTH, rows, (const lgfx::swap565_t*)pixels);
+    PUSH_LOCK();
+    stats.transactions++;
+    stats.pixels += n;
+    PUSH_UNLOCK();
+#if DISPLAY_ASYNC_ENABLE
+    // First look a little before the nominal end; a slower clock only
+    // costs further timed sleeps
+    esp_timer_start_once(chunk_timer, push_pipeline_bus_us(n) * 7 / 8);
+#endif
+}
+
+// Publish a frame's timing once its last pixel is out
+static void frame_finished(uint32_t push_us, uint32_t bus_us) {
+    frame_timing.push_us = push_us;
+    frame_timing.frame_us = micros() - frame_begin_us;
+    frame_timing.bus_us = bus_us;
+    frame_timing.bus_idle_us = push_us > bus_us ? push_us - bus_us : 0;
+    PUSH_LOCK();
+    timing = frame_timing;
+    PUSH_UNLOCK();
+    if (frame_done) {
+        frame_done(frame_done_context, &timing);
+    }
+}
+
+static void push_done(void* context, uint32_t push_us, uint32_t bus_us) {
+    (void)context;
+    gfx->endWrite();
+    if (!frame_pushing) {
+        return;
+    }
+    frame_pushing = false;
+    PUSH_LOCK();
+    if (push_waiting) {
+        frame_timing.wait_us += micros() - wait_start_us;
+    }
+    PUSH_UNLOCK();
+    frame_finished(push_us, bus_us);
+}
+
+#if DISPLAY_ASYNC_ENABLE
+
+// Time for another look at the bus
+static void chunk_timer_fired(void* arg) {
+    (void)arg;
+    xTaskNotifyGive(push_task);
+}
+
+// One push per notification from push_start(). The transaction stays open
+// until push_done(): the panel is the only device on this bus.
+static void push_task_main(void* arg) {
+    (void)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        gfx->startWrite();
+        push_pipeline_begin(&pipeline, true, micros());
+        while (push_pipeline_active(&pipeline)) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            if (gfx->dmaBusy()) {
+                // Still transferring: sleep again rather than spin above loop()
+                esp_timer_start_once(chunk_timer, PUSH_POLL_US);
+                continue;
+            }
+            push_pipeline_service(&pipeline, micros());
+        }
+        xEventGroupSetBits(push_events, PUSH_IDLE_BIT);
+    }
+}
+
+static bool push_task_create() {
+    if (push_task) {
+        return true;
+    }
+    push_events = xEventGroupCreate();
+    if (!push_events) {
+        return false;
+    }
+    xEventGroupSetBits(push_events, PUSH_IDLE_BIT);
+    esp_timer_create_args_t args = {};
+    args.callback = chunk_timer_fired;
+    args.name = "lcd_chunk";
+    if (esp_timer_create(&args, &chunk_timer) != ESP_OK) {
+        return false;
+    }
+    return xTaskCreate(push_task_main, "lcd_push", 4096, nullptr, PUSH_TASK_PRIORITY,
+                       &push_task) == pdPASS;
+}
+
+static bool push_idle() {
+    return !push_events || (xEventGroupGetBits(push_events) & PUSH_IDLE_BIT);
+}
+
+// Block until the push in progress is on the panel. The check and the wait
+// marks are taken together, so push_done() sees both or neither.
+static void push_finish() {
+    PUSH_LOCK();
+    bool busy = !push_idle();
+    if (busy) {
+        wait_start_us = micros();
+        push_waiting = true;
+    }
+    PUSH_UNLOCK();
+    if (!busy) {
+        return;
+    }
+    xEventGroupWaitBits(push_events, PUSH_IDLE_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+    PUSH_LOCK();
+    push_waiting = false;
+    PUSH_UNLOCK();
+}
+
+// Hand the frame's dirty rows to the push task and return
+static void push_start(bool whole_frame) {
+    push_finish();
+    frame_pushing = whole_frame;
+    xEventGroupClearBits(push_events, PUSH_IDLE_BIT);
+    xTaskNotifyGive(push_task);
+}
+
+#else
+
+static bool push_idle() {
+    return !push_pipeline_active(&pipeline);
+}
+
+// Block until the push in progress is on the panel
+static void push_finish() {
+    if (push_idle()) {
+        return;
+    }
+    wait_start_us = micros();
+    push_waiting = true;
+    while (push_pipeline_service(&pipeline, micros())) {
+        gfx->waitDMA();
+    }
+    push_waiting = false;
+}
+
+// The transaction stays open until push_done(): the panel is the only
+// device on this bus
+static void push_start(bool whole_frame) {
+    push_finish();
+    frame_pushing = whole_frame;
+    gfx->startWrite();
+    push_pipeline_begin(&pipeline, true, micros());
+}
+
+#endif
+
+// Outside a frame, an indexed drawing call is pushed as soon as it is done
+static void indexed_commit() {
+    if (indexed && !frame_open) {
+        push_start(false);
+        push_finish();
+    }
+}
+
+// Fill the visible pieces of a rect in the indexed frame
+static void frame_fill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    ClipRect pieces[CLIP_MAX_PIECES];
+    int n = clip_visible(&clip, x, y, w, h, pieces);
+    for (int i = 0; i < n; i++) {
+        indexed_frame_fill(frame, pieces[i].x, pieces[i].y, pieces[i].w, pieces[i].h, color);
+    }
+}
+
+// Route a fill to the frame queue, or straight to the current target
+static void submit_fill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (!target) {
+        return;
+    }
+    if (target == canvas) {
+        target->fillRect(x - target_x, y - target_y, w, h, color);
+        return;
+    }
+    stats.primitives++;
+    if (indexed) {
+        frame_fill(x, y, w, h, color);
+        indexed_commit();
+        return;
+    }
+    ClipRect pieces[CLIP_MAX_PIECES];
+    int n = clip_visible(&clip, x, y, w, h, pieces);
+    for (int i = 0; i < n; i++) {
+        const ClipRect* p = &pieces[i];
+        if (frame_open) {
+            if (!draw_batch_add(&batch, p->x, p->y, p->w, p->h, color)) {
+                flush_batch();
+                draw_batch_add(&batch, p->x, p->y, p->w, p->h, color);
+            }
+            continue;
+        }
+        gfx->fillRect(p->x, p->y, p->w, p->h, color);
+        count_transaction((uint32_t)p->w * p->h);
+    }
+}
+
 bool display_init() {
     Serial.println("[DISPLAY] Starting display initialization...");
     Serial.println("[DISPLAY] Pin Configuration:");
@@ -37,6 +360,10 @@ bool display_init() {
     Serial.println("[DISPLAY] Calling gfx->init()...");
     gfx->init();
     Serial.println("[DISPLAY] gfx->init() completed");
+    target = gfx;
+    if (DISPLAY_INDEXED_ENABLE && !display_indexed_enable(true)) {
+        Serial.println("[DISPLAY] WARNING: indexed frame allocation failed, drawing direct");
+    }
     
     Serial.print("[DISPLAY] Setting rotation to "); Serial.println(LCD_ROTATION);
     gfx->setRotation(LCD_ROTATION);
@@ -60,7 +387,12 @@ void display_clear(uint16_t color) {
     if (gfx) {
         Serial.print("[DISPLAY] fillScreen color: 0x");
         Serial.println(color, HEX);
-        gfx->fillScreen(color);
+        // A clear covers the whole screen, excluded regions included
+        int excluded = clip.count;
+        clip.count = 0;
+        submit_fill(0, 0, LCD_WIDTH, LCD_HEIGHT, color);
+        clip.count = excluded;
+        clear_count++;
     } else {
         Serial.println("[DISPLAY] WARNING: gfx is null in display_clear!");
     }
@@ -73,87 +405,755 @@ void display_set_brightness(uint8_t level) {
 }
 
 void display_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-    if (gfx) {
-        gfx->fillRect(x, y, w, h, color);
-    }
+    submit_fill(x, y, w, h, color);
 }
 
 void display_draw_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-    if (gfx) {
-        gfx->drawRect(x, y, w, h, color);
-    }
+    // Outline as four fills so the sides can be queued and coalesced
+    submit_fill(x, y, w, 1, color);
+    submit_fill(x, y + h - 1, w, 1, color);
+    submit_fill(x, y + 1, 1, h - 2, color);
+    submit_fill(x + w - 1, y + 1, 1, h - 2, color);
 }
 
 void display_draw_hline(int16_t x, int16_t y, int16_t w, uint16_t color) {
-    if (gfx) {
-        gfx->drawFastHLine(x, y, w, color);
-    }
+    submit_fill(x, y, w, 1, color);
 }
 
 void display_set_cursor(int16_t x, int16_t y) {
-    if (gfx) {
-        gfx->setCursor(x, y);
-    }
+    cursor_x = x;
+    cursor_y = y;
 }
 
 void display_set_text_color(uint16_t color) {
-    if (gfx) {
-        gfx->setTextColor(color);
-    }
+    text_color = color;
 }
 
 void display_set_text_size(uint8_t size) {
-    if (gfx) {
-        gfx->setTextSize(size);
+    text_size = size;
+}
+
+// Text into the indexed frame: the same GLCD glyphs with a transparent
+// background, one fill per horizontal run of set pixels
+static void print_to_frame(const char* text) {
+    for (const char* c = text; *c; c++) {
+        if (*c == '\n') {
+            cursor_x = 0;
+            cursor_y += FONT_GLCD_CELL_H * text_size;
+            continue;
+        }
+        for (int row = 0; row < FONT_GLCD_CELL_H; row++) {
+            int col = 0;
+            while (col < FONT_GLCD_COLS) {
+                if (!(font_glcd_column(*c, col) & (1 << row))) {
+                    col++;
+                    continue;
+                }
+                int run_start = col;
+                while (col < FONT_GLCD_COLS && (font_glcd_column(*c, col) & (1 << row))) {
+                    col++;
+                }
+                frame_fill(cursor_x + run_start * text_size, cursor_y + row * text_size,
+                           (col - run_start) * text_size, text_size, text_color);
+            }
+        }
+        cursor_x += FONT_GLCD_CELL_W * text_size;
     }
+    indexed_commit();
 }
 
-void display_print(const char* text) {
-    if (gfx) {
-        gfx->print(text);
+// Text state lives here so it follows drawing into and out of the canvas
+static void print_to_target(const char* text) {
+    if (!target) {
+        return;
+    }
+    if (indexed) {
+        stats.primitives++;
+        print_to_frame(text);
+        return;
+    }
+    if (target != canvas) {
+        stats.primitives++;
+        flush_batch();  // Keep queued fills underneath the text
+    }
+    target->setTextSize(text_size);
+    target->setTextColor(text_color);
+    
+    // Text crossing an excluded region is printed once per visible piece,
+    // each limited with the library's own clip rect
+    int16_t text_w = text_width(&glyph_font_glcd, text, text_size);
+    int16_t text_h = glyph_font_glcd.cell_h * text_size;
+    if (target != canvas && clip_intersects(&clip, cursor_x, cursor_y, text_w, text_h)) {
+        ClipRect pieces[CLIP_MAX_PIECES];
+        int n = clip_visible(&clip, cursor_x, cursor_y, text_w, text_h, pieces);
+        for (int i = 0; i < n; i++) {
+            gfx->setClipRect(pieces[i].x, pieces[i].y, pieces[i].w, pieces[i].h);
+            gfx->setCursor(cursor_x, cursor_y);
+            gfx->print(text);
+        }
+        gfx->clearClipRect();
+        cursor_x += text_w;
+    } else {
+        target->setCursor(cursor_x - target_x, cursor_y - target_y);
+        target->print(text);
+        cursor_x = target->getCursorX() + target_x;
+        cursor_y = target->getCursorY() + target_y;
+    }
+    
+    // Glyphs are drawn as a burst per character cell (approximate)
+    for (const char* c = text; *c; c++) {
+        count_transaction(6u * 8u * text_size * text_size);
     }
 }
 
+void display_print(const char* text) {
+    print_to_target(text);
+}
+
 void display_print_int(int value) {
-    if (gfx) {
-        gfx->print(value);
-    }
+    char buf[TEXT_NUMBER_MAX + 1];
+    text_format_int(buf, sizeof(buf), value, 0, ' ', TEXT_ALIGN_LEFT);
+    print_to_target(buf);
 }
 
 void display_print_float(float value, int decimals) {
-    if (gfx) {
-        gfx->print(value, decimals);
-    }
+    char buf[TEXT_NUMBER_MAX + 1];
+    text_format_float(buf, sizeof(buf), value, (uint8_t)decimals, 0, ' ', TEXT_ALIGN_LEFT);
+    print_to_target(buf);
 }
 
 int16_t display_get_text_width(const char* text, uint8_t size) {
-    // Base font is 6 pixels wide per character
-    return strlen(text) * 6 * size;
+    return text_width(&glyph_font_glcd, text, size);
+}
+
+// ============================================================================
+// Off-screen canvas
+// ============================================================================
+
+// Block until the canvas push on the bus is out; the CPU's share of its time
+static void canvas_dma_wait() {
+    if (!gfx->dmaBusy()) {
+        return;
+    }
+    uint32_t start = micros();
+    gfx->waitDMA();
+    frame_timing.wait_us += micros() - start;
+}
+
+// Release the transaction held for canvas DMA once nothing is left on the bus
+static void canvas_dma_close() {
+    if (canvas_dma_open && !gfx->dmaBusy()) {
+        gfx->endWrite();
+        canvas_dma_open = false;
+    }
+}
+
+bool display_canvas_begin(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (!gfx || indexed) {
+        return false;  // The indexed frame already composes off-screen
+    }
+    
+    // Clip the region to the screen
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > LCD_WIDTH) w = LCD_WIDTH - x;
+    if (y + h > LCD_HEIGHT) h = LCD_HEIGHT - y;
+    if (w <= 0 || h <= 0) {
+        return false;
+    }
+    
+    // The other buffer: the last push may still be reading this one's
+    canvas_slot = (canvas_slot + 1) % DISPLAY_CANVAS_BUFFERS;
+    if (!canvases[canvas_slot]) {
+        canvases[canvas_slot] = new LGFX_Sprite(gfx);
+        canvases[canvas_slot]->setColorDepth(16);
+    }
+    canvas = canvases[canvas_slot];
+    
+    // Queued fills must reach the panel before the canvas lands on top
+    flush_batch();
+    
+    // Only a buffer still on the bus has to wait
+    if (canvas == canvas_on_bus) {
+        canvas_dma_wait();
+    }
+    canvas_dma_close();
+    
+    if (canvas->width() != w || canvas->height() != h) {
+        canvas->deleteSprite();
+        if (!canvas->createSprite(w, h)) {
+            Serial.println("[DISPLAY] WARNING: canvas allocation failed, drawing direct");
+            return false;
+        }
+    }
+    canvas->fillScreen(UI_COLOR_BACKGROUND);
+    
+    canvas_x = x;
+    canvas_y = y;
+    target = canvas;
+    target_x = x;
+    target_y = y;
+    return true;
+}
+
+// Push one visible piece of the canvas (screen coordinates) to the panel
+static void push_canvas_piece(const ClipRect* p) {
+    int16_t w = canvas->width();
+    const lgfx::swap565_t* buf = (const lgfx::swap565_t*)canvas->getBuffer();
+    const lgfx::swap565_t* src = buf + (int32_t)(p->y - canvas_y) * w + (p->x - canvas_x);
+    if (p->w == w) {
+        // Full-width rows are contiguous: one DMA transfer, left running.
+        // The held transaction keeps pushImageDMA() from waiting for it; one
+        // transfer at a time, so a push still on the bus is waited for first.
+        canvas_dma_wait();
+        if (!canvas_dma_open) {
+            gfx->startWrite();
+            canvas_dma_open = true;
+        }
+        gfx->pushImageDMA(p->x, p->y, p->w, p->h, src);
+        canvas_on_bus = canvas;
+        dma_pixels += (uint32_t)p->w * p->h;
+    } else {
+        // Strided rows: one address window, each row's pixels written into it
+        canvas_dma_wait();
+        gfx->startWrite();
+        gfx->setAddrWindow(p->x, p->y, p->w, p->h);
+        for (int16_t r = 0; r < p->h; r++) {
+            gfx->writePixels(src + (int32_t)r * w, p->w);
+        }
+        gfx->endWrite();
+    }
+    count_transaction((uint32_t)p->w * p->h);
 }
 
+void display_canvas_end() {
+    if (target != canvas) {
+        return;
+    }
+    target = gfx;
+    target_x = 0;
+    target_y = 0;
+    
+    ClipRect pieces[CLIP_MAX_PIECES];
+    int n = clip_visible(&clip, canvas_x, canvas_y, canvas->width(), canvas->height(), pieces);
+    for (int i = 0; i < n; i++) {
+        push_canvas_piece(&pieces[i]);
+    }
+}
+
+void display_canvas_read_row(int16_t row, uint16_t* out) {
+    if (target != canvas || row < 0 || row >= canvas->height()) {
+        return;
+    }
+    // Sprite memory holds byte-swapped RGB565
+    int16_t w = canvas->width();
+    const uint16_t* src = (const uint16_t*)canvas->getBuffer() + (int32_t)row * w;
+    for (int16_t i = 0; i < w; i++) {
+        out[i] = (uint16_t)((src[i] >> 8) | (src[i] << 8));
+    }
+}
+
+void display_canvas_discard() {
+    if (target != canvas) {
+        return;
+    }
+    target = gfx;
+    target_x = 0;
+    target_y = 0;
+}
+
+// ============================================================================
+// Run-length images
+// ============================================================================
+
+void display_push_runs(int16_t x, int16_t y, int16_t w, int16_t h,
+                       const DisplayRun* runs, int count) {
+    if (!gfx || target == canvas) {
+        return;
+    }
+    stats.primitives++;
+    flush_batch();  // Queued fills underneath must land first
+    if (indexed) {
+        // One fill per row span of each run
+        int32_t pos = 0;
+        for (int i = 0; i < count; i++) {
+            int32_t left = runs[i].count;
+            while (left > 0 && pos < (int32_t)w * h) {
+                int32_t col = pos % w;
+                int32_t n = (left < w - col) ? left : w - col;
+                indexed_frame_fill(frame, x + col, y + pos / w, n, 1, runs[i].color);
+                pos += n;
+                left -= n;
+            }
+        }
+    } else {
+        gfx->startWrite();
+        gfx->setAddrWindow(x, y, w, h);
+        for (int i = 0; i < count; i++) {
+            gfx->writeColor(runs[i].color, runs[i].count);
+        }
+        gfx->endWrite();
+        count_transaction((uint32_t)w * h);
+    }
+    if (x == 0 && y == 0 && w == LCD_WIDTH && h == LCD_HEIGHT) {
+        clear_count++;
+    }
+    indexed_commit();
+}
+
+// ============================================================================
+// Row-color streaming
+// ============================================================================
+
+// Stream one piece of a row-color region (row_colors[0] is screen row y)
+// as one address window
+static void stream_rows(const ClipRect* p, int16_t y, const uint16_t* row_colors) {
+    int16_t row = p->y - y;
+    int16_t rows = p->h;
+    int16_t w = p->w;
+    if (target == canvas) {
+        for (int16_t r = row; r < row + rows; r++) {
+            target->fillRect(p->x - target_x, y + r - target_y, w, 1, row_colors[r]);
+        }
+        return;
+    }
+    if (indexed) {
+        for (int16_t r = row; r < row + rows; r++) {
+            indexed_frame_fill(frame, p->x, y + r, w, 1, row_colors[r]);
+        }
+        return;
+    }
+    gfx->setAddrWindow(p->x, p->y, w, rows);
+    int16_t r = row;
+    while (r < row + rows) {
+        // Equal neighbouring rows go out as one burst
+        int16_t run = 1;
+        while (r + run < row + rows && row_colors[r + run] == row_colors[r]) {
+            run++;
+        }
+        gfx->writeColor(row_colors[r], (uint32_t)w * run);
+        r += run;
+    }
+    count_transaction((uint32_t)w * rows);
+}
+
+void display_push_row_colors(int16_t x, int16_t y, int16_t w, int16_t h,
+                             const uint16_t* row_colors) {
+    if (!target) {
+        return;
+    }
+    if (x < 0) { w += x; x = 0; }
+    if (x + w > LCD_WIDTH) w = LCD_WIDTH - x;
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    if (target == canvas) {
+        ClipRect whole = {x, y, w, h};
+        stream_rows(&whole, y, row_colors);
+        return;
+    }
+    
+    stats.primitives++;
+    flush_batch();  // Queued fills underneath must land first
+    if (!indexed) {
+        gfx->startWrite();
+    }
+    ClipRect pieces[CLIP_MAX_PIECES];
+    int n = clip_visible(&clip, x, y, w, h, pieces);
+    for (int i = 0; i < n; i++) {
+        stream_rows(&pieces[i], y, row_colors);
+    }
+    if (!indexed) {
+        gfx->endWrite();
+    }
+    indexed_commit();
+}
+
+// ============================================================================
+// Clip regions
+// ============================================================================
+
+bool display_clip_exclude_push(int16_t x, int16_t y, int16_t w, int16_t h) {
+    return clip_push(&clip, x, y, w, h);
+}
+
+void display_clip_exclude_pop() {
+    clip_pop(&clip);
+}
+
+// ============================================================================
+// Pixel windows
+// ============================================================================
+
+void display_window_begin(int16_t x, int16_t y, int16_t w, int16_t h) {
+    window_x = x;
+    window_y = y;
+    window_w = w;
+    window_h = h;
+    window_row = 0;
+    window_pos = 0;
+    if (!target || target == canvas) {
+        return;
+    }
+    stats.primitives++;
+    if (indexed) {
+        window_clipped = clip_intersects(&clip, x, y, w, h);
+        return;
+    }
+    flush_batch();  // Queued fills underneath must land first
+    gfx->startWrite();
+    window_clipped = clip_intersects(&clip, x, y, w, h);
+    if (!window_clipped) {
+        gfx->setAddrWindow(x, y, w, h);
+    }
+}
+
+void display_window_write_row(const uint16_t* pixels) {
+    if (!target || window_row >= window_h) {
+        return;
+    }
+    if (target == canvas) {
+        canvas->pushImage(window_x - target_x, window_y + window_row - target_y, window_w, 1, pixels);
+    } else if (indexed) {
+        ClipRect pieces[CLIP_MAX_PIECES];
+        int n = clip_visible(&clip, window_x, window_y + window_row, window_w, 1, pieces);
+        for (int i = 0; i < n; i++) {
+            indexed_frame_write(frame, pieces[i].x, pieces[i].y, pieces[i].w,
+                                pixels + (pieces[i].x - window_x));
+        }
+    } else if (!window_clipped) {
+        gfx->writePixels(pixels, window_w, true);
+    } else {
+        // Send this row's visible spans, each as its own small window
+        ClipRect pieces[CLIP_MAX_PIECES];
+        int n = clip_visible(&clip, window_x, window_y + window_row, window_w, 1, pieces);
+        for (int i = 0; i < n; i++) {
+            gfx->setAddrWindow(pieces[i].x, pieces[i].y, pieces[i].w, 1);
+            gfx->writePixels(pixels + (pieces[i].x - window_x), pieces[i].w, true);
+            count_transaction(pieces[i].w);
+        }
+    }
+    window_row++;
+}
+
+// Send part of one window row: pixels, or one color when pixels is null
+static void window_span(int16_t col, int16_t row, int16_t n, const uint16_t* pixels, uint16_t color) {
+    int16_t x = window_x + col;
+    int16_t y = window_y + row;
+    if (target == canvas) {
+        if (pixels) {
+            canvas->pushImage(x - target_x, y - target_y, n, 1, pixels);
+        } else {
+            canvas->fillRect(x - target_x, y - target_y, n, 1, color);
+        }
+        return;
+    }
+    ClipRect pieces[CLIP_MAX_PIECES];
+    int k = clip_visible(&clip, x, y, n, 1, pieces);
+    for (int i = 0; i < k; i++) {
+        if (indexed) {
+            if (pixels) {
+                indexed_frame_write(frame, pieces[i].x, y, pieces[i].w, pixels + (pieces[i].x - x));
+            } else {
+                indexed_frame_fill(frame, pieces[i].x, y, pieces[i].w, 1, color);
+            }
+            continue;
+        }
+        gfx->setAddrWindow(pieces[i].x, pieces[i].y, pieces[i].w, 1);
+        if (pixels) {
+            gfx->writePixels(pixels + (pieces[i].x - x), pieces[i].w, true);
+        } else {
+            gfx->writeColor(color, pieces[i].w);
+        }
+        count_transaction(pieces[i].w);
+    }
+}
+
+// Canvas, indexed frame or clipped window: walk the pixels in raster order,
+// one row span at a time
+static void window_spans(const uint16_t* pixels, uint16_t color, uint32_t count) {
+    while (count > 0) {
+        int16_t row = window_pos / window_w;
+        int16_t col = window_pos % window_w;
+        int16_t n = (count < (uint32_t)(window_w - col)) ? (int16_t)count : window_w - col;
+        window_span(col, row, n, pixels, color);
+        if (pixels) {
+            pixels += n;
+        }
+        window_pos += n;
+        count -= n;
+    }
+}
+
+// Pixels of a write that still fit in the window
+static uint32_t window_take(uint32_t count) {
+    uint32_t left = (uint32_t)window_w * window_h - window_pos;
+    return (count < left) ? count : left;
+}
+
+void display_window_write_run(uint16_t color, uint32_t count) {
+    if (!target) {
+        return;
+    }
+    count = window_take(count);
+    if (target == canvas || indexed || window_clipped) {
+        window_spans(nullptr, color, count);
+        return;
+    }
+    // pushBlock into the open address window, wrapping across rows
+    gfx->writeColor(color, count);
+    window_pos += count;
+}
+
+void display_window_write_pixels(const uint16_t* pixels, uint32_t count) {
+    if (!target) {
+        return;
+    }
+    count = window_take(count);
+    if (target == canvas || indexed || window_clipped) {
+        window_spans(pixels, 0, count);
+        return;
+    }
+    gfx->writePixels(pixels, count, true);
+    window_pos += count;
+}
+
+void display_window_end() {
+    if (!target || target == canvas) {
+        return;
+    }
+    if (indexed) {
+        indexed_commit();
+        return;
+    }
+    gfx->endWrite();
+    if (!window_clipped) {
+        count_transaction((uint32_t)window_w * window_h);
+    }
+}
+
+uint32_t display_get_clear_count() {
+    return clear_count;
+}
+
+// ============================================================================
+// Hardware vertical scrolling
+// ============================================================================
+
+#define ST7789_NORON          0x13
+#define ST7789_VSCRDEF        0x33
+#define ST7789_VSCRSADD       0x37
+
+bool display_scroll_define(int16_t top_fixed, int16_t scroll_h) {
+#if LCD_ROTATION != 0
+    // Scrolling runs along the panel's native rows; other rotations would
+    // move it sideways or mirror the fixed areas
+    (void)top_fixed;
+    (void)scroll_h;
+    return false;
 #else
-// Native build stubs for testing
-bool display_init() { return true; }
-void display_clear(uint16_t color) { (void)color; }
-void display_set_brightness(uint8_t level) { (void)level; }
-void display_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-    (void)x; (void)y; (void)w; (void)h; (void)color;
+    if (!gfx || indexed) {
+        return false;  // The shadow frame maps rows to the screen one to one
+    }
+    // The areas cover the controller's whole RAM; the panel's visible rows
+    // start LCD_ROW_OFFSET rows into it
+    flush_batch();
+    gfx->startWrite();
+    gfx->writeCommand(ST7789_VSCRDEF);
+    gfx->writeData16(LCD_ROW_OFFSET + top_fixed);
+    gfx->writeData16(scroll_h);
+    gfx->writeData16(LCD_MEMORY_HEIGHT - LCD_ROW_OFFSET - top_fixed - scroll_h);
+    gfx->endWrite();
+    count_transaction(0);
+    return true;
+#endif
 }
-void display_draw_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-    (void)x; (void)y; (void)w; (void)h; (void)color;
+
+void display_scroll_to(int16_t start) {
+    if (!gfx) {
+        return;
+    }
+    push_finish();  // The bus is the push's until it is done
+    flush_batch();
+    gfx->startWrite();
+    gfx->writeCommand(ST7789_VSCRSADD);
+    gfx->writeData16(LCD_ROW_OFFSET + start);  // RAM row, like the areas
+    gfx->endWrite();
+    count_transaction(0);
 }
-void display_draw_hline(int16_t x, int16_t y, int16_t w, uint16_t color) {
-    (void)x; (void)y; (void)w; (void)color;
-}
-void display_set_cursor(int16_t x, int16_t y) { (void)x; (void)y; }
-void display_set_text_color(uint16_t color) { (void)color; }
-void display_set_text_size(uint8_t size) { (void)size; }
-void display_print(const char* text) { (void)text; }
-void display_print_int(int value) { (void)value; }
-void display_print_float(float value, int decimals) { (void)value; (void)decimals; }
-int16_t display_get_text_width(const char* text, uint8_t size) {
-    int len = 0;
-    while (text[len]) len++;
-    return len * 6 * size;
+
+void display_scroll_reset() {
+#if LCD_ROTATION == 0
+    if (!gfx) {
+        return;
+    }
+    display_scroll_define(0, LCD_HEIGHT);
+    display_scroll_to(0);
+    gfx->startWrite();
+    gfx->writeCommand(ST7789_NORON);  // Leave scroll mode
+    gfx->endWrite();
+#endif
+}
+
+// ============================================================================
+// Frame batching
+// ============================================================================
+
+void display_frame_begin() {
+    // The previous push still reads its rows; drawing into them would tear.
+    // Chunks go out back to back, so this only waits for a bus-bound push.
+    push_finish();
+    frame_timing = {0, 0, 0, 0, 0, 0};
+    frame_begin_us = micros();
+    frame_dma_start = dma_pixels;
+    if (gfx) {
+        canvas_dma_close();
+    }
+    if (indexed) {
+        // Drawing lands in the indexed frame until display_frame_end()
+        frame_open = true;
+        frame_start = stats;
+        return;
+    }
+#if DISPLAY_BATCH_ENABLE
+    if (!gfx || frame_open) {
+        return;
+    }
+    draw_batch_clear(&batch);
+    gfx->startWrite();
+    frame_open = true;
+#endif
+    frame_start = stats;
+}
+
+DisplayStats display_frame_end() {
+#if DISPLAY_BATCH_ENABLE
+    if (frame_open && !indexed) {
+        flush_batch();
+        gfx->endWrite();
+        frame_open = false;
+    }
+#endif
+    // Counted before the push starts: its transfers are not in the result
+    DisplayStats result;
+    result.primitives = stats.primitives - frame_start.primitives;
+    result.transactions = stats.transactions - frame_start.transactions;
+    result.pixels = stats.pixels - frame_start.pixels;
+    if (indexed && frame_open) {
+        frame_open = false;
+        frame_timing.draw_us = micros() - frame_begin_us;
+        push_start(true);
+#if !DISPLAY_ASYNC_ENABLE
+        push_finish();
+#endif
+    } else if (!indexed) {
+        // Direct drawing waited for every transfer but the canvas DMA, whose
+        // waits were measured; bus time is derived from the write clock
+        uint32_t dma = dma_pixels - frame_dma_start;
+        uint32_t blocked = result.pixels > dma ? result.pixels - dma : 0;
+        frame_timing.draw_us = micros() - frame_begin_us;
+        frame_timing.wait_us += push_pipeline_bus_us(blocked);
+        frame_finished(0, push_pipeline_bus_us(result.pixels));
+    }
+    return result;
 }
+
+// ============================================================================
+// Background push and frame timing
+// ============================================================================
+
+bool display_push_busy() {
+    return !push_idle();
+}
+
+void display_wait() {
+    push_finish();
+    if (gfx && !indexed) {
+        canvas_dma_wait();
+        canvas_dma_close();
+    }
+}
+
+DisplayTiming display_timing_get() {
+    PUSH_LOCK();
+    DisplayTiming t = timing;
+    PUSH_UNLOCK();
+    return t;
+}
+
+void display_set_frame_done(DisplayFrameDoneFn fn, void* context) {
+    frame_done = fn;
+    frame_done_context = context;
+}
+
+// ============================================================================
+// Indexed shadow frame
+// ============================================================================
+
+bool display_indexed_enable(bool enable) {
+    if (!enable) {
+        indexed_commit();
+        push_finish();
+        indexed = false;
+        return true;
+    }
+    if (!gfx || indexed) {
+        return indexed;
+    }
+    if (!frame) {
+        frame = (IndexedFrame*)malloc(sizeof(IndexedFrame));
+        if (!frame) {
+            return false;
+        }
+    }
+#if DISPLAY_ASYNC_ENABLE
+    if (!push_task_create()) {
+        return false;
+    }
+#endif
+    flush_batch();
+    // The pipeline holds its own transaction; a canvas push must be out first
+    gfx->waitDMA();
+    canvas_dma_close();
+    indexed_frame_init(frame, UI_COLOR_BACKGROUND);
+    push_pipeline_init(&pipeline, frame, bus_busy, bus_start, push_done, nullptr);
+    indexed = true;
+    return true;
+}
+
+bool display_indexed_active() {
+    return indexed;
+}
+
+bool display_palette_replace(uint16_t from, uint16_t to) {
+    if (!indexed || !indexed_frame_recolor(frame, from, to)) {
+        return false;
+    }
+    indexed_commit();
+    return true;
+}
+
+// ============================================================================
+// Traffic counters
+// ============================================================================
+
+void display_stats_reset() {
+    PUSH_LOCK();
+    stats.primitives = 0;
+    stats.transactions = 0;
+    stats.pixels = 0;
+    frame_start = stats;
+    frame_dma_start = dma_pixels;
+    PUSH_UNLOCK();
+}
+
+DisplayStats display_stats_get() {
+    PUSH_LOCK();
+    DisplayStats s = stats;
+    PUSH_UNLOCK();
+    return s;
+}
+
+#else
+// Native build: host harness with an emulated panel (display_host.cpp)
 #endif
@@ -20,7 +20,7 @@ public:
             auto cfg = _bus_instance.config();
             cfg.spi_host = SPI2_HOST;
             cfg.spi_mode = 0;
-            cfg.freq_write = 40000000;
+            cfg.freq_write = LCD_SPI_WRITE_HZ;
             cfg.freq_read = 16000000;
             cfg.spi_3wire = false;
             cfg.use_lock = true;
@@ -39,12 +39,12 @@ public:
             cfg.pin_cs = LCD_PIN_CS;
             cfg.pin_rst = LCD_PIN_RST;
             cfg.pin_busy = -1;
-            cfg.memory_width = 170;
-            cfg.memory_height = 320;
-            cfg.panel_width = 170;
-            cfg.panel_height = 320;
-            cfg.offset_x = 35;
-            cfg.offset_y = 0;
+            cfg.memory_width = LCD_MEMORY_WIDTH;
+            cfg.memory_height = LCD_MEMORY_HEIGHT;
+            cfg.panel_width = LCD_PANEL_WIDTH;
+            cfg.panel_height = LCD_PANEL_HEIGHT;
+            cfg.offset_x = LCD_COL_OFFSET;
+            cfg.offset_y = LCD_ROW_OFFSET;
             cfg.offset_rotation = 0;
             cfg.dummy_read_pixel = 8;
             cfg.dummy_read_bits = 1;
@@ -72,6 +72,35 @@ public:
 };
 #endif
 
+/**
+ * @brief Panel traffic counters (host harness and on-device diagnostics)
+ * A transaction is one address window plus its pixel data burst.
+ */
+typedef struct {
+    uint32_t primitives;    // Drawing calls made to the display layer
+    uint32_t transactions;  // Address window + pixel data bursts
+    uint32_t pixels;        // Pixels written to the panel
+} DisplayStats;
+
+/**
+ * @brief Where the time of one frame went (microseconds)
+ * The CPU is free for loop() during push_us - wait_us. In a direct frame,
+ * bus_us - wait_us is canvas DMA time the CPU spent drawing instead.
+ */
+typedef struct {
+    uint32_t frame_us;      // display_frame_begin() to the last pixel on the panel
+    uint32_t draw_us;       // display_frame_begin() to display_frame_end()
+    uint32_t push_us;       // display_frame_end() to the last transfer done
+    uint32_t wait_us;       // CPU blocked on the bus for this frame
+    uint32_t bus_us;        // Chunks on the bus, start to seen done (direct: at the write clock)
+    uint32_t bus_idle_us;   // Part of push_us the bus had nothing to send
+} DisplayTiming;
+
+/**
+ * @brief Called once a frame is on the panel
+ */
+typedef void (*DisplayFrameDoneFn)(void* context, const DisplayTiming* timing);
+
 /**
  * @brief Initialize the LCD display
  * @return true if successful, false otherwise
@@ -88,6 +117,7 @@ LGFX* display_get_gfx();
 
 /**
  * @brief Clear the entire screen with specified color
+ * Ignores the clip stack: excluded regions are cleared as well.
  * @param color Fill color (RGB565)
  */
 void display_clear(uint16_t color);
@@ -173,4 +203,312 @@ void display_print_float(float value, int decimals);
  */
 int16_t display_get_text_width(const char* text, uint8_t size);
 
+// ============================================================================
+// Off-screen canvas (compose a region in RAM, push it in one transfer)
+// ============================================================================
+
+/**
+ * @brief Start composing a screen region off-screen
+ * Drawing calls (screen coordinates) go to an RGB565 buffer cleared to
+ * UI_COLOR_BACKGROUND until display_canvas_end(). The region is clipped
+ * to the screen.
+ * @param x X position
+ * @param y Y position
+ * @param w Width
+ * @param h Height
+ * @return false if the buffer could not be allocated (drawing stays direct)
+ */
+bool display_canvas_begin(int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * @brief Push the canvas to the panel with a single DMA transfer
+ * The push is clipped against excluded regions (split into one transfer
+ * per visible piece), so content drawn there by someone else is preserved.
+ * The transfer keeps running: the next canvas is drawn into another of the
+ * DISPLAY_CANVAS_BUFFERS buffers. display_wait() blocks until it is out.
+ */
+void display_canvas_end();
+
+/**
+ * @brief Read back one row of the open canvas
+ * @param row Canvas row (0 = top)
+ * @param out Canvas width of RGB565 pixels
+ */
+void display_canvas_read_row(int16_t row, uint16_t* out);
+
+/**
+ * @brief Close the canvas without sending it to the panel
+ */
+void display_canvas_discard();
+
+// ============================================================================
+// Run-length images
+// ============================================================================
+
+/**
+ * @brief One run of equal pixels in raster order
+ */
+typedef struct {
+    uint16_t count;                     // Pixels in the run
+    uint16_t color;                     // RGB565
+} DisplayRun;
+
+/**
+ * @brief Send a run-length image through one address window
+ * Runs fill the window in raster order and may wrap across row ends. Like
+ * display_clear() the push ignores the clip stack, and a full-screen push
+ * counts as a clear (display_get_clear_count()).
+ * @param x X position
+ * @param y Y position
+ * @param w Width
+ * @param h Height
+ * @param runs Runs covering exactly w * h pixels
+ * @param count Number of runs
+ */
+void display_push_runs(int16_t x, int16_t y, int16_t w, int16_t h,
+                       const DisplayRun* runs, int count);
+
+// ============================================================================
+// Row-color streaming
+// ============================================================================
+
+/**
+ * @brief Paint a region where every row is a single color, as one window
+ * Opens one address window and streams each row's color repeated across
+ * the width (runs of equal rows are sent as one burst). Excluded regions
+ * are skipped by splitting the window.
+ * @param x X position
+ * @param y Y position
+ * @param w Width
+ * @param h Height (number of entries in row_colors)
+ * @param row_colors RGB565 color of each row, top to bottom
+ */
+void display_push_row_colors(int16_t x, int16_t y, int16_t w, int16_t h,
+                             const uint16_t* row_colors);
+
+// ============================================================================
+// Clip regions (areas no drawing may touch)
+// ============================================================================
+
+/**
+ * @brief Exclude a screen region from all panel drawing until popped
+ * Fills, text, row streams, pixel windows and canvas pushes are clipped
+ * against every excluded region. Callers draw whole shapes and the layer
+ * splits them, so nothing else needs to know about the region.
+ * @param x X position
+ * @param y Y position
+ * @param w Width
+ * @param h Height
+ * @return false if DISPLAY_CLIP_MAX regions are already excluded
+ */
+bool display_clip_exclude_push(int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * @brief Remove the most recently excluded region
+ */
+void display_clip_exclude_pop();
+
+// ============================================================================
+// Pixel windows (one address window, pixel data written row by row)
+// ============================================================================
+
+/**
+ * @brief Open an address window for pixel data
+ * The window must lie on screen. If it crosses an excluded region, each
+ * row is sent as its visible spans instead. Follow with exactly h calls to
+ * display_window_write_row() (or w * h pixels of display_window_write_run()
+ * and display_window_write_pixels(), not mixed with rows), then
+ * display_window_end().
+ * @param x X position
+ * @param y Y position
+ * @param w Width
+ * @param h Height
+ */
+void display_window_begin(int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * @brief Write the next row of the open window
+ * @param pixels w RGB565 pixels
+ */
+void display_window_write_row(const uint16_t* pixels);
+
+/**
+ * @brief Write the next count pixels of the open window in one color
+ * Runs wrap from row to row in raster order, so a decoder can stream
+ * compressed images without a row buffer.
+ * @param color RGB565 color
+ * @param count Pixels (clamped to what is left of the window)
+ */
+void display_window_write_run(uint16_t color, uint32_t count);
+
+/**
+ * @brief Write the next count pixels of the open window from a buffer
+ * @param pixels count RGB565 pixels in raster order
+ * @param count Pixels (clamped to what is left of the window)
+ */
+void display_window_write_pixels(const uint16_t* pixels, uint32_t count);
+
+/**
+ * @brief Close the pixel window
+ */
+void display_window_end();
+
+/**
+ * @brief Number of full-screen clears so far
+ * Lets caches of on-screen content notice that the screen was wiped.
+ */
+uint32_t display_get_clear_count();
+
+// ============================================================================
+// Hardware vertical scrolling (ST7789 VSCRDEF / VSCRSADD)
+// ============================================================================
+
+/**
+ * @brief Split panel memory into a fixed top, a scrolling band and a fixed bottom
+ * While scrolling, drawing coordinates address panel memory rows; screen
+ * row top_fixed + i of the band shows memory row
+ * top_fixed + (start - top_fixed + i) % scroll_h.
+ * @param top_fixed Rows fixed at the top
+ * @param scroll_h Rows in the scrolling band (the rest are fixed at the bottom)
+ * @return false if the panel cannot scroll in this rotation (landscape/180)
+ */
+bool display_scroll_define(int16_t top_fixed, int16_t scroll_h);
+
+/**
+ * @brief Set the memory row shown at the top of the scrolling band
+ * @param start Memory row, top_fixed <= start < top_fixed + scroll_h
+ */
+void display_scroll_to(int16_t start);
+
+/**
+ * @brief Return to an unscrolled full-screen layout
+ */
+void display_scroll_reset();
+
+// ============================================================================
+// Frame batching
+// ============================================================================
+
+/**
+ * @brief Start recording a frame (DISPLAY_BATCH_ENABLE)
+ * Fills, lines and outlines are queued and coalesced (see draw_batch.h)
+ * instead of being sent one by one. Text and canvas pushes flush the queue
+ * first so drawing order is preserved.
+ */
+void display_frame_begin();
+
+/**
+ * @brief Flush the frame in address order inside one startWrite()/endWrite()
+ * With the indexed frame, push its dirty rows instead; with
+ * DISPLAY_ASYNC_ENABLE the push only starts here and goes on in the
+ * background, each chunk starting when the one before it is done.
+ * @return Primitives recorded vs transactions sent during this frame; an
+ *         indexed push is not included (its transfers show in
+ *         display_stats_get() as they start)
+ */
+DisplayStats display_frame_end();
+
+// ============================================================================
+// Background push and frame timing
+// ============================================================================
+
+/**
+ * @brief Whether a background push is still going out
+ * On the panel a task started with the indexed frame chains the chunks
+ * from DMA completion; loop() does not need to poll. The next
+ * display_frame_begin() waits for the push to finish, so frames never mix
+ * on the panel.
+ */
+bool display_push_busy();
+
+/**
+ * @brief Wait until the current push (indexed frame or canvas) is on the panel
+ */
+void display_wait();
+
+/**
+ * @brief Timing of the last frame that reached the panel
+ * Direct drawing blocks on every transfer: push_us is 0 and its bus time
+ * counts as waiting.
+ */
+DisplayTiming display_timing_get();
+
+/**
+ * @brief Call fn when a frame is on the panel
+ * With DISPLAY_ASYNC_ENABLE on the panel, fn runs in the push task.
+ * @param fn nullptr to stop
+ */
+void display_set_frame_done(DisplayFrameDoneFn fn, void* context);
+
+// ============================================================================
+// Indexed shadow frame (4 bpp, see indexed_frame.h)
+// ============================================================================
+
+/**
+ * @brief Draw into a full-screen 4 bpp frame instead of the panel
+ * Every drawing call lands in RAM; display_frame_end() pushes the rows that
+ * changed (outside a frame, each call is pushed when it returns). The frame
+ * starts cleared to UI_COLOR_BACKGROUND. While enabled, the canvas is not
+ * used (composition is already off-screen) and hardware scrolling is off.
+ * @param enable true to switch to the frame, false to draw direct again
+ * @return false if the frame could not be allocated (drawing stays direct)
+ */
+bool display_indexed_enable(bool enable);
+
+/**
+ * @brief Whether drawing goes to the indexed frame
+ */
+bool display_indexed_active();
+
+/**
+ * @brief Recolor every pixel of one color (indexed frame only)
+ * A palette write plus a push of the rows that use the color.
+ * @return false if not indexed or the color is not on screen
+ */
+bool display_palette_replace(uint16_t from, uint16_t to);
+
+// ============================================================================
+// Traffic counters
+// ============================================================================
+
+/**
+ * @brief Reset the panel traffic counters
+ */
+void display_stats_reset();
+
+/**
+ * @brief Get the panel traffic counters since the last reset
+ */
+DisplayStats display_stats_get();
+
+#ifdef NATIVE_BUILD
+// ============================================================================
+// Host harness (native build only)
+// ============================================================================
+
+/**
+ * @brief Read back a pixel from the emulated panel
+ * @return RGB565 color at (x, y), 0 if off-screen
+ */
+uint16_t display_host_get_pixel(int16_t x, int16_t y);
+
+/**
+ * @brief Emulated panel memory (LCD_WIDTH x LCD_HEIGHT, row-major RGB565)
+ */
+const uint16_t* display_host_framebuffer();
+
+/**
+ * @brief Read back a pixel as seen on screen (after hardware scrolling)
+ */
+uint16_t display_host_get_screen_pixel(int16_t x, int16_t y);
+
+/**
+ * @brief Advance the host clock
+ * Transfers on the modelled bus take their time at LCD_SPI_WRITE_HZ and
+ * finish as the clock passes; each one that finishes starts the next chunk
+ * of a background push.
+ */
+void display_host_advance_us(uint32_t us);
+#endif
+
 #endif // DISPLAY_H
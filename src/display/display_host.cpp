@@ -0,0 +1,906 @@
+/*******************************************************************************
+ * Host display harness (native build only)
+ *
+ * Emulates the panel as an RGB565 framebuffer so unit tests can read back
+ * pixels, and counts bus traffic the way the firmware path issues it: one
+ * transaction per address window. Text uses the same 5x7 GLCD glyphs as
+ * LovyanGFX's default font with a transparent background, drawn as one
+ * transaction per horizontal run of set pixels.
+ ******************************************************************************/
+
+#ifdef NATIVE_BUILD
+
+#include "display.h"
+#include "clip_region.h"
+#include "draw_batch.h"
+#include "font_glcd.h"
+#include "indexed_frame.h"
+#include "push_pipeline.h"
+#include "text_format.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Emulated panel memory
+static uint16_t panel[LCD_WIDTH * LCD_HEIGHT];
+
+// Current draw target: the panel, or the off-screen canvas while composing
+static uint16_t* target = panel;
+static int16_t target_x = 0;        // Target origin in screen coordinates
+static int16_t target_y = 0;
+static int16_t target_w = LCD_WIDTH;
+static int16_t target_h = LCD_HEIGHT;
+
+// Canvases are used in turn, as on the panel
+static uint16_t* canvases[DISPLAY_CANVAS_BUFFERS] = {};
+static int16_t canvas_ws[DISPLAY_CANVAS_BUFFERS] = {};
+static int16_t canvas_hs[DISPLAY_CANVAS_BUFFERS] = {};
+static int canvas_slot = 0;
+static int canvas_on_bus = -1;              // Slot of the last push
+static uint16_t* canvas = nullptr;          // Open, or last opened
+static int16_t canvas_w = 0;
+static int16_t canvas_h = 0;
+static uint32_t dma_pixels = 0;             // Canvas pixels handed to DMA
+static uint32_t frame_dma_start = 0;
+
+// Text state
+static int16_t cursor_x = 0;
+static int16_t cursor_y = 0;
+static uint16_t text_color = UI_COLOR_TEXT;
+static uint8_t text_size = 1;
+
+static DisplayStats stats = {0, 0, 0};
+static uint32_t clear_count = 0;
+
+// Excluded regions
+static ClipStack clip = {};
+
+// Hardware scroll state (VSCRDEF / VSCRSADD)
+static int16_t scroll_top = 0;
+static int16_t scroll_h = LCD_HEIGHT;
+static int16_t scroll_start = 0;
+
+// Open pixel window
+static int16_t window_x = 0;
+static int16_t window_y = 0;
+static int16_t window_w = 0;
+static int16_t window_h = 0;
+static int16_t window_row = 0;
+static uint32_t window_pos = 0;     // Pixels written by runs so far
+static bool window_clipped = false;
+
+// Frame command queue
+static DrawBatch batch;
+static bool frame_open = false;
+static DisplayStats frame_start = {0, 0, 0};
+
+// Indexed shadow frame: while active, panel drawing lands here instead
+static IndexedFrame* frame = nullptr;
+static bool indexed = false;
+static PushPipeline pipeline;
+
+// Modelled bus: a transfer keeps it busy until bus_free_us on the host clock.
+// Its completion starts the next chunk, as the push task does on the panel.
+static uint32_t host_now_us = 0;
+static uint32_t bus_free_us = 0;
+
+// Frame timing
+static DisplayTiming timing = {0, 0, 0, 0, 0, 0};     // Last frame on the panel
+static DisplayTiming frame_timing = {0, 0, 0, 0, 0, 0};
+static uint32_t frame_begin_us = 0;
+static bool frame_pushing = false;  // The pipeline carries that frame
+static bool push_waiting = false;
+static uint32_t wait_start_us = 0;
+static DisplayFrameDoneFn frame_done = nullptr;
+static void* frame_done_context = nullptr;
+
+// Count panel traffic (canvas and indexed frame drawing are RAM-only)
+static void count_transaction(uint32_t pixels) {
+    if (target != panel || indexed) {
+        return;
+    }
+    stats.transactions++;
+    stats.pixels += pixels;
+}
+
+// Fill a rectangle in the current target, clipped; returns pixels written
+static uint32_t host_fill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (indexed && target == panel) {
+        indexed_frame_fill(frame, x, y, w, h, color);
+        return 0;
+    }
+    int32_t x0 = x - target_x;
+    int32_t y0 = y - target_y;
+    int32_t x1 = x0 + w;
+    int32_t y1 = y0 + h;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > target_w) x1 = target_w;
+    if (y1 > target_h) y1 = target_h;
+    if (x0 >= x1 || y0 >= y1) {
+        return 0;
+    }
+    for (int32_t row = y0; row < y1; row++) {
+        uint16_t* p = target + row * target_w;
+        for (int32_t col = x0; col < x1; col++) {
+            p[col] = color;
+        }
+    }
+    return (uint32_t)(x1 - x0) * (uint32_t)(y1 - y0);
+}
+
+// Send queued fills to the panel in address order
+static void flush_batch() {
+    if (batch.count == 0) {
+        return;
+    }
+    draw_batch_sort(&batch);
+    for (int i = 0; i < batch.count; i++) {
+        const DrawCommand* c = &batch.cmds[i];
+        uint32_t n = host_fill(c->x, c->y, c->w, c->h, c->color);
+        if (n > 0) {
+            count_transaction(n);
+        }
+    }
+    batch.count = 0;
+}
+
+// ============================================================================
+// Indexed frame push
+// ============================================================================
+
+static bool bus_busy(void* context) {
+    (void)context;
+    return (int32_t)(bus_free_us - host_now_us) > 0;
+}
+
+// One expanded chunk of the indexed frame: one full-width window
+static void bus_start(void* context, int16_t y, int16_t rows, const uint16_t* pixels) {
+    (void)context;
+    uint32_t n = (uint32_t)rows * LCD_WIDTH;
+    memcpy(&panel[y * LCD_WIDTH], pixels, sizeof(uint16_t) * n);
+    stats.transactions++;
+    stats.pixels += n;
+    bus_free_us = host_now_us + push_pipeline_bus_us(n);
+}
+
+// Publish a frame's timing once its last pixel is out
+static void frame_finished(uint32_t push_us, uint32_t bus_us) {
+    frame_timing.push_us = push_us;
+    frame_timing.frame_us = host_now_us - frame_begin_us;
+    frame_timing.bus_us = bus_us;
+    frame_timing.bus_idle_us = push_us > bus_us ? push_us - bus_us : 0;
+    timing = frame_timing;
+    if (frame_done) {
+        frame_done(frame_done_context, &timing);
+    }
+}
+
+static void push_done(void* context, uint32_t push_us, uint32_t bus_us) {
+    (void)context;
+    if (!frame_pushing) {
+        return;
+    }
+    frame_pushing = false;
+    if (push_waiting) {
+        frame_timing.wait_us += host_now_us - wait_start_us;
+    }
+    frame_finished(push_us, bus_us);
+}
+
+// Block until the push in progress is on the panel
+static void push_finish() {
+    if (!push_pipeline_active(&pipeline)) {
+        return;
+    }
+    wait_start_us = host_now_us;
+    push_waiting = true;
+    while (push_pipeline_service(&pipeline, host_now_us)) {
+        if (bus_busy(nullptr)) {
+            host_now_us = bus_free_us;
+        }
+    }
+    push_waiting = false;
+}
+
+static void push_start(bool whole_frame) {
+    push_finish();
+    frame_pushing = whole_frame;
+    push_pipeline_begin(&pipeline, false, host_now_us);
+}
+
+// Outside a frame, an indexed drawing call is pushed as soon as it is done
+static void indexed_commit() {
+    if (indexed && !frame_open) {
+        push_start(false);
+        push_finish();
+    }
+}
+
+// Route a fill to the frame queue, or straight to the current target
+static void submit_fill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (target != panel) {
+        host_fill(x, y, w, h, color);
+        return;
+    }
+    stats.primitives++;
+    ClipRect pieces[CLIP_MAX_PIECES];
+    int count = clip_visible(&clip, x, y, w, h, pieces);
+    for (int i = 0; i < count; i++) {
+        const ClipRect* p = &pieces[i];
+        if (frame_open && !indexed) {
+            if (!draw_batch_add(&batch, p->x, p->y, p->w, p->h, color)) {
+                flush_batch();
+                draw_batch_add(&batch, p->x, p->y, p->w, p->h, color);
+            }
+            continue;
+        }
+        uint32_t n = host_fill(p->x, p->y, p->w, p->h, color);
+        if (n > 0) {
+            count_transaction(n);
+        }
+    }
+    indexed_commit();
+}
+
+// Fill immediately, skipping excluded regions on the panel
+static void clipped_fill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (target != panel) {
+        host_fill(x, y, w, h, color);
+        return;
+    }
+    ClipRect pieces[CLIP_MAX_PIECES];
+    int count = clip_visible(&clip, x, y, w, h, pieces);
+    for (int i = 0; i < count; i++) {
+        uint32_t n = host_fill(pieces[i].x, pieces[i].y, pieces[i].w, pieces[i].h, color);
+        if (n > 0) {
+            count_transaction(n);
+        }
+    }
+}
+
+// Draw one glyph with a transparent background
+static void host_draw_char(int16_t x, int16_t y, char c) {
+    for (int row = 0; row < FONT_GLCD_CELL_H; row++) {
+        int col = 0;
+        while (col < FONT_GLCD_COLS) {
+            if (!(font_glcd_column(c, col) & (1 << row))) {
+                col++;
+                continue;
+            }
+            int run_start = col;
+            while (col < FONT_GLCD_COLS && (font_glcd_column(c, col) & (1 << row))) {
+                col++;
+            }
+            clipped_fill(x + run_start * text_size, y + row * text_size,
+                         (col - run_start) * text_size, text_size, text_color);
+        }
+    }
+}
+
+static void host_print(const char* text) {
+    if (target == panel) {
+        stats.primitives++;
+        flush_batch();  // Keep queued fills underneath the text
+    }
+    for (const char* c = text; *c; c++) {
+        if (*c == '\n') {
+            cursor_x = 0;
+            cursor_y += FONT_GLCD_CELL_H * text_size;
+            continue;
+        }
+        host_draw_char(cursor_x, cursor_y, *c);
+        cursor_x += FONT_GLCD_CELL_W * text_size;
+    }
+    if (target == panel) {
+        indexed_commit();
+    }
+}
+
+// ============================================================================
+// Display API
+// ============================================================================
+
+bool display_init() {
+    target = panel;
+    target_x = 0;
+    target_y = 0;
+    target_w = LCD_WIDTH;
+    target_h = LCD_HEIGHT;
+    scroll_top = 0;
+    scroll_h = LCD_HEIGHT;
+    scroll_start = 0;
+    display_indexed_enable(DISPLAY_INDEXED_ENABLE);
+    display_clear(UI_COLOR_BACKGROUND);
+    return true;
+}
+
+void display_clear(uint16_t color) {
+    // A clear covers the whole screen, excluded regions included
+    int excluded = clip.count;
+    clip.count = 0;
+    submit_fill(0, 0, LCD_WIDTH, LCD_HEIGHT, color);
+    clip.count = excluded;
+    clear_count++;
+}
+
+void display_set_brightness(uint8_t level) { (void)level; }
+
+void display_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    submit_fill(x, y, w, h, color);
+}
+
+void display_draw_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    submit_fill(x, y, w, 1, color);
+    submit_fill(x, y + h - 1, w, 1, color);
+    submit_fill(x, y + 1, 1, h - 2, color);
+    submit_fill(x + w - 1, y + 1, 1, h - 2, color);
+}
+
+void display_draw_hline(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    submit_fill(x, y, w, 1, color);
+}
+
+void display_set_cursor(int16_t x, int16_t y) {
+    cursor_x = x;
+    cursor_y = y;
+}
+
+void display_set_text_color(uint16_t color) { text_color = color; }
+void display_set_text_size(uint8_t size) { text_size = size; }
+
+void display_print(const char* text) {
+    host_print(text);
+}
+
+void display_print_int(int value) {
+    char buf[TEXT_NUMBER_MAX + 1];
+    text_format_int(buf, sizeof(buf), value, 0, ' ', TEXT_ALIGN_LEFT);
+    host_print(buf);
+}
+
+void display_print_float(float value, int decimals) {
+    char buf[TEXT_NUMBER_MAX + 1];
+    text_format_float(buf, sizeof(buf), value, (uint8_t)decimals, 0, ' ', TEXT_ALIGN_LEFT);
+    host_print(buf);
+}
+
+int16_t display_get_text_width(const char* text, uint8_t size) {
+    return text_width(&glyph_font_glcd, text, size);
+}
+
+// ============================================================================
+// Off-screen canvas
+// ============================================================================
+
+// Wait out the canvas push on the modelled bus; the CPU's share of its time
+static void canvas_dma_wait() {
+    if ((int32_t)(bus_free_us - host_now_us) > 0) {
+        frame_timing.wait_us += bus_free_us - host_now_us;
+        host_now_us = bus_free_us;
+    }
+}
+
+bool display_canvas_begin(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (indexed) {
+        return false;  // Already composing off-screen
+    }
+
+    // Queued fills must reach the panel before the canvas lands on top
+    flush_batch();
+
+    // Clip the region to the screen
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > LCD_WIDTH) w = LCD_WIDTH - x;
+    if (y + h > LCD_HEIGHT) h = LCD_HEIGHT - y;
+    if (w <= 0 || h <= 0) {
+        return false;
+    }
+
+    // The other buffer: the last push may still be reading this one's
+    canvas_slot = (canvas_slot + 1) % DISPLAY_CANVAS_BUFFERS;
+    if (canvas_slot == canvas_on_bus) {
+        canvas_dma_wait();
+    }
+
+    canvas = canvases[canvas_slot];
+    canvas_w = canvas_ws[canvas_slot];
+    canvas_h = canvas_hs[canvas_slot];
+    if (canvas_w != w || canvas_h != h) {
+        free(canvas);
+        canvas = (uint16_t*)malloc(sizeof(uint16_t) * w * h);
+        canvases[canvas_slot] = canvas;
+        if (!canvas) {
+            canvas_ws[canvas_slot] = 0;
+            canvas_hs[canvas_slot] = 0;
+            canvas_w = 0;
+            canvas_h = 0;
+            return false;
+        }
+        canvas_ws[canvas_slot] = w;
+        canvas_hs[canvas_slot] = h;
+        canvas_w = w;
+        canvas_h = h;
+    }
+    for (int i = 0; i < w * h; i++) {
+        canvas[i] = UI_COLOR_BACKGROUND;
+    }
+
+    target = canvas;
+    target_x = x;
+    target_y = y;
+    target_w = w;
+    target_h = h;
+    return true;
+}
+
+// Copy one visible piece of the canvas (screen coordinates) to the panel.
+// A full-width piece is one DMA transfer that keeps the modelled bus busy
+// while drawing goes on; one transfer at a time, so it waits for the last.
+static void push_canvas_piece(const ClipRect* p) {
+    canvas_dma_wait();
+    if (p->w == canvas_w) {
+        bus_free_us = host_now_us + push_pipeline_bus_us((uint32_t)p->w * p->h);
+        canvas_on_bus = canvas_slot;
+        dma_pixels += (uint32_t)p->w * p->h;
+    }
+    for (int16_t r = 0; r < p->h; r++) {
+        int16_t row = p->y - target_y + r;
+        memcpy(&panel[(p->y + r) * LCD_WIDTH + p->x], &canvas[row * canvas_w + (p->x - target_x)],
+               sizeof(uint16_t) * p->w);
+    }
+    // A narrower piece is still one address window, written row by row
+    stats.transactions++;
+    stats.pixels += (uint32_t)p->w * p->h;
+}
+
+void display_canvas_end() {
+    if (target != canvas) {
+        return;
+    }
+
+    ClipRect pieces[CLIP_MAX_PIECES];
+    int n = clip_visible(&clip, target_x, target_y, canvas_w, canvas_h, pieces);
+    for (int i = 0; i < n; i++) {
+        push_canvas_piece(&pieces[i]);
+    }
+
+    target = panel;
+    target_x = 0;
+    target_y = 0;
+    target_w = LCD_WIDTH;
+    target_h = LCD_HEIGHT;
+}
+
+void display_canvas_read_row(int16_t row, uint16_t* out) {
+    if (target != canvas || row < 0 || row >= canvas_h) {
+        return;
+    }
+    memcpy(out, &canvas[row * canvas_w], sizeof(uint16_t) * canvas_w);
+}
+
+void display_canvas_discard() {
+    if (target != canvas) {
+        return;
+    }
+    target = panel;
+    target_x = 0;
+    target_y = 0;
+    target_w = LCD_WIDTH;
+    target_h = LCD_HEIGHT;
+}
+
+// ============================================================================
+// Run-length images
+// ============================================================================
+
+void display_push_runs(int16_t x, int16_t y, int16_t w, int16_t h,
+                       const DisplayRun* runs, int count) {
+    if (target != panel) {
+        return;
+    }
+    stats.primitives++;
+    flush_batch();  // Queued fills underneath must land first
+    int32_t pos = 0;
+    for (int i = 0; i < count; i++) {
+        if (indexed) {
+            // One fill per row span of the run
+            int32_t left = runs[i].count;
+            while (left > 0 && pos < (int32_t)w * h) {
+                int32_t col = pos % w;
+                int32_t n = (left < w - col) ? left : w - col;
+                indexed_frame_fill(frame, x + col, y + pos / w, n, 1, runs[i].color);
+                pos += n;
+                left -= n;
+            }
+            continue;
+        }
+        for (uint16_t n = 0; n < runs[i].count && pos < (int32_t)w * h; n++, pos++) {
+            panel[(y + pos / w) * LCD_WIDTH + x + pos % w] = runs[i].color;
+        }
+    }
+    count_transaction((uint32_t)w * h);
+    indexed_commit();
+    if (x == 0 && y == 0 && w == LCD_WIDTH && h == LCD_HEIGHT) {
+        clear_count++;
+    }
+}
+
+// ============================================================================
+// Row-color streaming
+// ============================================================================
+
+// Stream one piece of a row-color region (row_colors[0] is screen row y)
+// as one address window
+static void stream_rows(const ClipRect* p, int16_t y, const uint16_t* row_colors) {
+    uint32_t n = 0;
+    for (int16_t r = p->y - y; r < p->y - y + p->h; r++) {
+        n += host_fill(p->x, y + r, p->w, 1, row_colors[r]);
+    }
+    if (n > 0) {
+        count_transaction(n);
+    }
+}
+
+void display_push_row_colors(int16_t x, int16_t y, int16_t w, int16_t h,
+                             const uint16_t* row_colors) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    if (target != panel) {
+        ClipRect whole = {x, y, w, h};
+        stream_rows(&whole, y, row_colors);
+        return;
+    }
+    
+    stats.primitives++;
+    flush_batch();  // Queued fills underneath must land first
+    ClipRect pieces[CLIP_MAX_PIECES];
+    int n = clip_visible(&clip, x, y, w, h, pieces);
+    for (int i = 0; i < n; i++) {
+        stream_rows(&pieces[i], y, row_colors);
+    }
+    indexed_commit();
+}
+
+// ============================================================================
+// Clip regions
+// ============================================================================
+
+bool display_clip_exclude_push(int16_t x, int16_t y, int16_t w, int16_t h) {
+    return clip_push(&clip, x, y, w, h);
+}
+
+void display_clip_exclude_pop() {
+    clip_pop(&clip);
+}
+
+// ============================================================================
+// Pixel windows
+// ============================================================================
+
+void display_window_begin(int16_t x, int16_t y, int16_t w, int16_t h) {
+    window_x = x;
+    window_y = y;
+    window_w = w;
+    window_h = h;
+    window_row = 0;
+    window_pos = 0;
+    window_clipped = false;
+    if (target == panel) {
+        stats.primitives++;
+        flush_batch();  // Queued fills underneath must land first
+        window_clipped = clip_intersects(&clip, x, y, w, h);
+    }
+}
+
+// Copy pixels for screen columns [x, x + w) of the current window row
+static void window_copy(const uint16_t* pixels, int16_t x, int16_t w) {
+    if (indexed && target == panel) {
+        indexed_frame_write(frame, x, window_y + window_row, w, pixels + (x - window_x));
+        return;
+    }
+    int32_t row = window_y + window_row - target_y;
+    if (row < 0 || row >= target_h) {
+        return;
+    }
+    for (int16_t i = 0; i < w; i++) {
+        int32_t col = x + i - target_x;
+        if (col >= 0 && col < target_w) {
+            target[row * target_w + col] = pixels[x - window_x + i];
+        }
+    }
+}
+
+void display_window_write_row(const uint16_t* pixels) {
+    if (window_row >= window_h) {
+        return;
+    }
+    if (!window_clipped) {
+        window_copy(pixels, window_x, window_w);
+    } else {
+        // This row's visible spans, each as its own small window
+        ClipRect pieces[CLIP_MAX_PIECES];
+        int n = clip_visible(&clip, window_x, window_y + window_row, window_w, 1, pieces);
+        for (int i = 0; i < n; i++) {
+            window_copy(pixels, pieces[i].x, pieces[i].w);
+            count_transaction(pieces[i].w);
+        }
+    }
+    window_row++;
+}
+
+// Write screen columns [x, x + n) of row y: pixels, or one color when
+// pixels is null
+static void window_put(int16_t x, int16_t y, int16_t n, const uint16_t* pixels, uint16_t color) {
+    if (indexed && target == panel) {
+        if (pixels) {
+            indexed_frame_write(frame, x, y, n, pixels);
+        } else {
+            indexed_frame_fill(frame, x, y, n, 1, color);
+        }
+        return;
+    }
+    int32_t row = y - target_y;
+    if (row < 0 || row >= target_h) {
+        return;
+    }
+    for (int16_t i = 0; i < n; i++) {
+        int32_t col = x + i - target_x;
+        if (col >= 0 && col < target_w) {
+            target[row * target_w + col] = pixels ? pixels[i] : color;
+        }
+    }
+}
+
+// Walk the window in raster order, one row span at a time
+static void window_spans(const uint16_t* pixels, uint16_t color, uint32_t count) {
+    uint32_t left = (uint32_t)window_w * window_h - window_pos;
+    if (count > left) count = left;
+    while (count > 0) {
+        int16_t x = window_x + window_pos % window_w;
+        int16_t y = window_y + window_pos / window_w;
+        int16_t n = (count < (uint32_t)(window_x + window_w - x)) ? (int16_t)count : window_x + window_w - x;
+        if (!window_clipped) {
+            window_put(x, y, n, pixels, color);
+        } else {
+            ClipRect pieces[CLIP_MAX_PIECES];
+            int k = clip_visible(&clip, x, y, n, 1, pieces);
+            for (int i = 0; i < k; i++) {
+                window_put(pieces[i].x, y, pieces[i].w, pixels ? pixels + (pieces[i].x - x) : nullptr, color);
+                count_transaction(pieces[i].w);
+            }
+        }
+        if (pixels) {
+            pixels += n;
+        }
+        window_pos += n;
+        count -= n;
+    }
+}
+
+void display_window_write_run(uint16_t color, uint32_t count) {
+    window_spans(nullptr, color, count);
+}
+
+void display_window_write_pixels(const uint16_t* pixels, uint32_t count) {
+    window_spans(pixels, 0, count);
+}
+
+void display_window_end() {
+    if (!window_clipped) {
+        count_transaction((uint32_t)window_w * window_h);
+    }
+    if (target == panel) {
+        indexed_commit();
+    }
+}
+
+uint32_t display_get_clear_count() {
+    return clear_count;
+}
+
+// ============================================================================
+// Hardware vertical scrolling (emulated)
+// ============================================================================
+
+bool display_scroll_define(int16_t top_fixed, int16_t h) {
+#if LCD_ROTATION != 0
+    (void)top_fixed;
+    (void)h;
+    return false;
+#else
+    if (indexed) {
+        return false;  // The shadow frame maps rows to the screen one to one
+    }
+    flush_batch();
+    scroll_top = top_fixed;
+    scroll_h = h;
+    count_transaction(0);
+    return true;
+#endif
+}
+
+void display_scroll_to(int16_t start) {
+    flush_batch();
+    scroll_start = start;
+    count_transaction(0);
+}
+
+void display_scroll_reset() {
+#if LCD_ROTATION == 0
+    display_scroll_define(0, LCD_HEIGHT);
+    display_scroll_to(0);
+#endif
+}
+
+// ============================================================================
+// Frame batching
+// ============================================================================
+
+void display_frame_begin() {
+    // The previous push still reads its rows; drawing into them would tear.
+    // Chunks go out back to back, so this only waits for a bus-bound push.
+    push_finish();
+    frame_timing = {0, 0, 0, 0, 0, 0};
+    frame_begin_us = host_now_us;
+    frame_dma_start = dma_pixels;
+    if (indexed) {
+        // Drawing lands in the indexed frame until display_frame_end()
+        frame_open = true;
+        frame_start = stats;
+        return;
+    }
+#if DISPLAY_BATCH_ENABLE
+    if (frame_open) {
+        return;
+    }
+    draw_batch_clear(&batch);
+    frame_open = true;
+#endif
+    frame_start = stats;
+}
+
+DisplayStats display_frame_end() {
+#if DISPLAY_BATCH_ENABLE
+    if (frame_open && !indexed) {
+        flush_batch();
+        frame_open = false;
+    }
+#endif
+    // Counted before the push starts: its transfers are not in the result
+    DisplayStats result;
+    result.primitives = stats.primitives - frame_start.primitives;
+    result.transactions = stats.transactions - frame_start.transactions;
+    result.pixels = stats.pixels - frame_start.pixels;
+    if (indexed && frame_open) {
+        frame_open = false;
+        frame_timing.draw_us = host_now_us - frame_begin_us;
+        push_start(true);
+#if !DISPLAY_ASYNC_ENABLE
+        push_finish();
+#endif
+    } else if (!indexed) {
+        // Direct drawing waited for every transfer but the canvas DMA, whose
+        // waits were measured; bus time is derived from the write clock
+        uint32_t dma = dma_pixels - frame_dma_start;
+        uint32_t blocked = result.pixels > dma ? result.pixels - dma : 0;
+        frame_timing.draw_us = host_now_us - frame_begin_us;
+        frame_timing.wait_us += push_pipeline_bus_us(blocked);
+        frame_finished(0, push_pipeline_bus_us(result.pixels));
+    }
+    return result;
+}
+
+// ============================================================================
+// Background push and frame timing
+// ============================================================================
+
+bool display_push_busy() {
+    return push_pipeline_active(&pipeline);
+}
+
+void display_wait() {
+    push_finish();
+    if (!indexed) {
+        canvas_dma_wait();
+    }
+}
+
+DisplayTiming display_timing_get() {
+    return timing;
+}
+
+void display_set_frame_done(DisplayFrameDoneFn fn, void* context) {
+    frame_done = fn;
+    frame_done_context = context;
+}
+
+// ============================================================================
+// Indexed shadow frame
+// ============================================================================
+
+bool display_indexed_enable(bool enable) {
+    if (!enable) {
+        indexed_commit();
+        push_finish();
+        indexed = false;
+        return true;
+    }
+    if (indexed) {
+        return true;
+    }
+    if (!frame) {
+        frame = (IndexedFrame*)malloc(sizeof(IndexedFrame));
+        if (!frame) {
+            return false;
+        }
+    }
+    flush_batch();
+    // The pipeline needs the bus; a canvas push must be out first
+    if ((int32_t)(bus_free_us - host_now_us) > 0) {
+        host_now_us = bus_free_us;
+    }
+    indexed_frame_init(frame, UI_COLOR_BACKGROUND);
+    push_pipeline_init(&pipeline, frame, bus_busy, bus_start, push_done, nullptr);
+    indexed = true;
+    return true;
+}
+
+bool display_indexed_active() {
+    return indexed;
+}
+
+bool display_palette_replace(uint16_t from, uint16_t to) {
+    if (!indexed || !indexed_frame_recolor(frame, from, to)) {
+        return false;
+    }
+    indexed_commit();
+    return true;
+}
+
+// ============================================================================
+// Traffic counters and read-back
+// ============================================================================
+
+void display_stats_reset() {
+    stats.primitives = 0;
+    stats.transactions = 0;
+    stats.pixels = 0;
+    frame_start = stats;
+    frame_dma_start = dma_pixels;
+}
+
+DisplayStats display_stats_get() {
+    return stats;
+}
+
+void display_host_advance_us(uint32_t us) {
+    uint32_t until = host_now_us + us;
+    // Each transfer that ends in the meantime starts the next chunk at once
+    while (push_pipeline_active(&pipeline) && (int32_t)(until - bus_free_us) >= 0) {
+        host_now_us = bus_free_us;
+        push_pipeline_service(&pipeline, host_now_us);
+    }
+    host_now_us = until;
+}
+
+uint16_t display_host_get_pixel(int16_t x, int16_t y) {
+    if (x < 0 || y < 0 || x >= LCD_WIDTH || y >= LCD_HEIGHT) {
+        return 0;
+    }
+    return panel[y * LCD_WIDTH + x];
+}
+
+const uint16_t* display_host_framebuffer() {
+    return panel;
+}
+
+uint16_t display_host_get_screen_pixel(int16_t x, int16_t y) {
+    if (y >= scroll_top && y < scroll_top + scroll_h) {
+        y = scroll_top + (scroll_start - scroll_top + (y - scroll_top)) % scroll_h;
+    }
+    return display_host_get_pixel(x, y);
+}
+
+#endif // NATIVE_BUILD
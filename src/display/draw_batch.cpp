@@ -0,0 +1,101 @@
+#include "draw_batch.h"
+
+// ============================================================================
+// Rect helpers
+// ============================================================================
+
+static bool rects_overlap(const DrawCommand* a, int16_t x, int16_t y, int16_t w, int16_t h) {
+    return a->x < x + w && x < a->x + a->w && a->y < y + h && y < a->y + a->h;
+}
+
+static bool rect_contains(const DrawCommand* outer, int16_t x, int16_t y, int16_t w, int16_t h) {
+    return x >= outer->x && y >= outer->y &&
+           x + w <= outer->x + outer->w && y + h <= outer->y + outer->h;
+}
+
+// Union of two rects if it is exactly a rect (shared full edge), else false
+static bool rects_merge(DrawCommand* c, int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (c->x == x && c->w == w) {
+        if (c->y + c->h == y) { c->h += h; return true; }
+        if (y + h == c->y) { c->y = y; c->h += h; return true; }
+    }
+    if (c->y == y && c->h == h) {
+        if (c->x + c->w == x) { c->w += w; return true; }
+        if (x + w == c->x) { c->x = x; c->w += w; return true; }
+    }
+    return false;
+}
+
+// ============================================================================
+// Batch operations
+// ============================================================================
+
+void draw_batch_clear(DrawBatch* batch) {
+    batch->count = 0;
+    batch->primitives = 0;
+}
+
+bool draw_batch_add(DrawBatch* batch, int16_t x, int16_t y, int16_t w, int16_t h,
+                    uint16_t color) {
+    if (w <= 0 || h <= 0) {
+        return true;  // Nothing to draw
+    }
+    
+    // Earlier commands hidden entirely under the new rect are dead
+    int out = 0;
+    DrawCommand incoming = {x, y, w, h, color};
+    for (int i = 0; i < batch->count; i++) {
+        const DrawCommand* c = &batch->cmds[i];
+        if (!rect_contains(&incoming, c->x, c->y, c->w, c->h)) {
+            batch->cmds[out++] = *c;
+        }
+    }
+    batch->count = out;
+    
+    // Merge into the latest same-color command that nothing after it overlaps
+    for (int i = batch->count - 1; i >= 0; i--) {
+        DrawCommand* c = &batch->cmds[i];
+        if (c->color == color) {
+            if (rect_contains(c, x, y, w, h)) {
+                batch->primitives++;
+                return true;
+            }
+            if (rects_merge(c, x, y, w, h)) {
+                batch->primitives++;
+                return true;
+            }
+        }
+        if (rects_overlap(c, x, y, w, h)) {
+            break;  // Must stay after this command
+        }
+    }
+    
+    if (batch->count >= DISPLAY_BATCH_MAX_CMDS) {
+        return false;
+    }
+    DrawCommand* c = &batch->cmds[batch->count++];
+    c->x = x;
+    c->y = y;
+    c->w = w;
+    c->h = h;
+    c->color = color;
+    batch->primitives++;
+    return true;
+}
+
+void draw_batch_sort(DrawBatch* batch) {
+    // Insertion sort; a command only moves past commands it does not overlap
+    for (int i = 1; i < batch->count; i++) {
+        for (int j = i; j > 0; j--) {
+            DrawCommand* a = &batch->cmds[j - 1];
+            DrawCommand* b = &batch->cmds[j];
+            bool before = (b->y < a->y) || (b->y == a->y && b->x < a->x);
+            if (!before || rects_overlap(a, b->x, b->y, b->w, b->h)) {
+                break;
+            }
+            DrawCommand t = *a;
+            *a = *b;
+            *b = t;
+        }
+    }
+}
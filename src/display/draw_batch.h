@@ -0,0 +1,51 @@
+#ifndef DRAW_BATCH_H
+#define DRAW_BATCH_H
+
+#include "config.h"
+#include <stdint.h>
+
+/**
+ * @brief One recorded fill (lines and outlines are recorded as fills)
+ */
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+    uint16_t color;
+} DrawCommand;
+
+/**
+ * @brief Command list for one frame
+ *
+ * Commands are coalesced as they are added: same-color rects that abut
+ * along a full edge merge into one, rects already inside an earlier
+ * same-color rect are dropped, and earlier rects completely covered by a
+ * new one are removed. Painter's order is preserved for every pair of
+ * commands that overlap.
+ */
+typedef struct {
+    DrawCommand cmds[DISPLAY_BATCH_MAX_CMDS];
+    int count;
+    uint32_t primitives;        // Commands added since the last clear
+} DrawBatch;
+
+/**
+ * @brief Empty the command list and reset the primitive counter
+ */
+void draw_batch_clear(DrawBatch* batch);
+
+/**
+ * @brief Record a fill, coalescing with earlier commands where possible
+ * @return false if the list is full (caller must flush and retry)
+ */
+bool draw_batch_add(DrawBatch* batch, int16_t x, int16_t y, int16_t w, int16_t h,
+                    uint16_t color);
+
+/**
+ * @brief Order commands by address window (row, then column)
+ * Overlapping commands keep their relative order.
+ */
+void draw_batch_sort(DrawBatch* batch);
+
+#endif // DRAW_BATCH_H
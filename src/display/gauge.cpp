@@ -1,38 +1,180 @@
 #include "gauge.h"
 #include "display.h"
-#include "../modes/modes.h"
+#include "color565.h"
+#include "glyph_cache.h"
+#include "gauge_widget.h"
+#include "text_format.h"
 
 #ifndef NATIVE_BUILD
 #include <Arduino.h>
 #endif
 
-// Check if a Y range overlaps with the debug overlay (only in debug mode)
-static bool overlaps_debug_region(int16_t y_start, int16_t height) {
-    if (mode_get_current() != OP_MODE_DEBUG) {
-        return false;
+// The two tank bars
+typedef Gauge<GAUGE_VERTICAL, GAUGE_SEGMENT_COUNT, GAUGE_SEGMENT_HEIGHT,
+              GAUGE_SEGMENT_GAP, GAUGE_WIDTH> TankGauge;
+
+static_assert(TankGauge::HEIGHT_PX == ScreenLayout::BAR_HEIGHT, "Bar height differs from the layout");
+
+// Percentage readout below the bar (border, then the layout's gap)
+#define GAUGE_PERCENT_DY      (TankGauge::HEIGHT_PX + ScreenLayout::PERCENT_GAP)
+
+// Levels on screen per gauge, with hysteresis (fill invalid = unknown, full redraw)
+static GaugeShown shown[2];
+static bool shown_ready = false;
+
+static int gauge_index(int tank_number) {
+    return (tank_number == 2) ? 1 : 0;
+}
+
+static GaugeShown* gauge_shown(int idx) {
+    if (!shown_ready) {
+        gauge_shown_init(&shown[0], TankGauge::FILL_PIXELS);
+        gauge_shown_init(&shown[1], TankGauge::FILL_PIXELS);
+        shown_ready = true;
     }
-    int16_t debug_y = debug_get_overlay_y();
-    int16_t debug_h = debug_get_overlay_height();
-    int16_t y_end = y_start + height;
-    int16_t debug_end = debug_y + debug_h;
-    
-    // Check if ranges overlap
-    return (y_start < debug_end && y_end > debug_y);
+    return &shown[idx];
 }
 
-// Get the static color for a segment based on its position (not fill level)
-// Bottom segments are red, middle are yellow, top are green
-static uint16_t get_segment_color(int segment_index) {
-    // segment_index 0 = bottom, GAUGE_SEGMENT_COUNT-1 = top
-    float segment_percent = ((float)segment_index / (float)GAUGE_SEGMENT_COUNT) * 100.0f;
-    
-    if (segment_percent < FUEL_THRESHOLD_RED) {
+// Color the lit red-zone rows of each gauge show (the low-fuel alert slot)
+static uint16_t red_slot[2] = {UI_COLOR_RED, UI_COLOR_RED};
+
+// Fill pixels from the bottom that are solid red in the zone table
+static int red_zone_pixels() {
+    static int pixels = -1;
+    if (pixels < 0) {
+        pixels = 0;
+        while (pixels < TankGauge::FILL_PIXELS && TankGauge::fill_color(pixels) == UI_COLOR_RED) {
+            pixels++;
+        }
+    }
+    return pixels;
+}
+
+// Repaint the lit red-zone pixels in [lo, hi) when the slot is not plain red
+static void paint_red_slot(int16_t x, int16_t y, int idx, int lo, int hi) {
+    if (red_slot[idx] == UI_COLOR_RED) {
+        return;
+    }
+    int red = red_zone_pixels();
+    TankGauge::fill_range(x, y, lo, (hi < red) ? hi : red, red_slot[idx]);
+}
+
+uint16_t gauge_get_zone_color(float position) {
+#if GAUGE_GRADIENT_ENABLE
+    // Solid red up to the red threshold, red->yellow across the yellow zone,
+    // yellow->green over the same span above
+    const float span = FUEL_THRESHOLD_YELLOW - FUEL_THRESHOLD_RED;
+    if (position <= FUEL_THRESHOLD_RED) {
+        return UI_COLOR_RED;
+    }
+    if (position <= FUEL_THRESHOLD_YELLOW) {
+        return color_blend_565(UI_COLOR_RED, UI_COLOR_YELLOW,
+                         (int)((position - FUEL_THRESHOLD_RED) / span * 256.0f + 0.5f));
+    }
+    if (position <= FUEL_THRESHOLD_YELLOW + span) {
+        return color_blend_565(UI_COLOR_YELLOW, UI_COLOR_GREEN,
+                         (int)((position - FUEL_THRESHOLD_YELLOW) / span * 256.0f + 0.5f));
+    }
+    return UI_COLOR_GREEN;
+#else
+    // Bottom segments are red, middle are yellow, top are green
+    if (position < FUEL_THRESHOLD_RED) {
         return UI_COLOR_RED;
-    } else if (segment_percent < FUEL_THRESHOLD_YELLOW) {
+    } else if (position < FUEL_THRESHOLD_YELLOW) {
         return UI_COLOR_YELLOW;
     } else {
         return UI_COLOR_GREEN;
     }
+#endif
+}
+
+// ============================================================================
+// Display hysteresis
+// ============================================================================
+
+static float clamp_percent(float percent) {
+    if (percent < 0.0f) return 0.0f;
+    if (percent > 100.0f) return 100.0f;
+    return percent;
+}
+
+void gauge_shown_init(GaugeShown* s, int fill_levels) {
+    // Each value in its own units, with MIN_CHANGE_PERCENT converted to them
+    s->fill_levels = fill_levels;
+    shown_value_init(&s->fill, 1.0f, MIN_CHANGE_PERCENT / 100.0f * fill_levels);
+    shown_value_init(&s->gallons, 1.0f, MIN_CHANGE_PERCENT / 100.0f * TANK_CAPACITY_GALLONS);
+    shown_value_init(&s->percent, 1.0f, MIN_CHANGE_PERCENT);
+}
+
+void gauge_shown_set(GaugeShown* s, int fill, float percent) {
+    percent = clamp_percent(percent);
+    shown_value_set(&s->fill, fill);
+    shown_value_set(&s->gallons, shown_value_round(percent / 100.0f * TANK_CAPACITY_GALLONS, 1.0f));
+    shown_value_set(&s->percent, shown_value_round(percent, 1.0f));
+}
+
+uint8_t gauge_shown_update(GaugeShown* s, float percent) {
+    percent = clamp_percent(percent);
+    uint8_t changed = 0;
+    if (shown_value_update(&s->fill, percent / 100.0f * s->fill_levels)) changed |= GAUGE_SHOWN_FILL;
+    if (shown_value_update(&s->gallons, percent / 100.0f * TANK_CAPACITY_GALLONS)) changed |= GAUGE_SHOWN_GALLONS;
+    if (shown_value_update(&s->percent, percent)) changed |= GAUGE_SHOWN_PERCENT;
+    return changed;
+}
+
+uint16_t gauge_get_row_color(int pixel) {
+    return TankGauge::fill_color(pixel);
+}
+
+#if GLYPH_CACHE_ENABLE
+// Pre-rendered readout glyphs and the on-screen state of each readout field
+#define GAUGE_READOUTS        4       // Gallons and percent for two gauges
+static GlyphCache glyph_cache = {0, 0, 0, nullptr};
+static bool glyph_cache_ready = false;
+static GlyphText readouts[GAUGE_READOUTS];
+static int readout_count = 0;
+
+// Readout state for the field at (x, y), claiming a free slot if new
+static GlyphText* readout_at(int16_t x, int16_t y) {
+    for (int i = 0; i < readout_count; i++) {
+        if (readouts[i].x == x && readouts[i].y == y) {
+            return &readouts[i];
+        }
+    }
+    if (readout_count >= GAUGE_READOUTS) {
+        return nullptr;
+    }
+    GlyphText* r = &readouts[readout_count++];
+    r->x = x;
+    r->y = y;
+    r->valid = false;
+    return r;
+}
+
+// Draw a readout string from the glyph cache; false = draw it the slow way
+static bool gauge_text_cached(int16_t x, int16_t y, int16_t text_x, const char* text) {
+    if (!glyph_cache_ready) {
+        glyph_cache_ready = glyph_cache_init(&glyph_cache, &glyph_font_glcd, 2,
+                                             UI_COLOR_TEXT, UI_COLOR_BACKGROUND);
+        if (!glyph_cache_ready) {
+            return false;
+        }
+    }
+    GlyphText* r = readout_at(x, y);
+    return r && glyph_text_draw(&glyph_cache, r, x, y, GAUGE_WIDTH, text_x, text);
+}
+#endif
+
+void gauge_readout_invalidate(int16_t x, int16_t y) {
+#if GLYPH_CACHE_ENABLE
+    GlyphText* r = readout_at(x, y);
+    if (r) {
+        glyph_text_invalidate(r);
+    }
+#else
+    (void)x;
+    (void)y;
+#endif
 }
 
 uint16_t gauge_get_color_for_percent(float percent) {
@@ -48,6 +190,10 @@ uint16_t gauge_get_color_for_percent(float percent) {
     }
 }
 
+int gauge_get_fill_pixels(float percent) {
+    return TankGauge::fill_pixels(percent);
+}
+
 int gauge_get_filled_segments(float percent) {
     if (percent < 0.0f) percent = 0.0f;
     if (percent > 100.0f) percent = 100.0f;
@@ -78,6 +224,20 @@ void gauge_draw_gallons(int16_t x, int16_t y, float percent) {
     if (gallons > TANK_CAPACITY_GALLONS) gallons = TANK_CAPACITY_GALLONS;
     if (gallons < 0) gallons = 0;
     
+    // Format gallon string: "XXG" (compact to fit)
+    char buf[8];
+    int len = text_format_int(buf, sizeof(buf), gallons, 2, ' ', TEXT_ALIGN_RIGHT);
+    text_append(buf, sizeof(buf), len, "G");
+    
+    // Center text (size 2)
+    int16_t text_x = x + (GAUGE_WIDTH - display_get_text_width(buf, 2)) / 2;
+    
+#if GLYPH_CACHE_ENABLE
+    if (gauge_text_cached(x, y, text_x, buf)) {
+        return;
+    }
+#endif
+    
     // Clear area for text - smaller size to avoid overlap
     int16_t text_height = 16;  // Size 2 font height
     display_fill_rect(x, y, GAUGE_WIDTH, text_height, UI_COLOR_BACKGROUND);
@@ -85,25 +245,6 @@ void gauge_draw_gallons(int16_t x, int16_t y, float percent) {
     // Use size 2 for gallons display
     display_set_text_size(2);
     display_set_text_color(UI_COLOR_TEXT);
-    
-    // Format gallon string: "XXG" (compact to fit)
-    char buf[8];
-    int idx = 0;
-    
-    if (gallons >= 10) {
-        buf[idx++] = '0' + (gallons / 10);
-        buf[idx++] = '0' + (gallons % 10);
-    } else {
-        buf[idx++] = ' ';
-        buf[idx++] = '0' + gallons;
-    }
-    buf[idx++] = 'G';
-    buf[idx] = '\0';
-    
-    // Center text: 3 chars * 12 pixels (size 2) = 36 pixels
-    int16_t text_width = 3 * 12;
-    int16_t text_x = x + (GAUGE_WIDTH - text_width) / 2;
-    
     display_set_cursor(text_x, y);
     display_print(buf);
 }
@@ -115,218 +256,206 @@ void gauge_draw_percentage(int16_t x, int16_t y, float percent) {
     int pct_int = (int)(percent + 0.5f);
     if (pct_int > 100) pct_int = 100;
     
-    // Clear area for text
-    int16_t text_height = 16;
-    display_fill_rect(x, y, GAUGE_WIDTH, text_height, UI_COLOR_BACKGROUND);
-    
-    display_set_text_size(2);
-    display_set_text_color(UI_COLOR_TEXT);
-    
     // Format: "XX%" or "100%"
     char buf[8];
-    int idx = 0;
+    int len = text_format_int(buf, sizeof(buf), pct_int, 2, ' ', TEXT_ALIGN_RIGHT);
+    text_append(buf, sizeof(buf), len, "%");
     
-    if (pct_int >= 100) {
-        buf[idx++] = '1';
-        buf[idx++] = '0';
-        buf[idx++] = '0';
-    } else if (pct_int >= 10) {
-        buf[idx++] = '0' + (pct_int / 10);
-        buf[idx++] = '0' + (pct_int % 10);
-    } else {
-        buf[idx++] = ' ';
-        buf[idx++] = '0' + pct_int;
+    // Center text
+    int16_t text_x = x + (GAUGE_WIDTH - display_get_text_width(buf, 2)) / 2;
+    
+#if GLYPH_CACHE_ENABLE
+    if (gauge_text_cached(x, y, text_x, buf)) {
+        return;
     }
-    buf[idx++] = '%';
-    buf[idx] = '\0';
+#endif
     
-    // Center text
-    int num_chars = (pct_int >= 100) ? 4 : 3;
-    int16_t text_width = num_chars * 12;
-    int16_t text_x = x + (GAUGE_WIDTH - text_width) / 2;
+    // Clear area for text
+    int16_t text_height = 16;
+    display_fill_rect(x, y, GAUGE_WIDTH, text_height, UI_COLOR_BACKGROUND);
     
+    display_set_text_size(2);
+    display_set_text_color(UI_COLOR_TEXT);
     display_set_cursor(text_x, y);
     display_print(buf);
 }
 
 void gauge_redraw_bar(int16_t x, int16_t y, float percent) {
-    if (percent < 0.0f) percent = 0.0f;
-    if (percent > 100.0f) percent = 100.0f;
-    
-    // Internal padding between border and segments (all sides)
-    const int BORDER_PADDING = 1;
-    
-    // Segment drawing area (inside the padding)
-    int16_t seg_draw_x = x + BORDER_PADDING;
-    int16_t seg_draw_width = GAUGE_WIDTH - (BORDER_PADDING * 2);
-    
-    // Calculate total segment area dimensions (segments + gaps between them)
-    int segment_area_height = GAUGE_SEGMENT_COUNT * (GAUGE_SEGMENT_HEIGHT + GAUGE_SEGMENT_GAP) - GAUGE_SEGMENT_GAP;
-    
-    // Total bar height including internal padding on top and bottom
-    int total_bar_height = segment_area_height + (BORDER_PADDING * 2);
-    
-    // Border is 1 pixel outside the bar area
-    int16_t border_top = y - 1;
-    int16_t border_bottom = y + total_bar_height;
-    int16_t border_left = x - 1;
-    int16_t border_right = x + GAUGE_WIDTH;
-    
-    // Draw gauge frame (skip parts that overlap debug region)
-    // Top border line
-    if (!overlaps_debug_region(border_top, 1)) {
-        display_draw_hline(border_left, border_top, GAUGE_WIDTH + 2, UI_COLOR_BORDER);
-    }
-    // Bottom border line
-    if (!overlaps_debug_region(border_bottom, 1)) {
-        display_draw_hline(border_left, border_bottom, GAUGE_WIDTH + 2, UI_COLOR_BORDER);
-    }
-    // Left and right borders - draw pixel by pixel to avoid debug region
-    for (int16_t by = border_top; by <= border_bottom; by++) {
-        if (!overlaps_debug_region(by, 1)) {
-            display_fill_rect(border_left, by, 1, 1, UI_COLOR_BORDER);   // Left
-            display_fill_rect(border_right, by, 1, 1, UI_COLOR_BORDER);  // Right
-        }
-    }
-    
-    // Clear the internal padding area (between border and segments)
-    // Top padding (full width inside border)
-    if (!overlaps_debug_region(y, BORDER_PADDING)) {
-        display_fill_rect(x, y, GAUGE_WIDTH, BORDER_PADDING, UI_COLOR_BACKGROUND);
-    }
-    // Bottom padding (full width inside border)
-    int16_t bottom_pad_y = y + BORDER_PADDING + segment_area_height;
-    if (!overlaps_debug_region(bottom_pad_y, BORDER_PADDING)) {
-        display_fill_rect(x, bottom_pad_y, GAUGE_WIDTH, BORDER_PADDING, UI_COLOR_BACKGROUND);
-    }
-    // Left padding (between left border and segments, full height of segment area)
-    for (int16_t py = y + BORDER_PADDING; py < y + BORDER_PADDING + segment_area_height; py++) {
-        if (!overlaps_debug_region(py, 1)) {
-            display_fill_rect(x, py, BORDER_PADDING, 1, UI_COLOR_BACKGROUND);
-        }
-    }
-    // Right padding (between segments and right border, full height of segment area)
-    for (int16_t py = y + BORDER_PADDING; py < y + BORDER_PADDING + segment_area_height; py++) {
-        if (!overlaps_debug_region(py, 1)) {
-            display_fill_rect(x + GAUGE_WIDTH - BORDER_PADDING, py, BORDER_PADDING, 1, UI_COLOR_BACKGROUND);
-        }
-    }
-    
-    // Segments start after the top padding
-    int16_t segment_start_y = y + BORDER_PADDING;
-    
-    // Calculate pixel-level fill
-    // Total fillable pixels (excluding gaps)
-    int total_fill_pixels = GAUGE_SEGMENT_COUNT * GAUGE_SEGMENT_HEIGHT;
-    int filled_pixels = (int)((percent / 100.0f) * total_fill_pixels + 0.5f);
-    if (filled_pixels > total_fill_pixels) filled_pixels = total_fill_pixels;
-    if (filled_pixels < 0) filled_pixels = 0;
-    
-    int pixels_remaining = filled_pixels;
-    
-    // Draw each segment from bottom (segment 0) to top
-    for (int seg = 0; seg < GAUGE_SEGMENT_COUNT; seg++) {
-        // Calculate Y position for this segment (bottom-up)
-        int segment_from_top = GAUGE_SEGMENT_COUNT - 1 - seg;
-        int16_t seg_y = segment_start_y + (segment_from_top * (GAUGE_SEGMENT_HEIGHT + GAUGE_SEGMENT_GAP));
-        
-        // Skip segments that overlap with debug region in debug mode
-        if (overlaps_debug_region(seg_y, GAUGE_SEGMENT_HEIGHT)) {
-            if (pixels_remaining >= GAUGE_SEGMENT_HEIGHT) {
-                pixels_remaining -= GAUGE_SEGMENT_HEIGHT;
-            } else {
-                pixels_remaining = 0;
-            }
-            continue;
-        }
-        
-        // Get the static color for this segment position
-        uint16_t seg_color = get_segment_color(seg);
-        
-        if (pixels_remaining >= GAUGE_SEGMENT_HEIGHT) {
-            // Fully filled segment
-            display_fill_rect(seg_draw_x, seg_y, seg_draw_width, GAUGE_SEGMENT_HEIGHT, seg_color);
-            pixels_remaining -= GAUGE_SEGMENT_HEIGHT;
-        } else if (pixels_remaining > 0) {
-            // Partially filled segment - fill from bottom
-            int filled_in_seg = pixels_remaining;
-            int empty_in_seg = GAUGE_SEGMENT_HEIGHT - filled_in_seg;
-            
-            // Empty part (top of segment)
-            if (empty_in_seg > 0) {
-                display_fill_rect(seg_draw_x, seg_y, seg_draw_width, empty_in_seg, UI_COLOR_EMPTY);
-            }
-            // Filled part (bottom of segment)
-            if (filled_in_seg > 0) {
-                display_fill_rect(seg_draw_x, seg_y + empty_in_seg, seg_draw_width, filled_in_seg, seg_color);
-            }
-            
-            pixels_remaining = 0;
-        } else {
-            // Empty segment
-            display_fill_rect(seg_draw_x, seg_y, seg_draw_width, GAUGE_SEGMENT_HEIGHT, UI_COLOR_EMPTY);
-        }
+    TankGauge::draw(x, y, percent);
+}
+
+void gauge_update_bar_rows(int16_t x, int16_t y, int old_pixels, int new_pixels) {
+    TankGauge::update(x, y, old_pixels, new_pixels);
+}
+
+void gauge_build_row_colors(float percent, uint16_t* rows) {
+    TankGauge::build_lines(percent, rows);
+}
+
+void gauge_stream_bar(int16_t x, int16_t y, float percent) {
+    TankGauge::stream(x, y, percent);
+}
+
+// Draw one text readout so it reaches the panel as one transfer (the glyph
+// cache already sends one window; otherwise compose it on the canvas)
+static void gauge_draw_text(void (*draw)(int16_t, int16_t, float), int16_t x, int16_t y, float percent) {
+#if GAUGE_SPRITE_ENABLE && !GLYPH_CACHE_ENABLE
+    bool composed = display_canvas_begin(x, y, GAUGE_WIDTH, 16);
+#else
+    bool composed = false;
+#endif
+    draw(x, y, percent);
+    if (composed) {
+        display_canvas_end();
     }
 }
 
+// Compose the whole gauge column (gallons, bar, percentage) off-screen so it
+// reaches the panel as one DMA transfer instead of hundreds of small writes
+static bool gauge_canvas_begin(int16_t x, int16_t y) {
+#if GAUGE_SPRITE_ENABLE
+    ClipRect r = gauge_bounds(x, y);
+    return display_canvas_begin(r.x, r.y, r.w, r.h);
+#else
+    (void)x;
+    (void)y;
+    return false;
+#endif
+}
+
+ClipRect gauge_bounds(int16_t x, int16_t y) {
+    // From the gallons text (y - 18) to the bottom of the percentage text
+    ClipRect r = {(int16_t)(x - 1), (int16_t)(y - LAYOUT_LABEL_ROWS), (int16_t)(GAUGE_WIDTH + 2),
+                  (int16_t)ScreenLayout::GAUGE_ROWS};
+    return r;
+}
+
 void gauge_draw(int16_t x, int16_t y, float percent, int tank_number) {
-    (void)tank_number;
-    
     // y is top of the bar area (inside the border)
     // Layout: [Gallons text] [Border + padding + Bar + padding + Border] [Percentage text]
     
-    const int BORDER_PADDING = 1;
-    int segment_area_height = GAUGE_SEGMENT_COUNT * (GAUGE_SEGMENT_HEIGHT + GAUGE_SEGMENT_GAP) - GAUGE_SEGMENT_GAP;
-    int total_bar_height = segment_area_height + (BORDER_PADDING * 2);
+    int16_t pct_y = y + GAUGE_PERCENT_DY;
     
-    // Draw gallons ABOVE the bar (skip if overlaps debug region)
+    // Both readout fields are repainted in full below
+    gauge_readout_invalidate(x, y - 18);
+    gauge_readout_invalidate(x, pct_y);
+    
+    bool composed = gauge_canvas_begin(x, y);
+    
+    // Draw gallons ABOVE the bar
     // Gallons text ends 2 pixels above the border (border is at y-1)
-    if (!overlaps_debug_region(y - 18, 16)) {
-        gauge_draw_gallons(x, y - 18, percent);
-    }
+    gauge_draw_gallons(x, y - 18, percent);
     
-    // Draw the bar gauge (handles debug region internally)
+    // Draw the bar gauge. Without a
+    // canvas, stream the segment area instead of issuing a fill per segment
+#if GAUGE_BAR_STREAM_ENABLE
+    if (composed) {
+        gauge_redraw_bar(x, y, percent);
+    } else {
+        gauge_stream_bar(x, y, percent);
+    }
+#else
     gauge_redraw_bar(x, y, percent);
-    
-    // Draw percentage BELOW the bar (skip if overlaps debug region)
-    // Border bottom is at y + total_bar_height, text starts 6 pixels below for more spacing
-    int16_t pct_y = y + total_bar_height + 6;
-    if (!overlaps_debug_region(pct_y, 16)) {
-        gauge_draw_percentage(x, pct_y, percent);
+#endif
+    int idx = gauge_index(tank_number);
+    int fill = gauge_get_fill_pixels(percent);
+    gauge_shown_set(gauge_shown(idx), fill, percent);
+    paint_red_slot(x, y, idx, 0, fill);
+    
+    // Draw percentage BELOW the bar
+    // Border bottom is at y + HEIGHT_PX, text starts the layout's gap below
+    gauge_draw_percentage(x, pct_y, percent);
+    
+    // Regions on the clip stack (the debug overlay) stay untouched on the panel
+    if (composed) {
+        display_canvas_end();
     }
 }
 
+void gauge_draw_background(int16_t x, int16_t y) {
+    TankGauge::draw(x, y, 0.0f);
+}
+
+void gauge_draw_over_background(int16_t x, int16_t y, float percent, int tank_number) {
+    int16_t pct_y = y + GAUGE_PERCENT_DY;
+    gauge_readout_invalidate(x, y - 18);
+    gauge_readout_invalidate(x, pct_y);
+    gauge_draw_gallons(x, y - 18, percent);
+    
+    // The background shows the bar empty: only the lit rows are new
+    int idx = gauge_index(tank_number);
+    int fill = gauge_get_fill_pixels(percent);
+    gauge_update_bar_rows(x, y, 0, fill);
+    paint_red_slot(x, y, idx, 0, fill);
+    gauge_shown_set(gauge_shown(idx), fill, percent);
+    
+    gauge_draw_percentage(x, pct_y, percent);
+}
+
 bool gauge_update_if_changed(int16_t x, int16_t y, float old_percent, 
                               float new_percent, int tank_number) {
-    (void)tank_number;
+    int idx = gauge_index(tank_number);
+    GaugeShown* shown_levels = gauge_shown(idx);
+    if (!shown_levels->fill.valid) {
+        // Bar state unknown - redraw the whole gauge if anything differs
+        int old_pct = (int)(old_percent + 0.5f);
+        int new_pct = (int)(new_percent + 0.5f);
+        int old_gallons = (int)((old_percent / 100.0f) * TANK_CAPACITY_GALLONS + 0.5f);
+        int new_gallons = (int)((new_percent / 100.0f) * TANK_CAPACITY_GALLONS + 0.5f);
+        if (gauge_get_fill_pixels(old_percent) == gauge_get_fill_pixels(new_percent) &&
+            old_gallons == new_gallons && old_pct == new_pct) {
+            return false;
+        }
+        gauge_draw(x, y, new_percent, tank_number);
+        return true;
+    }
     
-    // Calculate pixel-level fill for both
-    int total_fill_pixels = GAUGE_SEGMENT_COUNT * GAUGE_SEGMENT_HEIGHT;
-    int old_pixels = (int)((old_percent / 100.0f) * total_fill_pixels + 0.5f);
-    int new_pixels = (int)((new_percent / 100.0f) * total_fill_pixels + 0.5f);
+    // Each shown value moves only once the level is past its hysteresis band
+    int old_pixels = shown_levels->fill.level;
+    uint8_t changed = gauge_shown_update(shown_levels, new_percent);
+    if (changed == 0) {
+        return false;
+    }
     
-    // Check if displayed gallon value changed
-    int old_gallons = (int)((old_percent / 100.0f) * TANK_CAPACITY_GALLONS + 0.5f);
-    int new_gallons = (int)((new_percent / 100.0f) * TANK_CAPACITY_GALLONS + 0.5f);
+    // Repaint only the rows between the last drawn and the new fill level
+    if (changed & GAUGE_SHOWN_FILL) {
+        int new_pixels = shown_levels->fill.level;
+        gauge_update_bar_rows(x, y, old_pixels, new_pixels);
+        paint_red_slot(x, y, idx, old_pixels, new_pixels);
+    }
     
-    // Check if displayed percentage changed
-    int old_pct = (int)(old_percent + 0.5f);
-    int new_pct = (int)(new_percent + 0.5f);
+    // Update gallon display ABOVE bar
+    if (changed & GAUGE_SHOWN_GALLONS) {
+        gauge_draw_text(gauge_draw_gallons, x, y - 18, new_percent);
+    }
     
-    if (old_pixels != new_pixels || old_gallons != new_gallons || old_pct != new_pct) {
-        gauge_redraw_bar(x, y, new_percent);
-        
-        // Update gallon display ABOVE bar
-        gauge_draw_gallons(x, y - 18, new_percent);
-        
-        // Update percentage display BELOW bar
-        const int BORDER_PADDING = 1;
-        int segment_area_height = GAUGE_SEGMENT_COUNT * (GAUGE_SEGMENT_HEIGHT + GAUGE_SEGMENT_GAP) - GAUGE_SEGMENT_GAP;
-        int total_bar_height = segment_area_height + (BORDER_PADDING * 2);
-        gauge_draw_percentage(x, y + total_bar_height + 6, new_percent);
-        
-        return true;
+    // Update percentage display BELOW bar
+    if (changed & GAUGE_SHOWN_PERCENT) {
+        gauge_draw_text(gauge_draw_percentage, x, y + GAUGE_PERCENT_DY, new_percent);
     }
     
-    return false;
+    return true;
+}
+
+bool gauge_set_alert_color(int16_t x, int16_t y, int tank_number, uint16_t color) {
+    int idx = gauge_index(tank_number);
+    if (red_slot[idx] == color) {
+        return false;
+    }
+    red_slot[idx] = color;
+    
+    // Nothing on screen yet: the next full draw uses the slot
+    const ShownValue* fill = &gauge_shown(idx)->fill;
+    int lit = fill->valid ? fill->level : 0;
+    int red = red_zone_pixels();
+    if (lit > red) lit = red;
+    if (lit <= 0) {
+        return false;
+    }
+    TankGauge::fill_range(x, y, 0, lit, color);
+    return true;
+}
+
+void gauge_invalidate(int tank_number) {
+    shown_value_invalidate(&gauge_shown(gauge_index(tank_number))->fill);
 }
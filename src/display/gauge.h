@@ -2,8 +2,14 @@
 #define GAUGE_H
 
 #include "config.h"
+#include "clip_region.h"
+#include "layout.h"
+#include "shown_value.h"
 #include <stdint.h>
 
+// Rows in the bar's segment area (segments plus the gaps between them)
+#define GAUGE_BAR_ROWS        (GAUGE_SEGMENT_COUNT * (GAUGE_SEGMENT_HEIGHT + GAUGE_SEGMENT_GAP) - GAUGE_SEGMENT_GAP)
+
 /**
  * @brief Get the RGB565 color for a given fuel percentage
  * @param percent Fuel percentage (0-100)
@@ -11,6 +17,31 @@
  */
 uint16_t gauge_get_color_for_percent(float percent);
 
+/**
+ * @brief Zone color at a position along a bar
+ * Discrete zones by default (red below the red threshold, yellow below the
+ * yellow threshold, green above); the smooth blend with GAUGE_GRADIENT_ENABLE.
+ * @param position Position from the empty end (0-100%)
+ * @return RGB565 color
+ */
+uint16_t gauge_get_zone_color(float position);
+
+/**
+ * @brief Number of bar pixel rows filled for a given percentage
+ * @param percent Fuel percentage (0-100)
+ * @return Filled rows (0 to GAUGE_SEGMENT_COUNT * GAUGE_SEGMENT_HEIGHT), gaps excluded
+ */
+int gauge_get_fill_pixels(float percent);
+
+/**
+ * @brief Zone color of one bar fill row, read from a table built once
+ * Discrete zones by default; a smooth red->yellow->green blend with
+ * GAUGE_GRADIENT_ENABLE.
+ * @param pixel Fill row counted from the bottom (0 to GAUGE_SEGMENT_COUNT * GAUGE_SEGMENT_HEIGHT - 1)
+ * @return RGB565 color (UI_COLOR_EMPTY if out of range)
+ */
+uint16_t gauge_get_row_color(int pixel);
+
 /**
  * @brief Calculate how many segments to fill for a given percentage
  * @param percent Fuel percentage (0-100)
@@ -20,6 +51,8 @@ int gauge_get_filled_segments(float percent);
 
 /**
  * @brief Draw a complete fuel gauge bar
+ * With GAUGE_SPRITE_ENABLE the gauge is composed off-screen and pushed
+ * in a single DMA transfer.
  * @param x X position of gauge left edge
  * @param y Y position of gauge top edge
  * @param percent Current fuel percentage (0-100)
@@ -27,6 +60,34 @@ int gauge_get_filled_segments(float percent);
  */
 void gauge_draw(int16_t x, int16_t y, float percent, int tank_number);
 
+/**
+ * @brief Screen area a gauge paints: gallons readout, border, bar and
+ *        percentage readout
+ * @param x X position of gauge left edge
+ * @param y Y position of gauge top edge
+ */
+ClipRect gauge_bounds(int16_t x, int16_t y);
+
+/**
+ * @brief Draw the static part of a gauge: border, padding and an empty bar
+ * This is the gauge's share of a cached page background (page_compositor.h).
+ * @param x X position of gauge left edge
+ * @param y Y position of gauge top edge
+ */
+void gauge_draw_background(int16_t x, int16_t y);
+
+/**
+ * @brief Draw a gauge's dynamic content over its background
+ * Paints the lit rows and both readouts, assuming the screen shows
+ * gauge_draw_background() at (x, y). Afterwards the gauge updates
+ * incrementally as if gauge_draw() had been called.
+ * @param x X position of gauge left edge
+ * @param y Y position of gauge top edge
+ * @param percent Current fuel percentage (0-100)
+ * @param tank_number Tank identifier (1 or 2)
+ */
+void gauge_draw_over_background(int16_t x, int16_t y, float percent, int tank_number);
+
 /**
  * @brief Draw the tank label above the gauge
  * @param x X position of gauge left edge
@@ -35,6 +96,14 @@ void gauge_draw(int16_t x, int16_t y, float percent, int tank_number);
  */
 void gauge_draw_label(int16_t x, int16_t y, int tank_number);
 
+/**
+ * @brief Draw the gallons readout above the gauge
+ * @param x X position of gauge left edge
+ * @param y Y position (above gauge)
+ * @param percent Current fuel percentage (0-100)
+ */
+void gauge_draw_gallons(int16_t x, int16_t y, float percent);
+
 /**
  * @brief Draw the percentage readout below the gauge
  * @param x X position of gauge left edge
@@ -43,11 +112,56 @@ void gauge_draw_label(int16_t x, int16_t y, int tank_number);
  */
 void gauge_draw_percentage(int16_t x, int16_t y, float percent);
 
+// Flags returned by gauge_shown_update()
+#define GAUGE_SHOWN_FILL      0x01    // Bar pixels / dial steps
+#define GAUGE_SHOWN_GALLONS   0x02    // Gallons readout
+#define GAUGE_SHOWN_PERCENT   0x04    // Percentage readout
+
+/**
+ * @brief Levels one gauge shows, each with display hysteresis
+ * Each level follows the fuel level while it keeps moving one way; turning
+ * back needs the fuel level to pass the rounding boundary by
+ * MIN_CHANGE_PERCENT, so a level sitting on a boundary does not make the
+ * bar or the readouts flicker.
+ */
+typedef struct {
+    ShownValue fill;                    // Bar fill pixels or dial steps
+    ShownValue gallons;                 // Whole gallons
+    ShownValue percent;                 // Whole percent
+    int fill_levels;                    // Fill resolution
+} GaugeShown;
+
 /**
- * @brief Update gauge display only if value changed significantly
+ * @brief Set up the levels of a gauge with nothing shown
+ * @param shown Gauge levels
+ * @param fill_levels Fill resolution (bar fill pixels or dial steps)
+ */
+void gauge_shown_init(GaugeShown* shown, int fill_levels);
+
+/**
+ * @brief Record a full redraw at a fuel level (plain rounding)
+ * @param shown Gauge levels
+ * @param fill Fill level drawn
+ * @param percent Fuel percentage drawn
+ */
+void gauge_shown_set(GaugeShown* shown, int fill, float percent);
+
+/**
+ * @brief Feed a new fuel level through the hysteresis of each shown value
+ * @return GAUGE_SHOWN_* flags of the values that changed (0 = nothing to draw)
+ */
+uint8_t gauge_shown_update(GaugeShown* shown, float percent);
+
+/**
+ * @brief Update gauge display only if a shown value changed
+ * The bar is updated incrementally: only the rows between the last drawn
+ * fill level and the new one are repainted. The fill level and both text
+ * readouts each change only when their display hysteresis lets them (see
+ * GaugeShown).
  * @param x X position of gauge left edge
  * @param y Y position of gauge top edge
- * @param old_percent Previous percentage value
+ * @param old_percent Previous percentage value (the gauge tracks what it
+ *        shows itself; kept for callers that switch widgets)
  * @param new_percent New percentage value
  * @param tank_number Tank identifier (1 or 2)
  * @return true if gauge was redrawn, false if no change needed
@@ -63,4 +177,63 @@ bool gauge_update_if_changed(int16_t x, int16_t y, float old_percent,
  */
 void gauge_redraw_bar(int16_t x, int16_t y, float percent);
 
+/**
+ * @brief Repaint only the bar rows between two fill levels
+ * Rows turning on take their segment's zone color, rows turning off the
+ * empty color. Segment gaps, border and padding are not touched.
+ * @param x X position of gauge left edge
+ * @param y Y position of gauge top edge
+ * @param old_pixels Fill level currently on screen (gauge_get_fill_pixels)
+ * @param new_pixels Fill level to show
+ */
+void gauge_update_bar_rows(int16_t x, int16_t y, int old_pixels, int new_pixels);
+
+/**
+ * @brief Build the per-row color vector of the bar's segment area
+ * Every row inside the padding is a single color: its segment's zone
+ * color, the empty color, or background for gap rows.
+ * @param percent Fuel percentage (0-100)
+ * @param rows Output: GAUGE_BAR_ROWS colors, top row first
+ */
+void gauge_build_row_colors(float percent, uint16_t* rows);
+
+/**
+ * @brief Repaint the whole bar with the segment area streamed as one window
+ * Draws the border and padding as a few fills, then pushes the row-color
+ * vector through a single address window. Same pixels as
+ * gauge_redraw_bar() without an off-screen buffer.
+ * @param x X position of gauge left edge
+ * @param y Y position of gauge top edge
+ * @param percent Current fuel percentage (0-100)
+ */
+void gauge_stream_bar(int16_t x, int16_t y, float percent);
+
+/**
+ * @brief Forget what a readout field shows (its area is about to be repainted)
+ * The next gauge_draw_gallons() / gauge_draw_percentage() at (x, y) then
+ * repaints the whole field.
+ * @param x Field X position (as passed to the readout draw)
+ * @param y Field Y position
+ */
+void gauge_readout_invalidate(int16_t x, int16_t y);
+
+/**
+ * @brief Set the color of a gauge's lit red-zone rows (low-fuel alert)
+ * Every lit row in the red zone shows this one slot color. Changing it
+ * repaints just those rows, one rect per segment; the rest of the bar is
+ * not touched. Later full draws and level updates keep using the slot.
+ * @param x X position of gauge left edge
+ * @param y Y position of gauge top edge
+ * @param tank_number Tank identifier (1 or 2)
+ * @param color Slot color (UI_COLOR_RED = no alert)
+ * @return true if pixels were sent
+ */
+bool gauge_set_alert_color(int16_t x, int16_t y, int tank_number, uint16_t color);
+
+/**
+ * @brief Forget the drawn state of a gauge so the next update redraws fully
+ * @param tank_number Tank identifier (1 or 2)
+ */
+void gauge_invalidate(int tank_number);
+
 #endif // GAUGE_H
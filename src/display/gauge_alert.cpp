@@ -0,0 +1,40 @@
+#include "gauge_alert.h"
+#include "color565.h"
+
+void gauge_alert_init(GaugeAlert* alert) {
+    alert->active = false;
+    alert->start_ms = 0;
+}
+
+bool gauge_alert_update(GaugeAlert* alert, float percent, uint32_t now_ms) {
+    if (!alert->active && percent < LOW_FUEL_ALERT_PERCENT) {
+        alert->active = true;
+        alert->start_ms = now_ms;
+    } else if (alert->active && percent > LOW_FUEL_ALERT_CLEAR) {
+        alert->active = false;
+    }
+    return alert->active;
+}
+
+uint16_t gauge_alert_effect_color(int effect, uint32_t elapsed_ms) {
+    if (effect == LOW_FUEL_EFFECT_PULSE) {
+        // Triangle wave over the period, quantized to whole steps
+        uint32_t t = elapsed_ms % LOW_FUEL_PULSE_MS;
+        int step = (int)(t * (2 * LOW_FUEL_PULSE_STEPS) / LOW_FUEL_PULSE_MS);
+        int level = (step <= LOW_FUEL_PULSE_STEPS) ? step : 2 * LOW_FUEL_PULSE_STEPS - step;
+        return color_blend_565(UI_COLOR_RED, UI_COLOR_EMPTY, level * 256 / LOW_FUEL_PULSE_STEPS);
+    }
+    
+    bool off_phase = ((elapsed_ms / LOW_FUEL_BLINK_MS) & 1) != 0;
+    if (!off_phase) {
+        return UI_COLOR_RED;
+    }
+    return (effect == LOW_FUEL_EFFECT_INVERT) ? (uint16_t)(UI_COLOR_RED ^ 0xFFFF) : UI_COLOR_EMPTY;
+}
+
+uint16_t gauge_alert_color(const GaugeAlert* alert, uint32_t now_ms) {
+    if (!alert->active) {
+        return UI_COLOR_RED;
+    }
+    return gauge_alert_effect_color(LOW_FUEL_ALERT_EFFECT, now_ms - alert->start_ms);
+}
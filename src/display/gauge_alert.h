@@ -0,0 +1,58 @@
+#ifndef GAUGE_ALERT_H
+#define GAUGE_ALERT_H
+
+/*******************************************************************************
+ * Low-fuel alert effects
+ *
+ * The bar is treated as indexed color: every lit row in the red zone shows
+ * one palette slot. An alert animates that slot (blink, pulse, inversion)
+ * and gauge_set_alert_color() repaints only the rows that use it, so a toggle
+ * costs at most the red zone's pixels however often it runs.
+ *
+ * This module only decides the slot color over time; it draws nothing.
+ ******************************************************************************/
+
+#include "config.h"
+#include <stdint.h>
+
+/**
+ * @brief Alert state for one tank
+ */
+typedef struct {
+    bool active;                        // Level is in the alert band
+    uint32_t start_ms;                  // When the alert started (effect phase 0)
+} GaugeAlert;
+
+/**
+ * @brief Start with no alert
+ */
+void gauge_alert_init(GaugeAlert* alert);
+
+/**
+ * @brief Arm or clear the alert from the shown level
+ * Starts below LOW_FUEL_ALERT_PERCENT and ends above LOW_FUEL_ALERT_CLEAR,
+ * so a level hovering at the threshold does not flicker the alert on and off.
+ * @param alert Alert state
+ * @param percent Level on screen (0-100)
+ * @param now_ms Current time
+ * @return true while the alert is active
+ */
+bool gauge_alert_update(GaugeAlert* alert, float percent, uint32_t now_ms);
+
+/**
+ * @brief Red-zone slot color of an effect at a time into the alert
+ * Blink and invert switch every LOW_FUEL_BLINK_MS; pulse moves through
+ * LOW_FUEL_PULSE_STEPS colors each way, so it changes only at step edges.
+ * @param effect LOW_FUEL_EFFECT_BLINK, _PULSE or _INVERT
+ * @param elapsed_ms Time since the alert started
+ * @return RGB565 color (UI_COLOR_RED at phase 0)
+ */
+uint16_t gauge_alert_effect_color(int effect, uint32_t elapsed_ms);
+
+/**
+ * @brief Red-zone slot color for the configured effect
+ * @return UI_COLOR_RED when the alert is not active
+ */
+uint16_t gauge_alert_color(const GaugeAlert* alert, uint32_t now_ms);
+
+#endif // GAUGE_ALERT_H
@@ -0,0 +1,52 @@
+#include "gauge_anim.h"
+#include "gauge.h"
+
+float gauge_anim_ease(float t) {
+    if (t <= 0.0f) return 0.0f;
+    if (t >= 1.0f) return 1.0f;
+    float u = 1.0f - t;
+    return 1.0f - u * u * u;
+}
+
+void gauge_anim_init(GaugeAnim* anim, float percent) {
+    anim->from = percent;
+    anim->to = percent;
+    anim->shown = percent;
+    anim->start_ms = 0;
+    anim->active = false;
+}
+
+void gauge_anim_set_target(GaugeAnim* anim, float percent, uint32_t now_ms) {
+    if (percent == anim->to) {
+        return;
+    }
+    if (!anim->active && gauge_get_fill_pixels(percent) == gauge_get_fill_pixels(anim->shown)) {
+        gauge_anim_init(anim, percent);
+        return;
+    }
+    // Start from what is on screen, so retargeting never jumps
+    gauge_anim_step(anim, now_ms);
+    anim->from = anim->shown;
+    anim->to = percent;
+    anim->start_ms = now_ms;
+    anim->active = true;
+}
+
+float gauge_anim_step(GaugeAnim* anim, uint32_t now_ms) {
+    if (!anim->active) {
+        return anim->shown;
+    }
+    uint32_t elapsed = now_ms - anim->start_ms;
+    if (elapsed >= GAUGE_ANIM_DURATION_MS) {
+        anim->shown = anim->to;
+        anim->active = false;
+        return anim->shown;
+    }
+    float k = gauge_anim_ease((float)elapsed / GAUGE_ANIM_DURATION_MS);
+    anim->shown = anim->from + (anim->to - anim->from) * k;
+    return anim->shown;
+}
+
+bool gauge_anim_active(const GaugeAnim* anim) {
+    return anim->active;
+}
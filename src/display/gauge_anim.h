@@ -0,0 +1,62 @@
+#ifndef GAUGE_ANIM_H
+#define GAUGE_ANIM_H
+
+/*******************************************************************************
+ * Render-side level animation
+ *
+ * The displayed fill follows the filtered level with a time-based ease-out
+ * instead of jumping to it. The shown value depends only on the elapsed time
+ * since the tween started, so it lands at the same place whatever the frame
+ * rate. A new target mid-flight restarts the tween from the value currently
+ * on screen, so the bar never jumps.
+ ******************************************************************************/
+
+#include "config.h"
+#include <stdint.h>
+
+/**
+ * @brief Tween state for one gauge
+ */
+typedef struct {
+    float from;                         // Shown level when the tween started
+    float to;                           // Target level
+    float shown;                        // Level on screen after the last step
+    uint32_t start_ms;                  // Tween start time
+    bool active;                        // A tween is in flight
+} GaugeAnim;
+
+/**
+ * @brief Place the gauge at a level with no tween in flight
+ */
+void gauge_anim_init(GaugeAnim* anim, float percent);
+
+/**
+ * @brief Set the level the gauge should move to
+ * Targets within the same fill pixel as the shown level are taken
+ * immediately (only the readouts can change), so sensor noise does not
+ * keep a tween running.
+ * @param anim Tween state
+ * @param percent Target level (0-100)
+ * @param now_ms Current time in milliseconds
+ */
+void gauge_anim_set_target(GaugeAnim* anim, float percent, uint32_t now_ms);
+
+/**
+ * @brief Advance the tween to now
+ * @return Level to show
+ */
+float gauge_anim_step(GaugeAnim* anim, uint32_t now_ms);
+
+/**
+ * @brief Check whether a tween is in flight (frames are needed)
+ */
+bool gauge_anim_active(const GaugeAnim* anim);
+
+/**
+ * @brief Pure calculation: ease-out curve (cubic)
+ * @param t Normalized time (clamped to 0-1)
+ * @return Normalized progress (0-1)
+ */
+float gauge_anim_ease(float t);
+
+#endif // GAUGE_ANIM_H
@@ -0,0 +1,262 @@
+#ifndef GAUGE_WIDGET_H
+#define GAUGE_WIDGET_H
+
+/*******************************************************************************
+ * Segmented bar gauge with its geometry fixed at compile time
+ *
+ * Gauge<Orientation, Segments, SegH, Gap, Width> is one bar layout: segment
+ * count, segment length along the fill axis, gap between segments, and bar
+ * thickness across it. All layout math is constexpr and the per-segment
+ * loops are unrolled, so each instantiation compiles to straight-line fills
+ * with constant offsets. Differently sized gauges (main and auxiliary tank,
+ * portrait and landscape) are separate types and share no runtime state
+ * except their zone colors.
+ *
+ * Vertical bars fill bottom to top, horizontal bars left to right. (x, y) is
+ * always the top-left corner inside the 1-pixel border; a 1-pixel padding
+ * separates the border from the segments on all sides.
+ ******************************************************************************/
+
+#include "config.h"
+#include "display.h"
+#include "gauge.h"
+#include <stdint.h>
+
+enum GaugeOrientation {
+    GAUGE_VERTICAL,                     // Fills bottom to top (portrait)
+    GAUGE_HORIZONTAL                    // Fills left to right (landscape)
+};
+
+// Calls f(I), f(I + 1), ... f(N - 1) with constant arguments
+template <int I, int N>
+struct GaugeUnroll {
+    template <typename F>
+    static inline void run(F& f) {
+        f(I);
+        GaugeUnroll<I + 1, N>::run(f);
+    }
+};
+
+template <int N>
+struct GaugeUnroll<N, N> {
+    template <typename F>
+    static inline void run(F&) {}
+};
+
+template <GaugeOrientation Orientation, int Segments, int SegH, int Gap, int Width>
+struct Gauge {
+    static constexpr bool VERTICAL = (Orientation == GAUGE_VERTICAL);
+    static constexpr int PADDING = 1;                             // Border to segments
+    static constexpr int PITCH = SegH + Gap;                      // Segment start to start
+    static constexpr int FILL_PIXELS = Segments * SegH;           // Fill resolution, gaps excluded
+    static constexpr int BAR_LENGTH = Segments * PITCH - Gap;     // Segment area along the fill axis
+    static constexpr int OUTER_LENGTH = BAR_LENGTH + 2 * PADDING; // Inside the border
+    static constexpr int LINE_WIDTH = Width - 2 * PADDING;        // Segment area across the fill axis
+
+    // Size inside the border
+    static constexpr int16_t WIDTH_PX = VERTICAL ? Width : OUTER_LENGTH;
+    static constexpr int16_t HEIGHT_PX = VERTICAL ? OUTER_LENGTH : Width;
+
+    // Offset of a segment's screen-first line (top or left) from the bar origin
+    static constexpr int segment_offset(int seg) {
+        return PADDING + (VERTICAL ? (Segments - 1 - seg) : seg) * PITCH;
+    }
+
+    /**
+     * @brief Number of fill pixels lit for a given percentage
+     */
+    static int fill_pixels(float percent) {
+        if (percent < 0.0f) percent = 0.0f;
+        if (percent > 100.0f) percent = 100.0f;
+        int filled = (int)((percent / 100.0f) * FILL_PIXELS + 0.5f);
+        return (filled > FILL_PIXELS) ? FILL_PIXELS : filled;
+    }
+
+    /**
+     * @brief Zone color of one fill pixel, from a table built on first use
+     * @return RGB565 color (UI_COLOR_EMPTY if out of range)
+     */
+    static uint16_t fill_color(int pixel) {
+        if (pixel < 0 || pixel >= FILL_PIXELS) {
+            return UI_COLOR_EMPTY;
+        }
+        return colors()[pixel];
+    }
+
+    /**
+     * @brief Draw border, padding and every segment
+     */
+    static void draw(int16_t x, int16_t y, float percent) {
+        // Border: top, bottom, left, right
+        display_draw_hline(x - 1, y - 1, WIDTH_PX + 2, UI_COLOR_BORDER);
+        display_draw_hline(x - 1, y + HEIGHT_PX, WIDTH_PX + 2, UI_COLOR_BORDER);
+        display_fill_rect(x - 1, y, 1, HEIGHT_PX, UI_COLOR_BORDER);
+        display_fill_rect(x + WIDTH_PX, y, 1, HEIGHT_PX, UI_COLOR_BORDER);
+        draw_padding(x, y);
+
+        SegmentDraw body = {x, y, fill_pixels(percent)};
+        GaugeUnroll<0, Segments>::run(body);
+    }
+
+    /**
+     * @brief Repaint only the fill pixels between two levels
+     * Gaps, border and padding are not touched.
+     */
+    static void update(int16_t x, int16_t y, int old_pixels, int new_pixels) {
+        if (new_pixels < old_pixels) {
+            fill_range(x, y, new_pixels, old_pixels, UI_COLOR_EMPTY);
+            return;
+        }
+
+        // One band per affected segment
+        int lo = old_pixels;
+        while (lo < new_pixels) {
+            int seg = lo / SegH;
+            int seg_end = (seg + 1) * SegH;
+            int run_end = (new_pixels < seg_end) ? new_pixels : seg_end;
+            fill_zone(x, y, seg, lo - seg * SegH, run_end - seg * SegH);
+            lo = run_end;
+        }
+    }
+
+    /**
+     * @brief Paint fill pixels [lo, hi) in one color, one rect per segment
+     */
+    static void fill_range(int16_t x, int16_t y, int lo, int hi, uint16_t color) {
+        while (lo < hi) {
+            int seg = lo / SegH;
+            int seg_end = (seg + 1) * SegH;
+            int run_end = (hi < seg_end) ? hi : seg_end;
+            fill_band(x, y, seg, lo - seg * SegH, run_end - seg * SegH, color);
+            lo = run_end;
+        }
+    }
+
+    /**
+     * @brief Color of every line of the segment area in screen order
+     * Lines run across the fill axis (rows of a vertical bar, columns of a
+     * horizontal one); each is a single color.
+     * @param lines Output: BAR_LENGTH colors, top or left line first
+     */
+    static void build_lines(float percent, uint16_t* lines) {
+        LineBuild body = {lines, fill_pixels(percent)};
+        GaugeUnroll<0, Segments>::run(body);
+    }
+
+    /**
+     * @brief Draw the whole bar with the segment area sent as one window
+     * Same pixels as draw(), but the gaps are painted too.
+     */
+    static void stream(int16_t x, int16_t y, float percent) {
+        display_fill_rect(x - 1, y - 1, WIDTH_PX + 2, 1, UI_COLOR_BORDER);
+        display_fill_rect(x - 1, y + HEIGHT_PX, WIDTH_PX + 2, 1, UI_COLOR_BORDER);
+        display_fill_rect(x - 1, y, 1, HEIGHT_PX, UI_COLOR_BORDER);
+        display_fill_rect(x + WIDTH_PX, y, 1, HEIGHT_PX, UI_COLOR_BORDER);
+        draw_padding(x, y);
+
+        uint16_t lines[BAR_LENGTH];
+        build_lines(percent, lines);
+        if (VERTICAL) {
+            display_push_row_colors(x + PADDING, y + PADDING, LINE_WIDTH, BAR_LENGTH, lines);
+        } else {
+            // Every row of a horizontal bar is the line vector itself
+            display_window_begin(x + PADDING, y + PADDING, BAR_LENGTH, LINE_WIDTH);
+            for (int row = 0; row < LINE_WIDTH; row++) {
+                display_window_write_row(lines);
+            }
+            display_window_end();
+        }
+    }
+
+private:
+    static uint16_t color_table[FILL_PIXELS];
+    static bool color_table_ready;
+
+    static const uint16_t* colors() {
+        if (!color_table_ready) {
+            for (int p = 0; p < FILL_PIXELS; p++) {
+#if GAUGE_GRADIENT_ENABLE
+                color_table[p] = gauge_get_zone_color(((float)p + 0.5f) / FILL_PIXELS * 100.0f);
+#else
+                color_table[p] = gauge_get_zone_color(((float)(p / SegH) / (float)Segments) * 100.0f);
+#endif
+            }
+            color_table_ready = true;
+        }
+        return color_table;
+    }
+
+    static void draw_padding(int16_t x, int16_t y) {
+        display_fill_rect(x, y, WIDTH_PX, PADDING, UI_COLOR_BACKGROUND);
+        display_fill_rect(x, y + HEIGHT_PX - PADDING, WIDTH_PX, PADDING, UI_COLOR_BACKGROUND);
+        display_fill_rect(x, y + PADDING, PADDING, HEIGHT_PX - 2 * PADDING, UI_COLOR_BACKGROUND);
+        display_fill_rect(x + WIDTH_PX - PADDING, y + PADDING, PADDING, HEIGHT_PX - 2 * PADDING,
+                          UI_COLOR_BACKGROUND);
+    }
+
+    // Fill pixels [lo, hi) of one segment (counted from its empty end) in one color
+    static void fill_band(int16_t x, int16_t y, int seg, int lo, int hi, uint16_t color) {
+        if (VERTICAL) {
+            display_fill_rect(x + PADDING, y + segment_offset(seg) + (SegH - hi), LINE_WIDTH, hi - lo, color);
+        } else {
+            display_fill_rect(x + segment_offset(seg) + lo, y + PADDING, hi - lo, LINE_WIDTH, color);
+        }
+    }
+
+    // Fill pixels [lo, hi) of one segment with their zone colors, one rect per run
+    static void fill_zone(int16_t x, int16_t y, int seg, int lo, int hi) {
+        const uint16_t* table = colors() + seg * SegH;
+        int p = lo;
+        while (p < hi) {
+            int run = 1;
+            while (p + run < hi && table[p + run] == table[p]) {
+                run++;
+            }
+            fill_band(x, y, seg, p, p + run, table[p]);
+            p += run;
+        }
+    }
+
+    struct SegmentDraw {
+        int16_t x;
+        int16_t y;
+        int fill;
+        inline void operator()(int seg) {
+            int lit = fill - seg * SegH;
+            if (lit < 0) lit = 0;
+            if (lit > SegH) lit = SegH;
+            if (lit < SegH) {
+                fill_band(x, y, seg, lit, SegH, UI_COLOR_EMPTY);
+            }
+            if (lit > 0) {
+                fill_zone(x, y, seg, 0, lit);
+            }
+        }
+    };
+
+    struct LineBuild {
+        uint16_t* lines;
+        int fill;
+        inline void operator()(int seg) {
+            const uint16_t* table = colors() + seg * SegH;
+            uint16_t* out = lines + segment_offset(seg) - PADDING;
+            for (int i = 0; i < SegH; i++) {
+                int p = VERTICAL ? SegH - 1 - i : i;    // Screen order within the segment
+                out[i] = (seg * SegH + p < fill) ? table[p] : UI_COLOR_EMPTY;
+            }
+            if (seg != (VERTICAL ? 0 : Segments - 1)) {
+                for (int g = 0; g < Gap; g++) {
+                    out[SegH + g] = UI_COLOR_BACKGROUND;
+                }
+            }
+        }
+    };
+};
+
+template <GaugeOrientation Orientation, int Segments, int SegH, int Gap, int Width>
+uint16_t Gauge<Orientation, Segments, SegH, Gap, Width>::color_table[Gauge::FILL_PIXELS];
+
+template <GaugeOrientation Orientation, int Segments, int SegH, int Gap, int Width>
+bool Gauge<Orientation, Segments, SegH, Gap, Width>::color_table_ready = false;
+
+#endif // GAUGE_WIDGET_H
@@ -0,0 +1,143 @@
+#include "glyph_cache.h"
+#include "display.h"
+#include "font_glcd.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Fonts
+// ============================================================================
+
+static uint8_t glcd_coverage(char c, int col, int row) {
+    return (font_glcd_column(c, col) & (1 << row)) ? 255 : 0;
+}
+
+const GlyphFont glyph_font_glcd = {FONT_GLCD_CELL_W, FONT_GLCD_CELL_H, glcd_coverage};
+
+// ============================================================================
+// Cache
+// ============================================================================
+
+// Blend two RGB565 colours per channel by coverage (0-255)
+static uint16_t blend_565(uint16_t bg, uint16_t fg, uint8_t a) {
+    if (a == 0) return bg;
+    if (a == 255) return fg;
+    int r = ((bg >> 11) * (255 - a) + (fg >> 11) * a + 127) / 255;
+    int g = (((bg >> 5) & 0x3F) * (255 - a) + ((fg >> 5) & 0x3F) * a + 127) / 255;
+    int b = ((bg & 0x1F) * (255 - a) + (fg & 0x1F) * a + 127) / 255;
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+static int glyph_index(char c) {
+    const char* p = strchr(GLYPH_CACHE_CHARS, c);
+    return (p && c != '\0') ? (int)(p - GLYPH_CACHE_CHARS) : -1;
+}
+
+bool glyph_cache_init(GlyphCache* cache, const GlyphFont* font, uint8_t size,
+                      uint16_t fg, uint16_t bg) {
+    cache->cell_w = font->cell_w * size;
+    cache->cell_h = font->cell_h * size;
+    cache->bg = bg;
+
+    int32_t cell_pixels = (int32_t)cache->cell_w * cache->cell_h;
+    free(cache->pixels);
+    cache->pixels = (uint16_t*)malloc(sizeof(uint16_t) * cell_pixels * GLYPH_CACHE_COUNT);
+    if (!cache->pixels) {
+        return false;
+    }
+
+    for (int i = 0; i < GLYPH_CACHE_COUNT; i++) {
+        char c = GLYPH_CACHE_CHARS[i];
+        uint16_t* cell = cache->pixels + i * cell_pixels;
+        for (int16_t py = 0; py < cache->cell_h; py++) {
+            for (int16_t px = 0; px < cache->cell_w; px++) {
+                cell[py * cache->cell_w + px] = blend_565(bg, fg, font->coverage(c, px / size, py / size));
+            }
+        }
+    }
+    return true;
+}
+
+const uint16_t* glyph_cache_get(const GlyphCache* cache, char c) {
+    int i = glyph_index(c);
+    if (i < 0 || !cache->pixels) {
+        return nullptr;
+    }
+    return cache->pixels + (int32_t)i * cache->cell_w * cache->cell_h;
+}
+
+// ============================================================================
+// Readouts
+// ============================================================================
+
+// One window row, composed from the cached cells
+static uint16_t row_buf[LCD_WIDTH];
+
+// Send [win_x, win_x + win_w) x cell_h as one window; text starts at text_x
+static void blit_span(const GlyphCache* cache, int16_t win_x, int16_t y, int16_t win_w,
+                      int16_t text_x, const char* text) {
+    if (win_w > LCD_WIDTH) win_w = LCD_WIDTH;
+    int len = (int)strlen(text);
+
+    display_window_begin(win_x, y, win_w, cache->cell_h);
+    for (int16_t row = 0; row < cache->cell_h; row++) {
+        for (int16_t i = 0; i < win_w; i++) {
+            row_buf[i] = cache->bg;
+        }
+        for (int c = 0; c < len; c++) {
+            const uint16_t* src = glyph_cache_get(cache, text[c]) + row * cache->cell_w;
+            int16_t dst = text_x + c * cache->cell_w - win_x;
+            for (int16_t px = 0; px < cache->cell_w; px++) {
+                if (dst + px >= 0 && dst + px < win_w) {
+                    row_buf[dst + px] = src[px];
+                }
+            }
+        }
+        display_window_write_row(row_buf);
+    }
+    display_window_end();
+}
+
+bool glyph_text_draw(const GlyphCache* cache, GlyphText* state, int16_t x, int16_t y,
+                     int16_t field_w, int16_t text_x, const char* text) {
+    int len = (int)strlen(text);
+    if (len > GLYPH_TEXT_MAX || !cache->pixels) {
+        return false;
+    }
+    for (int i = 0; i < len; i++) {
+        if (glyph_index(text[i]) < 0) {
+            return false;
+        }
+    }
+
+    bool same_layout = state->valid && state->x == x && state->y == y &&
+                       state->text_x == text_x && (int)strlen(state->text) == len &&
+                       state->clear_count == display_get_clear_count();
+    if (!same_layout) {
+        // Whole field: background around the string, one window
+        blit_span(cache, x, y, field_w, text_x, text);
+    } else {
+        // Only the characters between the first and last difference
+        int first = 0;
+        while (first < len && text[first] == state->text[first]) first++;
+        if (first == len) {
+            return true;
+        }
+        int last = len - 1;
+        while (last > first && text[last] == state->text[last]) last--;
+        int16_t span_x = text_x + first * cache->cell_w;
+        blit_span(cache, span_x, y, (last - first + 1) * cache->cell_w, text_x, text);
+    }
+
+    state->x = x;
+    state->y = y;
+    state->text_x = text_x;
+    memcpy(state->text, text, len + 1);
+    state->clear_count = display_get_clear_count();
+    state->valid = true;
+    return true;
+}
+
+void glyph_text_invalidate(GlyphText* state) {
+    state->valid = false;
+}
@@ -0,0 +1,101 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+/*******************************************************************************
+ * Pre-rendered glyph cache for numeric readouts
+ *
+ * The characters a readout can show (digits, 'G', '%', space) are rendered
+ * once into RGB565 cells at a fixed size and colour pair. A readout string is
+ * then blitted as one pixel window, and only the span of characters that
+ * changed since the last draw is sent.
+ *
+ * Fonts are described by a coverage function (0 = background, 255 = ink), so
+ * a larger or anti-aliased font only needs a new GlyphFont; blending happens
+ * once at cache build time and costs nothing per update.
+ ******************************************************************************/
+
+#include "config.h"
+#include <stdint.h>
+
+// Characters held in the cache
+#define GLYPH_CACHE_CHARS     " 0123456789G%"
+#define GLYPH_CACHE_COUNT     13
+#define GLYPH_TEXT_MAX        7       // Longest cached readout string
+
+/**
+ * @brief Font description (unscaled cell, per-pixel coverage)
+ */
+typedef struct {
+    uint8_t cell_w;                     // Advance width in pixels
+    uint8_t cell_h;                     // Cell height in pixels
+    uint8_t (*coverage)(char c, int col, int row);  // 0-255 ink coverage
+} GlyphFont;
+
+/**
+ * @brief Built-in 5x7 GLCD font (same pixels as LovyanGFX Font0)
+ */
+extern const GlyphFont glyph_font_glcd;
+
+/**
+ * @brief Rendered glyph cells for one font, size and colour pair
+ */
+typedef struct {
+    int16_t cell_w;                     // Scaled cell width
+    int16_t cell_h;                     // Scaled cell height
+    uint16_t bg;                        // Background colour
+    uint16_t* pixels;                   // GLYPH_CACHE_COUNT cells, row-major
+} GlyphCache;
+
+/**
+ * @brief On-screen state of one readout (what was last drawn where)
+ */
+typedef struct {
+    int16_t x;                          // Field position
+    int16_t y;
+    int16_t text_x;                     // Where the string started
+    char text[GLYPH_TEXT_MAX + 1];
+    uint32_t clear_count;               // display_get_clear_count() at draw time
+    bool valid;
+} GlyphText;
+
+/**
+ * @brief Render the cached characters
+ * @param cache Cache to fill (pixels allocated on the heap)
+ * @param font Font to render
+ * @param size Integer scale factor
+ * @param fg Ink colour (RGB565)
+ * @param bg Background colour (RGB565)
+ * @return false if the cell buffer could not be allocated
+ */
+bool glyph_cache_init(GlyphCache* cache, const GlyphFont* font, uint8_t size,
+                      uint16_t fg, uint16_t bg);
+
+/**
+ * @brief Get a cached cell
+ * @return cell_w x cell_h RGB565 pixels, nullptr if the character is not cached
+ */
+const uint16_t* glyph_cache_get(const GlyphCache* cache, char c);
+
+/**
+ * @brief Draw a readout string, sending only what changed
+ * The first draw (or any change of position, length or a screen clear)
+ * repaints the whole field; otherwise only the span between the first and
+ * last changed character is sent. Either way it is one pixel window.
+ * @param cache Glyph cache
+ * @param state Readout state (updated)
+ * @param x Field X position
+ * @param y Field Y position
+ * @param field_w Field width in pixels (background outside the string)
+ * @param text_x Screen X of the first character
+ * @param text String to show
+ * @return false if a character is not cached (nothing drawn)
+ */
+bool glyph_text_draw(const GlyphCache* cache, GlyphText* state, int16_t x, int16_t y,
+                     int16_t field_w, int16_t text_x, const char* text);
+
+/**
+ * @brief Forget what a readout shows so its next draw repaints the field
+ */
+void glyph_text_invalidate(GlyphText* state);
+
+#endif // GLYPH_CACHE_H
@@ -0,0 +1,134 @@
+#include "history_page.h"
+#include "display.h"
+#include "gauge.h"
+
+// Page layout (portrait 170x320). The title and lane labels sit in the
+// panel's fixed scroll areas; the chart in between scrolls in hardware.
+#define HISTORY_PAGE_X        8       // Left margin for text
+#define HISTORY_TITLE_Y       6       // "HISTORY" title
+#define HISTORY_TOP_FIXED     26      // Title band (fixed)
+#define HISTORY_BOTTOM_FIXED  14      // Lane label band (fixed)
+#define HISTORY_CHART_ROWS    (LCD_HEIGHT - HISTORY_TOP_FIXED - HISTORY_BOTTOM_FIXED)
+#define HISTORY_LANE_GAP      4       // Space around each lane
+#define HISTORY_LANE_W        ((LCD_WIDTH - 3 * HISTORY_LANE_GAP) / 2)
+
+static int16_t lane_x(int tank) {
+    return HISTORY_LANE_GAP + (tank - 1) * (HISTORY_LANE_W + HISTORY_LANE_GAP);
+}
+
+// What is on the panel
+static bool history_page_drawn = false;
+static bool hw_scroll = false;      // Scroll area defined on the panel
+static int drawn_zoom = 0;
+static uint32_t drawn_total = 0;    // fuel_history_total() at the last draw
+static int16_t scroll_row = 0;      // Chart row shown at the top of the band
+
+void history_page_invalidate() {
+    history_page_drawn = false;
+}
+
+// One chart row: a level bar per lane, or blank if there is no sample
+static uint16_t row_buf[LCD_WIDTH];
+
+static void build_row(const FuelHistory* h, int zoom, int age) {
+    for (int16_t i = 0; i < LCD_WIDTH; i++) {
+        row_buf[i] = UI_COLOR_BACKGROUND;
+    }
+    if (age >= fuel_history_count(h, zoom)) {
+        return;
+    }
+    for (int tank = 1; tank <= 2; tank++) {
+        float level = fuel_history_get(h, zoom, tank, age);
+        int16_t fill = (int16_t)(level * HISTORY_LANE_W / 100.0f + 0.5f);
+        uint16_t color = gauge_get_color_for_percent(level);
+        uint16_t* lane = row_buf + lane_x(tank);
+        for (int16_t i = 0; i < HISTORY_LANE_W; i++) {
+            lane[i] = (i < fill) ? color : UI_COLOR_EMPTY;
+        }
+    }
+}
+
+// Whole chart as one window, newest sample on the bottom row
+static void draw_chart(const FuelHistory* h, int zoom) {
+    scroll_row = 0;
+    if (hw_scroll) {
+        display_scroll_to(HISTORY_TOP_FIXED);
+    }
+    display_window_begin(0, HISTORY_TOP_FIXED, LCD_WIDTH, HISTORY_CHART_ROWS);
+    for (int16_t row = 0; row < HISTORY_CHART_ROWS; row++) {
+        build_row(h, zoom, HISTORY_CHART_ROWS - 1 - row);
+        display_window_write_row(row_buf);
+    }
+    display_window_end();
+}
+
+// Scroll the band up one row and paint the sample into the row that
+// wrapped round to the bottom
+static void scroll_in(const FuelHistory* h, int zoom, int age) {
+    scroll_row = (scroll_row + 1) % HISTORY_CHART_ROWS;
+    display_scroll_to(HISTORY_TOP_FIXED + scroll_row);
+    int16_t bottom = (scroll_row + HISTORY_CHART_ROWS - 1) % HISTORY_CHART_ROWS;
+    build_row(h, zoom, age);
+    display_window_begin(0, HISTORY_TOP_FIXED + bottom, LCD_WIDTH, 1);
+    display_window_write_row(row_buf);
+    display_window_end();
+}
+
+static void draw_span_label(int zoom) {
+    uint32_t minutes = HISTORY_CHART_ROWS * fuel_history_interval_ms(zoom) / 60000;
+    display_fill_rect(LCD_WIDTH - 48, HISTORY_TITLE_Y + 4, 48, 8, UI_COLOR_BACKGROUND);
+    display_set_text_size(1);
+    display_set_text_color(UI_COLOR_TEXT);
+    display_set_cursor(LCD_WIDTH - 48, HISTORY_TITLE_Y + 4);
+    if (minutes < 120) {
+        display_print_int((int)minutes);
+        display_print(" MIN");
+    } else {
+        display_print_int((int)((minutes + 30) / 60));
+        display_print(" HR");
+    }
+}
+
+void history_page_draw_background() {
+    // Static page furniture - title and lane labels in the fixed bands
+    display_set_text_size(2);
+    display_set_text_color(UI_COLOR_DEBUG);
+    display_set_cursor(HISTORY_PAGE_X, HISTORY_TITLE_Y);
+    display_print("HISTORY");
+    display_draw_hline(0, HISTORY_TOP_FIXED - 1, LCD_WIDTH, UI_COLOR_DEBUG);
+
+    display_set_text_size(1);
+    display_set_text_color(COLOR_SEGMENT_LINE);
+    display_set_cursor(lane_x(1), LCD_HEIGHT - 11);
+    display_print(TANK1_LABEL);
+    display_set_cursor(lane_x(2), LCD_HEIGHT - 11);
+    display_print(TANK2_LABEL);
+}
+
+void history_page_draw(const FuelHistory* h, int zoom) {
+    uint32_t total = fuel_history_total(h, zoom);
+
+    if (!history_page_drawn || zoom != drawn_zoom) {
+        hw_scroll = display_scroll_define(HISTORY_TOP_FIXED, HISTORY_CHART_ROWS);
+        draw_span_label(zoom);
+        draw_chart(h, zoom);
+        history_page_drawn = true;
+        drawn_zoom = zoom;
+        drawn_total = total;
+        return;
+    }
+
+    uint32_t fresh = total - drawn_total;
+    if (fresh == 0) {
+        return;
+    }
+    if (!hw_scroll || fresh >= HISTORY_CHART_ROWS) {
+        draw_chart(h, zoom);
+    } else {
+        // Oldest new sample first, so the newest ends on the bottom row
+        for (int age = (int)fresh - 1; age >= 0; age--) {
+            scroll_in(h, zoom, age);
+        }
+    }
+    drawn_total = total;
+}
@@ -0,0 +1,31 @@
+#ifndef HISTORY_PAGE_H
+#define HISTORY_PAGE_H
+
+#include "config.h"
+#include "../sensor/fuel_history.h"
+#include <stdint.h>
+
+/**
+ * @brief Draw the static part of the history page (title, lane labels)
+ * This is the page's background layer (page_compositor.h).
+ */
+void history_page_draw_background();
+
+/**
+ * @brief Draw the fuel history page (one strip chart lane per tank)
+ * Time runs down the screen, newest sample at the bottom. After the first
+ * draw, each new sample costs one scroll command and one chart row: the
+ * panel scrolls the rest of the chart in hardware. A zoom change, or more
+ * new samples than chart rows, redraws the chart.
+ * @param h Level history
+ * @param zoom Zoom level (0 = finest)
+ */
+void history_page_draw(const FuelHistory* h, int zoom);
+
+/**
+ * @brief Force the next history_page_draw() to render the chart and span
+ * Call after the page background has been shown
+ */
+void history_page_invalidate();
+
+#endif // HISTORY_PAGE_H
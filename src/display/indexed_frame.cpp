@@ -0,0 +1,255 @@
+#include "indexed_frame.h"
+#include <string.h>
+
+static void mark_rows(IndexedFrame* frame, int16_t y0, int16_t y1) {
+    for (int16_t y = y0; y < y1; y++) {
+        frame->dirty[y >> 5] |= 1u << (y & 31);
+    }
+}
+
+void indexed_frame_init(IndexedFrame* frame, uint16_t background) {
+    memset(frame->pixels, 0, sizeof(frame->pixels));
+    memset(frame->palette, 0, sizeof(frame->palette));
+    frame->palette[0] = background;
+    frame->colors = 1;
+    frame->last_index = 0;
+    frame->last_color = background;
+    frame->expand_valid = false;
+    frame->expand_swapped = false;
+    memset(frame->dirty, 0, sizeof(frame->dirty));
+    mark_rows(frame, 0, LCD_HEIGHT);
+}
+
+// ============================================================================
+// Palette
+// ============================================================================
+
+static int32_t color_distance(uint16_t a, uint16_t b) {
+    int32_t dr = (int32_t)(a >> 11) - (b >> 11);
+    int32_t dg = (int32_t)((a >> 5) & 0x3F) - ((b >> 5) & 0x3F);
+    int32_t db = (int32_t)(a & 0x1F) - (b & 0x1F);
+    // Green has one more bit: halve it so the channels weigh the same
+    return dr * dr * 4 + dg * dg + db * db * 4;
+}
+
+uint8_t indexed_frame_index(IndexedFrame* frame, uint16_t color) {
+    if (color == frame->last_color) {
+        return frame->last_index;
+    }
+    uint8_t index = 0;
+    bool found = false;
+    for (uint8_t i = 0; i < frame->colors; i++) {
+        if (frame->palette[i] == color) {
+            index = i;
+            found = true;
+            break;
+        }
+    }
+    if (!found && frame->colors < INDEXED_COLORS) {
+        index = frame->colors++;
+        frame->palette[index] = color;
+        frame->expand_valid = false;
+    } else if (!found) {
+        int32_t best = INT32_MAX;
+        for (uint8_t i = 0; i < INDEXED_COLORS; i++) {
+            int32_t d = color_distance(frame->palette[i], color);
+            if (d < best) {
+                best = d;
+                index = i;
+            }
+        }
+    }
+    frame->last_color = color;
+    frame->last_index = index;
+    return index;
+}
+
+bool indexed_frame_recolor(IndexedFrame* frame, uint16_t from, uint16_t to) {
+    int index = -1;
+    for (uint8_t i = 0; i < frame->colors; i++) {
+        if (frame->palette[i] == from) {
+            index = i;
+            break;
+        }
+    }
+    if (index < 0) {
+        return false;
+    }
+    frame->palette[index] = to;
+    frame->last_color = frame->palette[frame->last_index];
+    frame->expand_valid = false;
+
+    // Only rows holding the index need to go out again
+    for (int16_t y = 0; y < LCD_HEIGHT; y++) {
+        const uint8_t* row = &frame->pixels[y * INDEXED_ROW_BYTES];
+        for (int16_t b = 0; b < INDEXED_ROW_BYTES; b++) {
+            if ((row[b] >> 4) == index || (row[b] & 0x0F) == index) {
+                mark_rows(frame, y, y + 1);
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+static void set_nibble(uint8_t* row, int16_t x, uint8_t index) {
+    uint8_t* p = &row[x >> 1];
+    *p = (x & 1) ? (uint8_t)((*p & 0xF0) | index) : (uint8_t)((*p & 0x0F) | (index << 4));
+}
+
+void indexed_frame_fill(IndexedFrame* frame, int16_t x, int16_t y, int16_t w, int16_t h,
+                        uint16_t color) {
+    int16_t x0 = x < 0 ? 0 : x;
+    int16_t y0 = y < 0 ? 0 : y;
+    int16_t x1 = (x + w > LCD_WIDTH) ? LCD_WIDTH : x + w;
+    int16_t y1 = (y + h > LCD_HEIGHT) ? LCD_HEIGHT : y + h;
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    uint8_t index = indexed_frame_index(frame, color);
+    uint8_t pair = (uint8_t)(index << 4 | index);
+
+    // Whole bytes in the middle, odd nibbles at either end
+    int16_t mid0 = (x0 + 1) & ~1;
+    int16_t mid1 = x1 & ~1;
+    for (int16_t row = y0; row < y1; row++) {
+        uint8_t* p = &frame->pixels[row * INDEXED_ROW_BYTES];
+        if (mid0 >= mid1) {
+            for (int16_t col = x0; col < x1; col++) {
+                set_nibble(p, col, index);
+            }
+            continue;
+        }
+        if (x0 & 1) {
+            set_nibble(p, x0, index);
+        }
+        memset(p + (mid0 >> 1), pair, (mid1 - mid0) >> 1);
+        if (x1 & 1) {
+            set_nibble(p, x1 - 1, index);
+        }
+    }
+    mark_rows(frame, y0, y1);
+}
+
+void indexed_frame_write(IndexedFrame* frame, int16_t x, int16_t y, int16_t n,
+                         const uint16_t* pixels) {
+    if (y < 0 || y >= LCD_HEIGHT) {
+        return;
+    }
+    uint8_t* row = &frame->pixels[y * INDEXED_ROW_BYTES];
+    int16_t i = (x < 0) ? -x : 0;
+    int16_t end = (x + n > LCD_WIDTH) ? LCD_WIDTH - x : n;
+    if (i >= end) {
+        return;
+    }
+    for (; i < end; i++) {
+        set_nibble(row, x + i, indexed_frame_index(frame, pixels[i]));
+    }
+    mark_rows(frame, y, y + 1);
+}
+
+uint16_t indexed_frame_pixel(const IndexedFrame* frame, int16_t x, int16_t y) {
+    if (x < 0 || y < 0 || x >= LCD_WIDTH || y >= LCD_HEIGHT) {
+        return 0;
+    }
+    uint8_t b = frame->pixels[y * INDEXED_ROW_BYTES + (x >> 1)];
+    return frame->palette[(x & 1) ? (b & 0x0F) : (b >> 4)];
+}
+
+bool indexed_frame_row_dirty(const IndexedFrame* frame, int16_t y) {
+    return (frame->dirty[y >> 5] >> (y & 31)) & 1u;
+}
+
+// ============================================================================
+// Push
+// ============================================================================
+
+static void build_expand(IndexedFrame* frame, bool swap_bytes) {
+    uint16_t out[INDEXED_COLORS];
+    for (int i = 0; i < INDEXED_COLORS; i++) {
+        uint16_t c = frame->palette[i];
+        out[i] = swap_bytes ? (uint16_t)((c >> 8) | (c << 8)) : c;
+    }
+    for (int b = 0; b < 256; b++) {
+        frame->expand[b] = (uint32_t)out[b >> 4] | ((uint32_t)out[b & 0x0F] << 16);
+    }
+    frame->expand_valid = true;
+    frame->expand_swapped = swap_bytes;
+}
+
+static void expand_rows(const IndexedFrame* frame, int16_t y, int16_t rows, uint16_t* out) {
+    for (int16_t r = 0; r < rows; r++) {
+        const uint8_t* src = &frame->pixels[(y + r) * INDEXED_ROW_BYTES];
+        for (int16_t b = 0; b < LCD_WIDTH / 2; b++) {
+            uint32_t pair = frame->expand[src[b]];
+            out[0] = (uint16_t)pair;
+            out[1] = (uint16_t)(pair >> 16);
+            out += 2;
+        }
+        if (LCD_WIDTH & 1) {
+            *out++ = (uint16_t)frame->expand[src[LCD_WIDTH / 2]];
+        }
+    }
+}
+
+int indexed_frame_push_begin(IndexedFrame* frame, bool swap_bytes) {
+    if (!frame->expand_valid || frame->expand_swapped != swap_bytes) {
+        build_expand(frame, swap_bytes);
+    }
+    int rows = 0;
+    for (int i = 0; i < INDEXED_DIRTY_WORDS; i++) {
+        frame->sending[i] = frame->dirty[i];
+        frame->dirty[i] = 0;
+        rows += __builtin_popcount(frame->sending[i]);
+    }
+    frame->send_y = 0;
+    frame->next_buffer = 0;
+    return rows;
+}
+
+static bool row_sending(const IndexedFrame* frame, int16_t y) {
+    return (frame->sending[y >> 5] >> (y & 31)) & 1u;
+}
+
+const uint16_t* indexed_frame_push_next(IndexedFrame* frame, int16_t* y_out, int16_t* rows_out) {
+    int16_t y = frame->send_y;
+    while (y < LCD_HEIGHT) {
+        // Skip clean rows a word at a time
+        if (frame->sending[y >> 5] == 0 && (y & 31) == 0) {
+            y += 32;
+            continue;
+        }
+        if (!row_sending(frame, y)) {
+            y++;
+            continue;
+        }
+        int16_t rows = 1;
+        while (y + rows < LCD_HEIGHT && rows < DISPLAY_INDEXED_CHUNK_ROWS && row_sending(frame, y + rows)) {
+            rows++;
+        }
+        uint16_t* out = frame->chunk[frame->next_buffer];
+        expand_rows(frame, y, rows, out);
+        frame->next_buffer ^= 1;
+        frame->send_y = y + rows;
+        *y_out = y;
+        *rows_out = rows;
+        return out;
+    }
+    frame->send_y = LCD_HEIGHT;
+    return nullptr;
+}
+
+int indexed_frame_push(IndexedFrame* frame, bool swap_bytes, IndexedPushFn push, void* context) {
+    int pushed = indexed_frame_push_begin(frame, swap_bytes);
+    int16_t y;
+    int16_t rows;
+    const uint16_t* pixels;
+    while ((pixels = indexed_frame_push_next(frame, &y, &rows)) != nullptr) {
+        push(context, y, rows, pixels);
+    }
+    return pushed;
+}
@@ -0,0 +1,124 @@
+#ifndef INDEXED_FRAME_H
+#define INDEXED_FRAME_H
+
+/*******************************************************************************
+ * Full-screen 4 bpp shadow framebuffer
+ *
+ * The UI uses fewer than 16 colors (background, border, text, zones, empty,
+ * debug), so the whole screen fits in 4 bits per pixel: 27 KB at 170x320
+ * instead of 108 KB of RGB565. Drawing writes palette indices; each changed
+ * row is marked dirty. A push expands only the dirty rows to RGB565, a few
+ * rows at a time through a byte-to-pixel-pair table, into two chunk buffers
+ * that alternate so one can be expanded while the other is on the bus.
+ *
+ * Changing a palette entry recolors every pixel of that color at the cost of
+ * one push of the rows that use it (themes, blinking).
+ ******************************************************************************/
+
+#include "config.h"
+#include <stdint.h>
+
+#define INDEXED_COLORS        16
+#define INDEXED_ROW_BYTES     ((LCD_WIDTH + 1) / 2)
+#define INDEXED_DIRTY_WORDS   ((LCD_HEIGHT + 31) / 32)
+#define INDEXED_CHUNK_PIXELS  (DISPLAY_INDEXED_CHUNK_ROWS * LCD_WIDTH)
+
+/**
+ * @brief Indexed frame (left pixel of each byte in the high nibble)
+ */
+typedef struct {
+    uint8_t pixels[LCD_HEIGHT * INDEXED_ROW_BYTES];
+    uint16_t palette[INDEXED_COLORS];   // RGB565 per index
+    uint8_t colors;                     // Palette entries in use
+    uint8_t last_index;                 // Index of last_color (lookup shortcut)
+    uint16_t last_color;
+    uint32_t dirty[INDEXED_DIRTY_WORDS];    // Rows changed since the last push
+    uint32_t expand[256];               // Byte -> two pixels (left in the low half)
+    bool expand_valid;                  // Table matches palette and byte order
+    bool expand_swapped;
+    uint16_t chunk[2][INDEXED_CHUNK_PIXELS];
+    uint32_t sending[INDEXED_DIRTY_WORDS];  // Rows of the push in progress
+    int16_t send_y;                     // Next row to look at
+    uint8_t next_buffer;                // Chunk buffer the next chunk goes into
+} IndexedFrame;
+
+/**
+ * @brief Receive one expanded chunk
+ * Chunks are full-width rows. The buffer is written again two calls later,
+ * so a DMA transfer started here must finish before the next call returns.
+ * @param context Caller data
+ * @param y First screen row
+ * @param rows Rows in the chunk
+ * @param pixels rows * LCD_WIDTH RGB565 pixels
+ */
+typedef void (*IndexedPushFn)(void* context, int16_t y, int16_t rows, const uint16_t* pixels);
+
+/**
+ * @brief Clear to one color (palette entry 0) and mark every row dirty
+ */
+void indexed_frame_init(IndexedFrame* frame, uint16_t background);
+
+/**
+ * @brief Palette index of a color
+ * New colors take the next free entry; with all 16 in use, the nearest
+ * entry is returned.
+ */
+uint8_t indexed_frame_index(IndexedFrame* frame, uint16_t color);
+
+/**
+ * @brief Fill a rectangle (clipped to the screen)
+ */
+void indexed_frame_fill(IndexedFrame* frame, int16_t x, int16_t y, int16_t w, int16_t h,
+                        uint16_t color);
+
+/**
+ * @brief Write a run of RGB565 pixels along one row (clipped to the screen)
+ */
+void indexed_frame_write(IndexedFrame* frame, int16_t x, int16_t y, int16_t n,
+                         const uint16_t* pixels);
+
+/**
+ * @brief RGB565 color of a pixel (0 off screen)
+ */
+uint16_t indexed_frame_pixel(const IndexedFrame* frame, int16_t x, int16_t y);
+
+/**
+ * @brief Replace a palette color
+ * Every pixel drawn in from takes the new color; only the rows holding it
+ * are marked dirty.
+ * @return false if from is not in the palette
+ */
+bool indexed_frame_recolor(IndexedFrame* frame, uint16_t from, uint16_t to);
+
+/**
+ * @brief Whether a row changed since the last push
+ */
+bool indexed_frame_row_dirty(const IndexedFrame* frame, int16_t y);
+
+/**
+ * @brief Expand the dirty rows and hand them out in chunks, then clear them
+ * Each run of dirty rows is split into chunks of DISPLAY_INDEXED_CHUNK_ROWS.
+ * @param swap_bytes Emit byte-swapped RGB565 (the panel's bus order)
+ * @return Rows pushed
+ */
+int indexed_frame_push(IndexedFrame* frame, bool swap_bytes, IndexedPushFn push, void* context);
+
+/**
+ * @brief Start a push one chunk at a time (see push_pipeline.h)
+ * The dirty rows move to the push; rows drawn from now on are dirty for
+ * the next one.
+ * @return Rows to push
+ */
+int indexed_frame_push_begin(IndexedFrame* frame, bool swap_bytes);
+
+/**
+ * @brief Expand the next chunk of the push started by indexed_frame_push_begin()
+ * Chunks alternate between the two buffers, so the buffer returned two
+ * calls ago must no longer be in use.
+ * @param y First screen row of the chunk
+ * @param rows Rows in the chunk
+ * @return rows * LCD_WIDTH RGB565 pixels, nullptr once every row is out
+ */
+const uint16_t* indexed_frame_push_next(IndexedFrame* frame, int16_t* y, int16_t* rows);
+
+#endif // INDEXED_FRAME_H
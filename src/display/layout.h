@@ -0,0 +1,122 @@
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+/*******************************************************************************
+ * Screen layout fixed at compile time
+ *
+ * Every widget rectangle follows from the screen size (the board's panel
+ * with SCREEN_ROTATION applied) and the number of tanks:
+ *
+ *   - bars stand side by side, centered, LAYOUT_BAR_GAP apart, each with its
+ *     gallons readout above and its percentage readout below
+ *   - segments are the longest (up to GAUGE_SEGMENT_HEIGHT_MAX) that let a
+ *     bar and both readouts fit the screen height
+ *   - the summary column sits in the gap between the first two bars
+ *   - dials are stacked on a portrait screen and side by side on a
+ *     landscape one
+ *   - the debug overlay spans the screen width, centered vertically
+ *
+ * BarLayout<> is constexpr throughout, so setup() runs no layout code, and a
+ * layout that leaves the screen or overlaps fails the build (static_asserts
+ * at the end of this file).
+ ******************************************************************************/
+
+#include "config.h"
+#include "clip_region.h"
+#include "summary.h"
+#include <stdint.h>
+
+#define LAYOUT_TANKS            2     // Gauges on the gauge page
+#define LAYOUT_TOP_MARGIN       1     // Above the gallons readouts
+#define LAYOUT_LABEL_ROWS       18    // Gallons readout (text size 2), spacing and bar border
+#define LAYOUT_PERCENT_ROWS     16    // Percentage readout (text size 2)
+#define LAYOUT_PERCENT_GAP_MIN  2     // Bar to percentage readout: border and one spare row
+#define LAYOUT_PERCENT_GAP_MAX  6
+#define LAYOUT_BAR_GAP          20    // Between neighbouring bars (holds the summary column)
+#define LAYOUT_SEGMENT_MIN      3     // Shortest segment that still reads as a bar
+#define LAYOUT_SUMMARY_DY       4     // Summary column below the top of the bars
+#define DEBUG_OVERLAY_HEIGHT    120   // Debug overlay text area (9 lines including separator)
+#define LAYOUT_OVERLAY_BORDER   3     // Overlay frame around the text area
+
+template <int ScreenW, int ScreenH, int Tanks>
+struct BarLayout {
+    static constexpr int SCREEN_W = ScreenW;
+    static constexpr int SCREEN_H = ScreenH;
+
+    // Rows: margin, gallons readout, bar, gap, percentage readout. The bar
+    // is Gauge<> inside its border: segments and gaps plus 1-pixel padding
+    static constexpr int GAUGE_Y = LAYOUT_TOP_MARGIN + LAYOUT_LABEL_ROWS;
+    static constexpr int BAR_SPACE = ScreenH - GAUGE_Y - LAYOUT_PERCENT_GAP_MIN - LAYOUT_PERCENT_ROWS;
+    static constexpr int SEGMENT_FIT =
+        (BAR_SPACE - 2 + GAUGE_SEGMENT_GAP) / GAUGE_SEGMENT_COUNT - GAUGE_SEGMENT_GAP;
+    static constexpr int SEGMENT_HEIGHT =
+        SEGMENT_FIT < GAUGE_SEGMENT_HEIGHT_MAX ? SEGMENT_FIT : GAUGE_SEGMENT_HEIGHT_MAX;
+    static constexpr int BAR_HEIGHT =
+        GAUGE_SEGMENT_COUNT * (SEGMENT_HEIGHT + GAUGE_SEGMENT_GAP) - GAUGE_SEGMENT_GAP + 2;
+    static constexpr int PERCENT_SPARE = ScreenH - GAUGE_Y - BAR_HEIGHT - LAYOUT_PERCENT_ROWS;
+    static constexpr int PERCENT_GAP =
+        PERCENT_SPARE < LAYOUT_PERCENT_GAP_MAX ? PERCENT_SPARE : LAYOUT_PERCENT_GAP_MAX;
+    static constexpr int GAUGE_ROWS = LAYOUT_LABEL_ROWS + BAR_HEIGHT + PERCENT_GAP + LAYOUT_PERCENT_ROWS;
+
+    // Columns: bars centered as a group, bounds include the 1-pixel border
+    static constexpr int ROW_WIDTH = Tanks * GAUGE_WIDTH + (Tanks - 1) * LAYOUT_BAR_GAP;
+    static constexpr int START_X = (ScreenW - ROW_WIDTH) / 2;
+    static constexpr int SUMMARY_X = START_X + GAUGE_WIDTH + (LAYOUT_BAR_GAP - SUMMARY_WIDTH) / 2;
+    static constexpr int SUMMARY_Y = GAUGE_Y + LAYOUT_SUMMARY_DY;
+
+    // Dials: a column on portrait screens, a row on landscape ones
+    static constexpr bool DIAL_COLUMN = ScreenH >= ScreenW;
+    static constexpr int DIAL_CELL_W = DIAL_COLUMN ? ScreenW : ScreenW / Tanks;
+    static constexpr int DIAL_CELL_H = DIAL_COLUMN ? ScreenH / Tanks : ScreenH;
+
+    // Debug overlay with its frame
+    static constexpr int OVERLAY_Y = (ScreenH - DEBUG_OVERLAY_HEIGHT) / 2 - LAYOUT_OVERLAY_BORDER;
+    static constexpr int OVERLAY_H = DEBUG_OVERLAY_HEIGHT + 2 * LAYOUT_OVERLAY_BORDER;
+
+    // Checks (the summary fills the columns between two bar borders)
+    static constexpr bool BARS_FIT_WIDTH = START_X >= 1 && LAYOUT_BAR_GAP >= 2;
+    static constexpr bool BARS_FIT_HEIGHT = SEGMENT_FIT >= LAYOUT_SEGMENT_MIN;
+    static constexpr bool SUMMARY_FITS = Tanks < 2 ||
+        (SUMMARY_WIDTH <= LAYOUT_BAR_GAP - 2 && SUMMARY_Y + SUMMARY_HEIGHT <= GAUGE_Y + BAR_HEIGHT);
+    static constexpr bool DIALS_FIT =
+        DIAL_CELL_W >= 2 * DIAL_RADIUS + 1 && DIAL_CELL_H >= 2 * DIAL_RADIUS + 1;
+    static constexpr bool OVERLAY_FITS = OVERLAY_Y >= 0 && OVERLAY_Y + OVERLAY_H <= ScreenH;
+
+    // Bar origin (top-left inside the border) of a tank, 0-based
+    static constexpr int16_t tank_x(int index) {
+        return (int16_t)(START_X + index * (GAUGE_WIDTH + LAYOUT_BAR_GAP));
+    }
+
+    // Dial center of a tank, 0-based
+    static constexpr int16_t dial_x(int index) {
+        return (int16_t)(DIAL_COLUMN ? ScreenW / 2 : DIAL_CELL_W / 2 + index * DIAL_CELL_W);
+    }
+    static constexpr int16_t dial_y(int index) {
+        return (int16_t)(DIAL_COLUMN ? DIAL_CELL_H / 2 + index * DIAL_CELL_H : ScreenH / 2);
+    }
+
+    static constexpr ClipRect summary() {
+        return ClipRect{(int16_t)SUMMARY_X, (int16_t)SUMMARY_Y, SUMMARY_WIDTH, SUMMARY_HEIGHT};
+    }
+    static constexpr ClipRect overlay() {
+        return ClipRect{0, (int16_t)OVERLAY_Y, (int16_t)ScreenW, (int16_t)OVERLAY_H};
+    }
+};
+
+// The layout of this build
+typedef BarLayout<LCD_WIDTH, LCD_HEIGHT, LAYOUT_TANKS> ScreenLayout;
+
+#define GAUGE_SEGMENT_HEIGHT  ScreenLayout::SEGMENT_HEIGHT
+
+static_assert(ScreenLayout::BARS_FIT_WIDTH,
+              "Bars do not fit the screen width: fewer tanks, narrower GAUGE_BAR_WIDTH or LAYOUT_BAR_GAP");
+static_assert(ScreenLayout::BARS_FIT_HEIGHT,
+              "Bars do not fit the screen height: fewer GAUGE_SEGMENTS or a portrait SCREEN_ROTATION");
+static_assert(ScreenLayout::SUMMARY_FITS,
+              "Summary column overlaps the bars: widen LAYOUT_BAR_GAP");
+static_assert(ScreenLayout::OVERLAY_FITS, "Debug overlay is taller than the screen");
+#if GAUGE_STYLE == GAUGE_STYLE_DIAL
+static_assert(ScreenLayout::DIALS_FIT, "Dials overlap or leave the screen: reduce DIAL_RADIUS");
+#endif
+
+#endif // LAYOUT_H
@@ -0,0 +1,118 @@
+#include "page_compositor.h"
+#include "display.h"
+
+typedef struct {
+    PageBackgroundFn draw;
+    int first;                          // First run in the pool
+    int count;                          // Runs cached (0 = not cached)
+    bool uncacheable;                   // Did not fit; drawn directly
+} Page;
+
+static Page pages[PAGE_MAX];
+
+#define PAGE_POOL_RUNS        (PAGE_CACHE_BYTES / (int)sizeof(DisplayRun))
+static DisplayRun pool[PAGE_POOL_RUNS];
+static int pool_used = 0;
+
+bool page_define(int page, PageBackgroundFn draw_background) {
+    if (page < 0 || page >= PAGE_MAX) {
+        return false;
+    }
+    pages[page].draw = draw_background;
+    pages[page].first = 0;
+    pages[page].count = 0;
+    pages[page].uncacheable = false;
+    return true;
+}
+
+static void draw_background(const Page* p) {
+    if (p->draw) {
+        p->draw();
+    }
+}
+
+#if PAGE_CACHE_ENABLE
+// Render the background band by band and append its runs to the pool.
+// Runs carry on across rows and bands, so plain areas stay one run.
+static bool page_encode(Page* p) {
+    static uint16_t row[LCD_WIDTH];
+    int n = pool_used;
+    uint16_t color = 0;
+    uint32_t len = 0;
+
+    for (int16_t band_y = 0; band_y < LCD_HEIGHT; band_y += PAGE_CACHE_BAND_ROWS) {
+        int16_t h = (LCD_HEIGHT - band_y < PAGE_CACHE_BAND_ROWS) ? LCD_HEIGHT - band_y : PAGE_CACHE_BAND_ROWS;
+        if (!display_canvas_begin(0, band_y, LCD_WIDTH, h)) {
+            return false;
+        }
+        draw_background(p);
+        for (int16_t r = 0; r < h; r++) {
+            display_canvas_read_row(r, row);
+            for (int16_t i = 0; i < LCD_WIDTH; i++) {
+                if (len > 0 && row[i] == color && len < 0xFFFF) {
+                    len++;
+                    continue;
+                }
+                if (len > 0) {
+                    if (n >= PAGE_POOL_RUNS) {
+                        display_canvas_discard();
+                        return false;
+                    }
+                    pool[n].count = (uint16_t)len;
+                    pool[n].color = color;
+                    n++;
+                }
+                color = row[i];
+                len = 1;
+            }
+        }
+        display_canvas_discard();
+    }
+    if (n >= PAGE_POOL_RUNS) {
+        return false;
+    }
+    pool[n].count = (uint16_t)len;
+    pool[n].color = color;
+    n++;
+
+    p->first = pool_used;
+    p->count = n - pool_used;
+    pool_used = n;
+    return true;
+}
+#endif
+
+void page_show(int page) {
+    if (page < 0 || page >= PAGE_MAX) {
+        return;
+    }
+    Page* p = &pages[page];
+#if PAGE_CACHE_ENABLE
+    if (p->count == 0 && !p->uncacheable) {
+        p->uncacheable = !page_encode(p);
+    }
+    if (p->count > 0) {
+        display_push_runs(0, 0, LCD_WIDTH, LCD_HEIGHT, pool + p->first, p->count);
+        return;
+    }
+#endif
+    display_clear(UI_COLOR_BACKGROUND);
+    draw_background(p);
+}
+
+bool page_cached(int page) {
+    return page >= 0 && page < PAGE_MAX && pages[page].count > 0;
+}
+
+uint32_t page_cache_used() {
+    return (uint32_t)pool_used * sizeof(DisplayRun);
+}
+
+void page_cache_reset() {
+    for (int i = 0; i < PAGE_MAX; i++) {
+        pages[i].first = 0;
+        pages[i].count = 0;
+        pages[i].uncacheable = false;
+    }
+    pool_used = 0;
+}
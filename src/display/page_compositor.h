@@ -0,0 +1,62 @@
+#ifndef PAGE_COMPOSITOR_H
+#define PAGE_COMPOSITOR_H
+
+/*******************************************************************************
+ * Page compositor with cached static backgrounds
+ *
+ * Each screen page splits into a static background (frames, titles, labels)
+ * and dynamic widgets that redraw themselves. The background is drawn once
+ * into the off-screen canvas, a band of rows at a time, and kept as a
+ * run-length image in a fixed RAM pool. Showing the page again restores it
+ * with one full-screen window instead of a clear plus every draw call; the
+ * dynamic widgets then paint over it.
+ *
+ * A background that does not fit the remaining pool (or a failed canvas
+ * allocation) falls back to clear and draw, so page_show() always works.
+ ******************************************************************************/
+
+#include "config.h"
+#include <stdint.h>
+
+/**
+ * @brief Draws a page's static background with the display_* calls
+ * It may be called once per encoding band and must draw the same pixels
+ * every time.
+ */
+typedef void (*PageBackgroundFn)();
+
+/**
+ * @brief Declare a page and its background
+ * Redefining a page forgets its cached image; the pool space comes back
+ * only with page_cache_reset().
+ * @param page Page id (0 to PAGE_MAX - 1)
+ * @param draw_background Static layer, or nullptr for a plain background
+ * @return false if the id is out of range
+ */
+bool page_define(int page, PageBackgroundFn draw_background);
+
+/**
+ * @brief Replace the whole screen with a page's background
+ * The first show encodes it into the cache; later shows send it as one
+ * run-length window. Afterwards the page's dynamic widgets must redraw in
+ * full (the restore counts as a screen clear).
+ * @param page Page id
+ */
+void page_show(int page);
+
+/**
+ * @brief Whether a page's background is held in the cache
+ */
+bool page_cached(int page);
+
+/**
+ * @brief Bytes of the pool in use by cached backgrounds
+ */
+uint32_t page_cache_used();
+
+/**
+ * @brief Drop every cached background (pages stay defined)
+ */
+void page_cache_reset();
+
+#endif // PAGE_COMPOSITOR_H
@@ -0,0 +1,68 @@
+#include "push_pipeline.h"
+
+void push_pipeline_init(PushPipeline* p, IndexedFrame* frame, PipelineBusyFn busy,
+                        PipelineStartFn start, PipelineDoneFn done, void* context) {
+    p->frame = frame;
+    p->busy = busy;
+    p->start = start;
+    p->done = done;
+    p->context = context;
+    p->active = false;
+    p->queued = nullptr;
+    p->queued_y = 0;
+    p->queued_rows = 0;
+    p->in_flight = false;
+    p->started_us = 0;
+    p->chunk_us = 0;
+    p->bus_us = 0;
+}
+
+bool push_pipeline_begin(PushPipeline* p, bool swap_bytes, uint32_t now_us) {
+    if (p->active) {
+        return false;
+    }
+    indexed_frame_push_begin(p->frame, swap_bytes);
+    p->active = true;
+    p->queued = nullptr;
+    p->in_flight = false;
+    p->started_us = now_us;
+    p->bus_us = 0;
+    push_pipeline_service(p, now_us);
+    return true;
+}
+
+bool push_pipeline_service(PushPipeline* p, uint32_t now_us) {
+    if (!p->active) {
+        return false;
+    }
+    bool busy = p->busy(p->context);
+    if (p->in_flight && !busy) {
+        p->bus_us += now_us - p->chunk_us;
+        p->in_flight = false;
+    }
+    if (!p->queued) {
+        p->queued = indexed_frame_push_next(p->frame, &p->queued_y, &p->queued_rows);
+    }
+    // A chunk starts only once the previous one is done, so the buffer that
+    // one used is free for the chunk expanded next
+    if (p->queued && !busy) {
+        p->start(p->context, p->queued_y, p->queued_rows, p->queued);
+        p->in_flight = true;
+        p->chunk_us = now_us;
+        p->queued = indexed_frame_push_next(p->frame, &p->queued_y, &p->queued_rows);
+    }
+    if (p->queued || p->in_flight) {
+        return true;
+    }
+    p->active = false;
+    p->done(p->context, now_us - p->started_us, p->bus_us);
+    return false;
+}
+
+bool push_pipeline_active(const PushPipeline* p) {
+    return p->active;
+}
+
+uint32_t push_pipeline_bus_us(uint32_t pixels) {
+    return (uint32_t)((uint64_t)pixels * 16 * 1000000 / LCD_SPI_WRITE_HZ);
+}
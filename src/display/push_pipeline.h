@@ -0,0 +1,93 @@
+#ifndef PUSH_PIPELINE_H
+#define PUSH_PIPELINE_H
+
+/*******************************************************************************
+ * Background push of the indexed frame
+ *
+ * A blocking push keeps the CPU waiting for every SPI transfer. Here the
+ * dirty rows of an IndexedFrame go to the bus one DMA chunk at a time and
+ * nothing waits: while one chunk transfers, the next is expanded into the
+ * other chunk buffer. push_pipeline_service() is called by whatever sees a
+ * transfer finish (the display's push task on the panel, the modelled bus
+ * on the host): it starts the prepared chunk at once and prepares the one
+ * after it, so the bus stays busy while loop() runs sensors and UI logic.
+ *
+ * The bus is reached through callbacks and time is passed in (microseconds),
+ * so the same pipeline runs on the panel and on the host's modelled bus.
+ * Bus time is measured, not derived from the write clock: each chunk counts
+ * from its start to the service call that finds the bus free again.
+ ******************************************************************************/
+
+#include "indexed_frame.h"
+#include <stdint.h>
+
+/**
+ * @brief Whether a transfer is still running
+ */
+typedef bool (*PipelineBusyFn)(void* context);
+
+/**
+ * @brief Start one transfer and return without waiting
+ * The pixels stay untouched until the transfer is done.
+ */
+typedef void (*PipelineStartFn)(void* context, int16_t y, int16_t rows, const uint16_t* pixels);
+
+/**
+ * @brief The last transfer of a push has finished
+ * @param push_us push_pipeline_begin() to the service call that saw it done
+ * @param bus_us Measured time the push's chunks were on the bus
+ */
+typedef void (*PipelineDoneFn)(void* context, uint32_t push_us, uint32_t bus_us);
+
+/**
+ * @brief Pipeline state (one per frame)
+ */
+typedef struct {
+    IndexedFrame* frame;
+    PipelineBusyFn busy;
+    PipelineStartFn start;
+    PipelineDoneFn done;
+    void* context;
+    bool active;                        // A push is in progress
+    const uint16_t* queued;             // Expanded chunk waiting for the bus
+    int16_t queued_y;
+    int16_t queued_rows;
+    bool in_flight;                     // A started chunk not yet seen done
+    uint32_t started_us;
+    uint32_t chunk_us;                  // When the chunk in flight started
+    uint32_t bus_us;                    // Measured bus time of this push so far
+} PushPipeline;
+
+/**
+ * @brief Attach a pipeline to a frame and a bus
+ */
+void push_pipeline_init(PushPipeline* p, IndexedFrame* frame, PipelineBusyFn busy,
+                        PipelineStartFn start, PipelineDoneFn done, void* context);
+
+/**
+ * @brief Start pushing the frame's dirty rows
+ * The first chunk goes out at once if the bus is free. Rows drawn from now
+ * on are left for the next push.
+ * @return false if a push is still in progress
+ */
+bool push_pipeline_begin(PushPipeline* p, bool swap_bytes, uint32_t now_us);
+
+/**
+ * @brief Move the push along (call when a transfer has finished)
+ * Starts the prepared chunk if the bus is free and expands the next one;
+ * calls done once the last transfer has finished.
+ * @return true while the push is in progress
+ */
+bool push_pipeline_service(PushPipeline* p, uint32_t now_us);
+
+/**
+ * @brief Whether a push is in progress
+ */
+bool push_pipeline_active(const PushPipeline* p);
+
+/**
+ * @brief Bus time of a number of pixels at the panel's write clock
+ */
+uint32_t push_pipeline_bus_us(uint32_t pixels);
+
+#endif // PUSH_PIPELINE_H
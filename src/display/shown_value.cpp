@@ -0,0 +1,47 @@
+#include "shown_value.h"
+#include <math.h>
+
+void shown_value_init(ShownValue* value, float step, float band) {
+    value->step = step;
+    value->band = band;
+    value->level = 0;
+    value->direction = 0;
+    value->valid = false;
+}
+
+void shown_value_set(ShownValue* value, int32_t level) {
+    value->level = level;
+    value->direction = 0;
+    value->valid = true;
+}
+
+bool shown_value_update(ShownValue* value, float input) {
+    int32_t level = shown_value_round(input, value->step);
+    if (!value->valid) {
+        shown_value_set(value, level);
+        return true;
+    }
+    if (level == value->level) {
+        return false;
+    }
+    
+    int8_t direction = (level > value->level) ? 1 : -1;
+    if (direction == -value->direction) {
+        // Turning back: only once past the boundary by the band
+        float distance = fabsf(input / value->step - (float)value->level);
+        if (distance <= 0.5f + value->band) {
+            return false;
+        }
+    }
+    value->level = level;
+    value->direction = direction;
+    return true;
+}
+
+void shown_value_invalidate(ShownValue* value) {
+    value->valid = false;
+}
+
+int32_t shown_value_round(float input, float step) {
+    return (int32_t)floorf(input / step + 0.5f);
+}
@@ -0,0 +1,65 @@
+#ifndef SHOWN_VALUE_H
+#define SHOWN_VALUE_H
+
+/*******************************************************************************
+ * Display hysteresis for on-screen values
+ *
+ * Every number or bar the screen shows is a rounded version of a noisy
+ * input. Plain rounding flips back and forth whenever the input sits on a
+ * rounding boundary, so the field is repainted for noise. A ShownValue
+ * follows plain rounding while the input keeps moving the same way, but
+ * turning back needs the input to pass the boundary by a band:
+ *
+ *   after a rise, level L is kept while input / step >= L - 0.5 - band
+ *   (and the mirror image after a fall)
+ *
+ * So a steady drain or a tween still lands on the exact rounded level,
+ * while noise across a boundary no longer toggles it. With band 0 this is
+ * plain rounding. Step is in the value's own units (a bar pixel, a gallon,
+ * 0.01 V, ...); band is a fraction of a step.
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/**
+ * @brief One displayed value
+ */
+typedef struct {
+    float step;                         // Input units per shown level
+    float band;                         // Extra travel past the boundary, in steps
+    int32_t level;                      // Level on screen
+    int8_t direction;                   // Last change: +1 up, -1 down, 0 none yet
+    bool valid;                         // Something is on screen
+} ShownValue;
+
+/**
+ * @brief Set up a value with nothing shown
+ * @param value Value state
+ * @param step Input units per displayed level (e.g. 1 for whole percent)
+ * @param band Hysteresis in steps (0 = plain rounding)
+ */
+void shown_value_init(ShownValue* value, float step, float band);
+
+/**
+ * @brief Record a level as drawn (a full redraw, which rounds plainly)
+ * Either direction may follow without hysteresis.
+ */
+void shown_value_set(ShownValue* value, int32_t level);
+
+/**
+ * @brief Feed a new input
+ * @return true if the shown level changed (or nothing was shown yet)
+ */
+bool shown_value_update(ShownValue* value, float input);
+
+/**
+ * @brief Forget what is shown so the next update reports a change
+ */
+void shown_value_invalidate(ShownValue* value);
+
+/**
+ * @brief Pure calculation: level an input rounds to
+ */
+int32_t shown_value_round(float input, float step);
+
+#endif // SHOWN_VALUE_H
@@ -0,0 +1,103 @@
+#include "summary.h"
+#include "display.h"
+#include "text_format.h"
+
+// Last rendered view (only redraw on change)
+static TankSummaryView last_view;
+static bool summary_drawn = false;
+
+// Clear one text line of the summary column
+static void summary_clear_line(int16_t x, int16_t y) {
+    display_fill_rect(x, y, SUMMARY_WIDTH, 8, UI_COLOR_BACKGROUND);
+}
+
+static void summary_print_line(int16_t x, int16_t y, const char* text, uint16_t color) {
+    summary_clear_line(x, y);
+    display_set_text_size(1);
+    display_set_text_color(color);
+    display_set_cursor(x, y);
+    display_print(text);
+}
+
+// Format 0-999 right-aligned into 3 characters
+static void format_3digits(char* buf, int value) {
+    if (value < 0) value = 0;
+    if (value > 999) value = 999;
+    text_format_int(buf, 4, value, 3, ' ', TEXT_ALIGN_RIGHT);
+}
+
+void summary_invalidate() {
+    summary_drawn = false;
+}
+
+void summary_draw(int16_t x, int16_t y, const TankAggregate* agg) {
+    TankSummaryView view = tank_aggregate_view(agg);
+
+    if (summary_drawn && tank_summary_view_equal(&view, &last_view)) {
+        return;  // Nothing changed, skip redraw
+    }
+
+    char buf[4];
+    int16_t line_y = y;
+
+    // Static labels only on first draw
+    if (!summary_drawn) {
+        summary_print_line(x, line_y, "TOT", COLOR_SEGMENT_LINE);
+        summary_print_line(x, line_y + 2 * SUMMARY_LINE_SPACING, "BAL", COLOR_SEGMENT_LINE);
+        summary_print_line(x, line_y + 4 * SUMMARY_LINE_SPACING, "XFR", COLOR_SEGMENT_LINE);
+    }
+    line_y += SUMMARY_LINE_SPACING;
+
+    // Total gallons
+    if (!summary_drawn || view.total_gallons != last_view.total_gallons) {
+        format_3digits(buf, view.total_gallons);
+        summary_print_line(x, line_y, buf, UI_COLOR_TEXT);
+    }
+    line_y += 2 * SUMMARY_LINE_SPACING;
+
+    // Imbalance: "L12" = left heavier by 12 gallons, "R 3" = right heavier
+    if (!summary_drawn || view.imbalance_gallons != last_view.imbalance_gallons) {
+        int imbalance = view.imbalance_gallons;
+        char side = ' ';
+        if (imbalance > 0) {
+            side = 'L';
+        } else if (imbalance < 0) {
+            side = 'R';
+            imbalance = -imbalance;
+        }
+        format_3digits(buf, imbalance > 99 ? 99 : imbalance);
+        buf[0] = side;
+        summary_print_line(x, line_y, buf, UI_COLOR_TEXT);
+    }
+    line_y += 2 * SUMMARY_LINE_SPACING;
+
+    // Transfer direction arrows and rate
+    if (!summary_drawn || view.transfer_dir != last_view.transfer_dir ||
+        view.transfer_tenths != last_view.transfer_tenths) {
+        const char* arrows = "---";
+        if (view.transfer_dir > 0) {
+            arrows = ">>>";
+        } else if (view.transfer_dir < 0) {
+            arrows = "<<<";
+        }
+        summary_print_line(x, line_y, arrows,
+                           view.transfer_dir != 0 ? UI_COLOR_YELLOW : COLOR_SEGMENT_LINE);
+
+        if (view.transfer_dir == 0) {
+            summary_clear_line(x, line_y + SUMMARY_LINE_SPACING);
+        } else {
+            int tenths = view.transfer_tenths;
+            if (tenths < 100) {
+                // "1.2" gal/min
+                text_format_fixed(buf, sizeof(buf), tenths, 1, 0, ' ', TEXT_ALIGN_LEFT);
+            } else {
+                // Whole gal/min when 10 or more
+                format_3digits(buf, (tenths + 5) / 10);
+            }
+            summary_print_line(x, line_y + SUMMARY_LINE_SPACING, buf, UI_COLOR_YELLOW);
+        }
+    }
+
+    last_view = view;
+    summary_drawn = true;
+}
@@ -0,0 +1,30 @@
+#ifndef SUMMARY_H
+#define SUMMARY_H
+
+#include "config.h"
+#include "../sensor/tank_aggregate.h"
+#include <stdint.h>
+
+// Summary column geometry (text size 1 = 6x8 per character)
+#define SUMMARY_CHARS         3       // Characters per line
+#define SUMMARY_WIDTH         (SUMMARY_CHARS * 6)
+#define SUMMARY_LINE_SPACING  10      // Pixels between lines
+#define SUMMARY_LINES         7       // TOT, value, BAL, value, XFR, arrows, rate
+#define SUMMARY_HEIGHT        (SUMMARY_LINES * SUMMARY_LINE_SPACING)
+
+/**
+ * @brief Draw the multi-tank summary widget (total / balance / transfer)
+ * Redraws only the lines whose quantized value changed since the last call.
+ * @param x X position of widget left edge
+ * @param y Y position of widget top edge
+ * @param agg Aggregated tank state
+ */
+void summary_draw(int16_t x, int16_t y, const TankAggregate* agg);
+
+/**
+ * @brief Force the next summary_draw() to render everything
+ * Call after the screen has been cleared
+ */
+void summary_invalidate();
+
+#endif // SUMMARY_H
@@ -0,0 +1,108 @@
+#include "text_format.h"
+
+static const int32_t pow10_table[TEXT_DECIMALS_MAX + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000
+};
+
+// ============================================================================
+// Formatting
+// ============================================================================
+
+// Write digits (and sign) into a field of at least width characters
+static int emit(char* buf, int size, bool negative, const char* digits, int count,
+                int width, char pad, uint8_t align) {
+    int body = count + (negative ? 1 : 0);
+    int len = (body > width) ? body : width;
+    if (len + 1 > size) {
+        if (size > 0) buf[0] = '\0';
+        return 0;
+    }
+
+    int fill = len - body;
+    int lead = 0;                       // Zero padding goes after the sign
+    if (pad != '0' && align == TEXT_ALIGN_RIGHT) {
+        lead = fill;
+    } else if (pad != '0' && align == TEXT_ALIGN_CENTER) {
+        lead = fill / 2;
+    }
+
+    int i = 0;
+    for (; i < lead; i++) buf[i] = pad;
+    if (negative) buf[i++] = '-';
+    if (pad == '0') {
+        for (int k = 0; k < fill; k++) buf[i++] = '0';
+    }
+    for (int k = 0; k < count; k++) buf[i++] = digits[k];
+    while (i < len) buf[i++] = pad;
+    buf[len] = '\0';
+    return len;
+}
+
+int text_format_fixed(char* buf, int size, int32_t scaled, uint8_t decimals,
+                      int width, char pad, uint8_t align) {
+    if (decimals > TEXT_DECIMALS_MAX) decimals = TEXT_DECIMALS_MAX;
+    bool negative = scaled < 0;
+    uint32_t magnitude = negative ? 0u - (uint32_t)scaled : (uint32_t)scaled;
+
+    // Digits from the least significant end, point after the decimals
+    char digits[TEXT_NUMBER_MAX];
+    char* p = digits + sizeof(digits);
+    for (uint8_t i = 0; i < decimals; i++) {
+        *--p = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    }
+    if (decimals > 0) {
+        *--p = '.';
+    }
+    do {
+        *--p = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    return emit(buf, size, negative, p, (int)(digits + sizeof(digits) - p), width, pad, align);
+}
+
+int text_format_int(char* buf, int size, int32_t value, int width, char pad, uint8_t align) {
+    return text_format_fixed(buf, size, value, 0, width, pad, align);
+}
+
+int32_t text_scale_float(float value, uint8_t decimals) {
+    if (decimals > TEXT_DECIMALS_MAX) decimals = TEXT_DECIMALS_MAX;
+    float scaled = value * (float)pow10_table[decimals];
+    scaled += (scaled < 0.0f) ? -0.5f : 0.5f;
+    if (scaled >= 2147483647.0f) return INT32_MAX;
+    if (scaled <= -2147483648.0f) return INT32_MIN;
+    return (int32_t)scaled;
+}
+
+int text_format_float(char* buf, int size, float value, uint8_t decimals,
+                      int width, char pad, uint8_t align) {
+    return text_format_fixed(buf, size, text_scale_float(value, decimals), decimals,
+                             width, pad, align);
+}
+
+int text_append(char* buf, int size, int len, const char* text) {
+    int n = 0;
+    while (text[n]) n++;
+    if (len + n + 1 > size) {
+        return 0;
+    }
+    for (int i = 0; i <= n; i++) {
+        buf[len + i] = text[i];
+    }
+    return len + n;
+}
+
+// ============================================================================
+// Metrics
+// ============================================================================
+
+int16_t text_width(const GlyphFont* font, const char* text, uint8_t size) {
+    int16_t width = 0;
+    for (const char* c = text; *c; c++) {
+        if ((uint8_t)*c >= ' ') {
+            width += font->cell_w;
+        }
+    }
+    return width * size;
+}
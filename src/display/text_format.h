@@ -0,0 +1,78 @@
+#ifndef TEXT_FORMAT_H
+#define TEXT_FORMAT_H
+
+/*******************************************************************************
+ * Allocation-free number formatting for on-screen text
+ *
+ * Integers and fixed-point decimals are written into caller buffers with
+ * optional padding and alignment, using integer arithmetic only. A decimal is
+ * passed as a scaled integer (12.5 with 1 decimal is 125); floats are
+ * converted once with a single multiply and round, instead of the digit-by-
+ * digit division loops of printf or Arduino Print.
+ *
+ * Pixel widths come from a GlyphFont's metrics, so a different font only
+ * needs a new GlyphFont.
+ ******************************************************************************/
+
+#include "glyph_cache.h"
+#include <stdint.h>
+
+#define TEXT_DECIMALS_MAX     6       // Decimal places a fixed-point value can have
+#define TEXT_NUMBER_MAX       20      // Longest unpadded number ("-2147483.648", ...)
+
+// Alignment of a number within its field width
+#define TEXT_ALIGN_LEFT       0
+#define TEXT_ALIGN_RIGHT      1
+#define TEXT_ALIGN_CENTER     2
+
+/**
+ * @brief Format an integer
+ * @param buf Output buffer (always NUL-terminated when size > 0)
+ * @param size Capacity of buf including the NUL
+ * @param value Value
+ * @param width Minimum field width (0 = as long as needed)
+ * @param pad Fill character; '0' pads between the sign and the digits
+ * @param align TEXT_ALIGN_* (zero padding is always right-aligned)
+ * @return Characters written, 0 if the text does not fit
+ */
+int text_format_int(char* buf, int size, int32_t value, int width, char pad, uint8_t align);
+
+/**
+ * @brief Format a fixed-point decimal
+ * @param scaled Value times 10^decimals (e.g. 125 with 1 decimal = "12.5")
+ * @param decimals Digits after the point (0 - TEXT_DECIMALS_MAX)
+ * Other parameters and return value as text_format_int()
+ */
+int text_format_fixed(char* buf, int size, int32_t scaled, uint8_t decimals,
+                      int width, char pad, uint8_t align);
+
+/**
+ * @brief Format a float rounded to a number of decimals
+ * Same as text_format_fixed(text_scale_float(value, decimals), decimals, ...).
+ */
+int text_format_float(char* buf, int size, float value, uint8_t decimals,
+                      int width, char pad, uint8_t align);
+
+/**
+ * @brief Convert a float to fixed point, rounding half away from zero
+ * @return value * 10^decimals, clamped to the int32_t range
+ */
+int32_t text_scale_float(float value, uint8_t decimals);
+
+/**
+ * @brief Append a string to formatted text
+ * @param len Current length of the text in buf
+ * @return New length, 0 if the result does not fit (buf is left unchanged)
+ */
+int text_append(char* buf, int size, int len, const char* text);
+
+/**
+ * @brief Width of a string in pixels (sum of the font's advances)
+ * Control characters take no space.
+ * @param font Font metrics
+ * @param text Text string
+ * @param size Integer scale factor
+ */
+int16_t text_width(const GlyphFont* font, const char* text, uint8_t size);
+
+#endif // TEXT_FORMAT_H
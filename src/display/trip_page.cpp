@@ -0,0 +1,98 @@
+#include "trip_page.h"
+#include "display.h"
+#include "asset_data.h"
+#include "text_format.h"
+
+// Page layout (portrait 170x320)
+#define TRIP_PAGE_X           8       // Left margin
+#define TRIP_TITLE_Y          6       // "TRIP" title
+#define TRIP_FIRST_ROW_Y      30      // First label/value row
+#define TRIP_ROW_SPACING      32      // Label (size 1) + value (size 2) + gap
+#define TRIP_VALUE_OFFSET     10      // Value below its label
+#define TRIP_VALUE_HEIGHT     16      // Size 2 font height
+
+// Displayed rows
+enum {
+    TRIP_ROW_MILES = 0,
+    TRIP_ROW_FUEL,
+    TRIP_ROW_MPG,
+    TRIP_ROW_RANGE,
+    TRIP_ROW_LIFE_MILES,
+    TRIP_ROW_LIFE_FUEL,
+    TRIP_ROW_LIFE_MPG,
+    TRIP_ROW_COUNT
+};
+
+static const char* const trip_row_labels[TRIP_ROW_COUNT] = {
+    "TRIP MILES", "FUEL USED", "MPG", "RANGE",
+    "TOTAL MILES", "TOTAL FUEL", "AVG MPG"
+};
+
+// Lifetime rows start below a separator
+static int16_t trip_row_y(int row) {
+    int16_t y = TRIP_FIRST_ROW_Y + row * TRIP_ROW_SPACING;
+    if (row >= TRIP_ROW_LIFE_MILES) {
+        y += 12;
+    }
+    return y;
+}
+
+// Last displayed value per row, scaled to its decimals (redraw on change)
+static int32_t last_scaled[TRIP_ROW_COUNT];
+static bool trip_page_drawn = false;
+
+void trip_page_invalidate() {
+    trip_page_drawn = false;
+}
+
+static void trip_page_value(int row, float value, int decimals, const char* suffix) {
+    int32_t scaled = text_scale_float(value, (uint8_t)decimals);
+
+    if (trip_page_drawn && scaled == last_scaled[row]) {
+        return;  // Same digits, skip redraw
+    }
+    last_scaled[row] = scaled;
+
+    int16_t y = trip_row_y(row) + TRIP_VALUE_OFFSET;
+    display_fill_rect(TRIP_PAGE_X, y, LCD_WIDTH - 2 * TRIP_PAGE_X, TRIP_VALUE_HEIGHT,
+                      UI_COLOR_BACKGROUND);
+    display_set_text_size(2);
+    display_set_text_color(UI_COLOR_TEXT);
+    display_set_cursor(TRIP_PAGE_X, y);
+    char buf[TEXT_NUMBER_MAX + 1];
+    text_format_fixed(buf, sizeof(buf), scaled, (uint8_t)decimals, 0, ' ', TEXT_ALIGN_LEFT);
+    display_print(buf);
+    display_print(suffix);
+}
+
+void trip_page_draw_background() {
+    // Static page furniture - title, separators and labels
+    display_set_text_size(2);
+    display_set_text_color(UI_COLOR_DEBUG);
+    display_set_cursor(TRIP_PAGE_X, TRIP_TITLE_Y);
+    display_print("TRIP");
+    asset_draw(&asset_fuel_pump, LCD_WIDTH - TRIP_PAGE_X - asset_fuel_pump.width, TRIP_TITLE_Y);
+    display_draw_hline(0, TRIP_TITLE_Y + 19, LCD_WIDTH, UI_COLOR_DEBUG);
+
+    int16_t sep_y = trip_row_y(TRIP_ROW_LIFE_MILES) - 8;
+    display_draw_hline(0, sep_y, LCD_WIDTH, COLOR_SEGMENT_LINE);
+
+    display_set_text_size(1);
+    display_set_text_color(COLOR_SEGMENT_LINE);
+    for (int row = 0; row < TRIP_ROW_COUNT; row++) {
+        display_set_cursor(TRIP_PAGE_X, trip_row_y(row));
+        display_print(trip_row_labels[row]);
+    }
+}
+
+void trip_page_draw(const TripComputer* tc, float remaining_gallons) {
+    trip_page_value(TRIP_ROW_MILES, trip_get_miles(&tc->trip), 1, " mi");
+    trip_page_value(TRIP_ROW_FUEL, trip_get_gallons(&tc->trip), 2, " gal");
+    trip_page_value(TRIP_ROW_MPG, trip_get_mpg(&tc->trip), 1, "");
+    trip_page_value(TRIP_ROW_RANGE, trip_get_range_miles(tc, remaining_gallons), 0, " mi");
+    trip_page_value(TRIP_ROW_LIFE_MILES, trip_get_miles(&tc->lifetime), 0, " mi");
+    trip_page_value(TRIP_ROW_LIFE_FUEL, trip_get_gallons(&tc->lifetime), 1, " gal");
+    trip_page_value(TRIP_ROW_LIFE_MPG, trip_get_mpg(&tc->lifetime), 1, "");
+
+    trip_page_drawn = true;
+}
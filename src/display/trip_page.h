@@ -0,0 +1,28 @@
+#ifndef TRIP_PAGE_H
+#define TRIP_PAGE_H
+
+#include "config.h"
+#include "../trip/trip_computer.h"
+#include <stdint.h>
+
+/**
+ * @brief Draw the static part of the trip page (title, separators, labels)
+ * This is the page's background layer (page_compositor.h).
+ */
+void trip_page_draw_background();
+
+/**
+ * @brief Draw the trip computer values (distance, fuel used, economy, range)
+ * Only values whose displayed digits changed are redrawn.
+ * @param tc Trip computer state
+ * @param remaining_gallons Fuel currently in both tanks (for range)
+ */
+void trip_page_draw(const TripComputer* tc, float remaining_gallons);
+
+/**
+ * @brief Force the next trip_page_draw() to render every value
+ * Call after the page background has been shown
+ */
+void trip_page_invalidate();
+
+#endif // TRIP_PAGE_H
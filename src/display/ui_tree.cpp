@@ -0,0 +1,271 @@
+#include "ui_tree.h"
+#include "display.h"
+
+static_assert(UI_WIDGET_MAX <= 32, "UI tree slots are bits of a uint32_t");
+
+static UiStats stats = {0, 0, 0, 0};
+
+// ============================================================================
+// Rect helpers
+// ============================================================================
+
+static bool rect_intersect(const ClipRect* a, const ClipRect* b, ClipRect* out) {
+    int16_t x0 = a->x > b->x ? a->x : b->x;
+    int16_t y0 = a->y > b->y ? a->y : b->y;
+    int16_t x1 = (a->x + a->w < b->x + b->w) ? a->x + a->w : b->x + b->w;
+    int16_t y1 = (a->y + a->h < b->y + b->h) ? a->y + a->h : b->y + b->h;
+    if (x1 <= x0 || y1 <= y0) {
+        return false;
+    }
+    *out = {x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+    return true;
+}
+
+// Overlapping or sharing an edge (merging those never adds uncovered area
+// beyond the bounding box)
+static bool rect_touch(const ClipRect* a, const ClipRect* b) {
+    return a->x <= b->x + b->w && b->x <= a->x + a->w &&
+           a->y <= b->y + b->h && b->y <= a->y + a->h;
+}
+
+static ClipRect rect_union(const ClipRect* a, const ClipRect* b) {
+    int16_t x0 = a->x < b->x ? a->x : b->x;
+    int16_t y0 = a->y < b->y ? a->y : b->y;
+    int16_t x1 = (a->x + a->w > b->x + b->w) ? a->x + a->w : b->x + b->w;
+    int16_t y1 = (a->y + a->h > b->y + b->h) ? a->y + a->h : b->y + b->h;
+    ClipRect r = {x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+    return r;
+}
+
+static bool rect_contains(const ClipRect* outer, const ClipRect* inner) {
+    return inner->x >= outer->x && inner->y >= outer->y &&
+           inner->x + inner->w <= outer->x + outer->w &&
+           inner->y + inner->h <= outer->y + outer->h;
+}
+
+static int32_t rect_area(const ClipRect* r) {
+    return (int32_t)r->w * r->h;
+}
+
+// Clip a rect to the screen; false if nothing is left
+static bool rect_on_screen(ClipRect* r) {
+    const ClipRect screen = {0, 0, LCD_WIDTH, LCD_HEIGHT};
+    return r->w > 0 && r->h > 0 && rect_intersect(r, &screen, r);
+}
+
+// ============================================================================
+// Tree
+// ============================================================================
+
+// Widgets whose bounds touch any row band of a rect
+static uint32_t band_slots(const UiTree* tree, const ClipRect* r) {
+    uint32_t slots = 0;
+    for (int b = r->y / UI_BAND_ROWS; b <= (r->y + r->h - 1) / UI_BAND_ROWS; b++) {
+        slots |= tree->bands[b];
+    }
+    return slots;
+}
+
+static void build_bands(UiTree* tree) {
+    for (int b = 0; b < UI_BANDS; b++) {
+        tree->bands[b] = 0;
+    }
+    for (int i = 0; i < tree->count; i++) {
+        const ClipRect* r = &tree->widgets[i]->bounds;
+        if (r->w <= 0 || r->h <= 0) {
+            continue;
+        }
+        for (int b = r->y / UI_BAND_ROWS; b <= (r->y + r->h - 1) / UI_BAND_ROWS; b++) {
+            tree->bands[b] |= 1u << i;
+        }
+    }
+}
+
+// Open a gap at slot pos in a bitmask
+static uint32_t mask_insert(uint32_t mask, int pos) {
+    uint32_t low = mask & ((1u << pos) - 1);
+    return low | ((mask & ~low) << 1);
+}
+
+void ui_init(UiTree* tree) {
+    tree->count = 0;
+    tree->visible = 0;
+    tree->dirty = 0;
+    tree->damage_count = 0;
+    build_bands(tree);
+}
+
+bool ui_add(UiTree* tree, UiWidget* widget) {
+    if (tree->count >= UI_WIDGET_MAX) {
+        return false;
+    }
+    if (!rect_on_screen(&widget->bounds)) {
+        widget->bounds.w = 0;
+        widget->bounds.h = 0;
+    }
+
+    int pos = tree->count;
+    while (pos > 0 && tree->widgets[pos - 1]->z > widget->z) {
+        tree->widgets[pos] = tree->widgets[pos - 1];
+        tree->widgets[pos]->slot = (uint8_t)pos;
+        pos--;
+    }
+    tree->widgets[pos] = widget;
+    widget->slot = (uint8_t)pos;
+    tree->count++;
+
+    tree->visible = mask_insert(tree->visible, pos);
+    tree->dirty = mask_insert(tree->dirty, pos);
+    build_bands(tree);
+    return true;
+}
+
+void ui_set_visible(UiTree* tree, UiWidget* widget, bool visible) {
+    uint32_t bit = 1u << widget->slot;
+    if (((tree->visible & bit) != 0) == visible) {
+        return;
+    }
+    tree->visible ^= bit;
+    ui_damage(tree, widget->bounds.x, widget->bounds.y, widget->bounds.w, widget->bounds.h);
+}
+
+bool ui_visible(const UiTree* tree, const UiWidget* widget) {
+    return (tree->visible & (1u << widget->slot)) != 0;
+}
+
+void ui_mark_dirty(UiTree* tree, UiWidget* widget) {
+    tree->dirty |= 1u << widget->slot;
+}
+
+bool ui_pending(const UiTree* tree) {
+    return (tree->dirty & tree->visible) != 0 || tree->damage_count > 0;
+}
+
+// ============================================================================
+// Damage
+// ============================================================================
+
+static void damage_remove(UiTree* tree, int i) {
+    tree->damage[i] = tree->damage[--tree->damage_count];
+}
+
+void ui_damage(UiTree* tree, int16_t x, int16_t y, int16_t w, int16_t h) {
+    ClipRect r = {x, y, w, h};
+    if (!rect_on_screen(&r)) {
+        return;
+    }
+
+    for (;;) {
+        // Absorb every rect it touches (the union may reach further ones)
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (int i = 0; i < tree->damage_count; i++) {
+                if (rect_touch(&tree->damage[i], &r)) {
+                    r = rect_union(&tree->damage[i], &r);
+                    damage_remove(tree, i);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+        if (tree->damage_count < UI_DAMAGE_MAX) {
+            tree->damage[tree->damage_count++] = r;
+            return;
+        }
+
+        // List full: merge with the rect whose bounding box grows least
+        int best = 0;
+        int32_t best_growth = INT32_MAX;
+        for (int i = 0; i < tree->damage_count; i++) {
+            ClipRect u = rect_union(&tree->damage[i], &r);
+            int32_t growth = rect_area(&u) - rect_area(&tree->damage[i]);
+            if (growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
+        }
+        r = rect_union(&tree->damage[best], &r);
+        damage_remove(tree, best);
+    }
+}
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
+// Add part to a slot's damaged area
+static void slot_damage(uint32_t* damaged, ClipRect* area, int slot, const ClipRect* part) {
+    uint32_t bit = 1u << slot;
+    area[slot] = (*damaged & bit) ? rect_union(&area[slot], part) : *part;
+    *damaged |= bit;
+}
+
+int ui_render(UiTree* tree) {
+    stats = {0, 0, 0, 0};
+
+    // Visible widgets under each damage rect repaint their share of it
+    uint32_t damaged = 0;
+    ClipRect area[UI_WIDGET_MAX];
+    for (int d = 0; d < tree->damage_count; d++) {
+        const ClipRect* rect = &tree->damage[d];
+        stats.damage_rects++;
+        stats.damage_pixels += rect_area(rect);
+
+        uint32_t near = band_slots(tree, rect) & tree->visible;
+        while (near) {
+            int i = __builtin_ctz(near);
+            near &= near - 1;
+            ClipRect part;
+            if (rect_intersect(&tree->widgets[i]->bounds, rect, &part)) {
+                slot_damage(&damaged, area, i, &part);
+            }
+        }
+    }
+
+    // Bottom to top; a widget above may join the set while this runs
+    uint32_t pending = (tree->dirty & tree->visible) | damaged;
+    while (pending) {
+        int i = __builtin_ctz(pending);
+        pending &= pending - 1;
+        UiWidget* widget = tree->widgets[i];
+
+        // Keep off visible widgets above that will not repaint the overlap
+        int pushed = 0;
+        uint32_t above = band_slots(tree, &widget->bounds) & tree->visible & ~((2u << i) - 1);
+        while (above) {
+            int j = __builtin_ctz(above);
+            above &= above - 1;
+            ClipRect overlap;
+            if (!rect_intersect(&widget->bounds, &tree->widgets[j]->bounds, &overlap)) {
+                continue;
+            }
+            if ((damaged & (1u << j)) && rect_contains(&area[j], &overlap)) {
+                continue;
+            }
+            if (display_clip_exclude_push(overlap.x, overlap.y, overlap.w, overlap.h)) {
+                pushed++;
+                stats.exclusions++;
+            } else {
+                // Clip stack full: the widget above repaints over this one
+                slot_damage(&damaged, area, j, &overlap);
+                pending |= 1u << j;
+            }
+        }
+
+        widget->draw(widget, (damaged & (1u << i)) ? &area[i] : nullptr);
+        stats.widgets_drawn++;
+
+        while (pushed--) {
+            display_clip_exclude_pop();
+        }
+    }
+
+    tree->dirty = 0;
+    tree->damage_count = 0;
+    return stats.widgets_drawn;
+}
+
+UiStats ui_stats_get() {
+    return stats;
+}
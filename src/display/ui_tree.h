@@ -0,0 +1,129 @@
+#ifndef UI_TREE_H
+#define UI_TREE_H
+
+/*******************************************************************************
+ * Retained widget tree with damage tracking
+ *
+ * Every screen element (page background, gauges, summary column, pages,
+ * debug overlay) is a widget with fixed bounds and a z-order. Widgets do
+ * not draw when their values change; they are marked dirty, and once per
+ * frame ui_render() draws what is needed:
+ *
+ *   - dirty widgets redraw incrementally (only what changed since last time)
+ *   - damaged screen areas (a widget shown or hidden, a page change) are
+ *     merged into a few rects, and every visible widget under them repaints
+ *     its part in full, bottom to top
+ *
+ * While a widget draws, the visible widgets above it that are not being
+ * repainted are excluded on the clip stack, so overlap is resolved by
+ * z-order alone. Candidates are found through a row-band index and dirty
+ * bitmasks, so the per-frame cost follows what changed rather than how
+ * many widgets exist.
+ ******************************************************************************/
+
+#include "config.h"
+#include "clip_region.h"
+#include <stdint.h>
+
+#define UI_BANDS              ((LCD_HEIGHT + UI_BAND_ROWS - 1) / UI_BAND_ROWS)
+
+typedef struct UiWidget UiWidget;
+
+/**
+ * @brief Draw a widget
+ * @param widget The widget (context in widget->context)
+ * @param damage nullptr: redraw only what changed since the last draw.
+ *               Otherwise: also repaint everything inside this rect
+ *               (repainting more of the widget's own bounds is allowed).
+ */
+typedef void (*UiDrawFn)(UiWidget* widget, const ClipRect* damage);
+
+/**
+ * @brief One widget (owned by the caller, registered with ui_add())
+ */
+struct UiWidget {
+    ClipRect bounds;                    // Screen area the widget paints
+    int8_t z;                           // Higher draws on top
+    UiDrawFn draw;
+    void* context;                      // Free for the draw function
+    uint8_t slot;                       // Position in the tree (set by ui_add)
+};
+
+/**
+ * @brief Widgets and pending damage
+ */
+typedef struct {
+    UiWidget* widgets[UI_WIDGET_MAX];   // Bottom to top
+    uint8_t count;
+    uint32_t visible;                   // Bit per slot
+    uint32_t dirty;                     // Slots marked for an incremental draw
+    uint32_t bands[UI_BANDS];           // Slots whose bounds touch each row band
+    ClipRect damage[UI_DAMAGE_MAX];     // Merged damaged screen areas
+    uint8_t damage_count;
+} UiTree;
+
+/**
+ * @brief Per-frame counters of the last ui_render()
+ */
+typedef struct {
+    uint16_t widgets_drawn;             // Draw calls
+    uint16_t damage_rects;              // Rects after merging
+    uint32_t damage_pixels;             // Area of those rects
+    uint16_t exclusions;                // Overlaps excluded while lower widgets drew
+} UiStats;
+
+/**
+ * @brief Start an empty tree
+ */
+void ui_init(UiTree* tree);
+
+/**
+ * @brief Register a widget (hidden until ui_set_visible())
+ * Widgets are kept in z-order; a widget goes above those with the same z
+ * added before it. Bounds are clipped to the screen.
+ * @return false if UI_WIDGET_MAX widgets are registered
+ */
+bool ui_add(UiTree* tree, UiWidget* widget);
+
+/**
+ * @brief Show or hide a widget
+ * The widget's bounds are damaged, so it paints itself when shown, and
+ * the widgets underneath repaint the area when it is hidden.
+ */
+void ui_set_visible(UiTree* tree, UiWidget* widget, bool visible);
+
+/**
+ * @brief Whether a widget is shown
+ */
+bool ui_visible(const UiTree* tree, const UiWidget* widget);
+
+/**
+ * @brief Mark a widget for an incremental redraw this frame
+ */
+void ui_mark_dirty(UiTree* tree, UiWidget* widget);
+
+/**
+ * @brief Mark a screen area for repainting
+ * Overlapping or touching rects are merged; past UI_DAMAGE_MAX, the pair
+ * that grows least is merged.
+ */
+void ui_damage(UiTree* tree, int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * @brief Whether anything is waiting to be drawn
+ */
+bool ui_pending(const UiTree* tree);
+
+/**
+ * @brief Draw dirty widgets and damaged areas, then clear both
+ * Call once per frame, inside display_frame_begin() / display_frame_end().
+ * @return Widgets drawn
+ */
+int ui_render(UiTree* tree);
+
+/**
+ * @brief Counters of the last ui_render()
+ */
+UiStats ui_stats_get();
+
+#endif // UI_TREE_H
@@ -6,20 +6,35 @@
  *   - NORMAL: Real ADC readings from fuel senders
  *   - DEMO: Simulated cycling values for testing without hardware
  *   - DEBUG: Real ADC readings with diagnostic overlay
+ *   - TRIP: Real ADC readings, trip computer page (distance, MPG, range)
  * 
  * Hardware: Waveshare ESP32-C6-LCD-1.9
  * Display: ST7789 170x320 LCD in portrait orientation
  * Sensors: 33-240 ohm fuel tank senders via voltage divider
  * 
- * Press BOOT button (GPIO9) to cycle modes: Normal → Demo → Debug → Normal
+ * Press BOOT button (GPIO9) to cycle modes: Normal → Trip → Debug → Demo → Normal
  */
 
 #include <Arduino.h>
 #include "config.h"
 #include "display/display.h"
 #include "display/gauge.h"
+#include "display/gauge_anim.h"
+#include "display/gauge_alert.h"
+#include "display/dial.h"
 #include "display/brightness.h"
+#include "display/summary.h"
+#include "display/trip_page.h"
+#include "display/history_page.h"
+#include "display/page_compositor.h"
+#include "display/ui_tree.h"
+#include "display/asset_data.h"
 #include "sensor/fuel_sensor.h"
+#include "sensor/tank_aggregate.h"
+#include "sensor/fuel_history.h"
+#include "sensor/speed_sensor.h"
+#include "sensor/lp_sampler.h"
+#include "trip/trip_computer.h"
 #include "modes/modes.h"
 
 // ============================================================================
@@ -28,17 +43,247 @@
 
 static float tank1_percent = 0.0f;
 static float tank2_percent = 0.0f;
-static float prev_tank1_percent = -1.0f;  // Force initial draw
-static float prev_tank2_percent = -1.0f;
+
+// One tank widget: the level it should show and the level on screen
+typedef struct {
+    int number;
+    float shown;
+    float drawn;
+    uint16_t alert_color;               // Red-zone slot color (low-fuel alert)
+} TankView;
+
+static TankView tank1_view = {1, 0.0f, -1.0f, UI_COLOR_RED};
+static TankView tank2_view = {2, 0.0f, -1.0f, UI_COLOR_RED};
+
+#if GAUGE_ANIM_ENABLE
+// Levels on screen, tweened toward the filtered levels
+static GaugeAnim tank1_anim;
+static GaugeAnim tank2_anim;
+static unsigned long last_anim_frame = 0;
+#endif
+
+#if LOW_FUEL_ALERT_ENABLE && GAUGE_STYLE == GAUGE_STYLE_BAR
+// Low-fuel effect per tank
+static GaugeAlert tank1_alert;
+static GaugeAlert tank2_alert;
+#endif
+
+// Screen pages; each has a static background the compositor caches
+enum {
+    PAGE_GAUGES,
+    PAGE_TRIP,
+    PAGE_HISTORY
+};
 
 static unsigned long last_update_time = 0;
 static bool initial_draw_done = false;
-static bool force_redraw = false;  // Force full redraw on mode change
+static bool force_redraw = false;  // Re-lay out the screen on mode change
+
+// Retained UI: every screen element is a widget; the tree redraws only
+// dirty widgets and damaged areas, once per frame
+static UiTree ui;
+static UiWidget background_widget;      // Page background (z 0)
+static UiWidget tank1_widget;           // Gauges, summary and pages (z 1)
+static UiWidget tank2_widget;
+static UiWidget summary_widget;
+static UiWidget trip_widget;
+#if HISTORY_PAGE_ENABLE
+static UiWidget history_widget;
+#endif
+static UiWidget overlay_widget;         // Debug overlay (z 2, above the gauges)
+static int ui_page = -1;                // Page whose background is on screen
+static bool page_restored = false;      // Background repainted in full this frame
+
+// Sensor readings shown by the debug overlay
+static FuelReading debug_reading1;
+static FuelReading debug_reading2;
+
+// Gauge positions (compile-time layout, see display/layout.h)
+static constexpr int16_t tank1_x = ScreenLayout::tank_x(0);
+static constexpr int16_t tank2_x = ScreenLayout::tank_x(1);
+static constexpr int16_t gauge_y = ScreenLayout::GAUGE_Y;
+
+// Multi-tank summary (total / balance / transfer), fed from filtered levels
+static TankAggregate tank_agg;
 
-// Gauge positions (calculated in setup)
-static int16_t tank1_x = 0;
-static int16_t tank2_x = 0;
-static int16_t gauge_y = 0;
+// Trip computer (speed sensor pulses + filtered fuel used)
+static TripComputer trip;
+static unsigned long last_trip_save = 0;
+
+#if HISTORY_PAGE_ENABLE
+// Downsampled level history for the strip chart page
+static FuelHistory history;
+#endif
+
+// Static layer of the gauge page: bar frames with empty bars (dials draw
+// themselves in full)
+static void draw_gauges_background() {
+#if GAUGE_STYLE == GAUGE_STYLE_BAR
+    gauge_draw_background(tank1_x, gauge_y);
+    gauge_draw_background(tank2_x, gauge_y);
+#endif
+}
+
+// ============================================================================
+// Widgets
+// ============================================================================
+
+// Trip and history pages replace the gauges
+static bool gauges_shown(OperatingMode current) {
+    return current != OP_MODE_TRIP && current != OP_MODE_HISTORY;
+}
+
+static int mode_page(OperatingMode current) {
+    if (current == OP_MODE_TRIP) return PAGE_TRIP;
+    if (current == OP_MODE_HISTORY) return PAGE_HISTORY;
+    return PAGE_GAUGES;
+}
+
+// A whole-screen repaint restores the cached page; a smaller hole (the
+// debug overlay going away) is cleared and the widgets over it repaint
+static void draw_background(UiWidget* widget, const ClipRect* damage) {
+    (void)widget;
+    if (!damage) {
+        return;
+    }
+    if (damage->w == LCD_WIDTH && damage->h == LCD_HEIGHT) {
+        if (ui_page != PAGE_HISTORY) {
+            display_scroll_reset();  // The history page runs its own scroll area
+        }
+        page_show(ui_page);
+        page_restored = true;
+    } else {
+        display_fill_rect(damage->x, damage->y, damage->w, damage->h, UI_COLOR_BACKGROUND);
+    }
+}
+
+// Draw one tank with the configured widget (bar or dial). Over a freshly
+// restored background only the dynamic parts are painted.
+static void tank_widget_draw(int tank_number, float percent) {
+#if GAUGE_STYLE == GAUGE_STYLE_DIAL
+    dial_draw(dial_center_x(tank_number), dial_center_y(tank_number), percent, tank_number);
+#else
+    int16_t x = (tank_number == 2) ? tank2_x : tank1_x;
+    if (page_restored) {
+        gauge_draw_over_background(x, gauge_y, percent, tank_number);
+    } else {
+        gauge_draw(x, gauge_y, percent, tank_number);
+    }
+#endif
+}
+
+static bool tank_widget_update(int tank_number, float old_percent, float new_percent) {
+#if GAUGE_STYLE == GAUGE_STYLE_DIAL
+    return dial_update_if_changed(dial_center_x(tank_number), dial_center_y(tank_number),
+                                  old_percent, new_percent, tank_number);
+#else
+    return gauge_update_if_changed(tank_number == 2 ? tank2_x : tank1_x, gauge_y,
+                                   old_percent, new_percent, tank_number);
+#endif
+}
+
+// Delta rows or spans and changed readout digits only, unless damaged
+static void draw_tank(UiWidget* widget, const ClipRect* damage) {
+    TankView* tank = (TankView*)widget->context;
+    if (damage) {
+        tank_widget_draw(tank->number, tank->shown);
+        tank->drawn = tank->shown;
+    } else if (tank_widget_update(tank->number, tank->drawn, tank->shown)) {
+        tank->drawn = tank->shown;
+    }
+#if LOW_FUEL_ALERT_ENABLE && GAUGE_STYLE == GAUGE_STYLE_BAR
+    gauge_set_alert_color(tank->number == 2 ? tank2_x : tank1_x, gauge_y,
+                          tank->number, tank->alert_color);
+#endif
+}
+
+// Summary column (redraws only the lines whose aggregated values changed)
+static void draw_summary(UiWidget* widget, const ClipRect* damage) {
+    (void)widget;
+    if (damage) {
+        summary_invalidate();
+    }
+    summary_draw(ScreenLayout::SUMMARY_X, ScreenLayout::SUMMARY_Y, &tank_agg);
+}
+
+static void draw_trip(UiWidget* widget, const ClipRect* damage) {
+    (void)widget;
+    if (damage) {
+        trip_page_invalidate();
+    }
+    trip_page_draw(&trip, tank_agg.total_gallons);
+}
+
+#if HISTORY_PAGE_ENABLE
+static void draw_history(UiWidget* widget, const ClipRect* damage) {
+    (void)widget;
+    if (damage) {
+        history_page_invalidate();
+    }
+    history_page_draw(&history, history_get_zoom());
+}
+#endif
+
+static void draw_overlay(UiWidget* widget, const ClipRect* damage) {
+    (void)widget;
+    if (damage) {
+        debug_overlay_invalidate();
+    }
+    debug_draw_overlay(
+        debug_reading1.raw_adc, debug_reading1.voltage, debug_reading1.resistance,
+        debug_reading2.raw_adc, debug_reading2.voltage, debug_reading2.resistance
+    );
+}
+
+static void ui_widget_add(UiWidget* widget, ClipRect bounds, int8_t z, UiDrawFn draw,
+                          void* context) {
+    widget->bounds = bounds;
+    widget->z = z;
+    widget->draw = draw;
+    widget->context = context;
+    ui_add(&ui, widget);
+}
+
+// Register every widget (all hidden until a mode shows them)
+static void ui_setup() {
+    const ClipRect screen = {0, 0, LCD_WIDTH, LCD_HEIGHT};
+    ui_init(&ui);
+    ui_widget_add(&background_widget, screen, 0, draw_background, nullptr);
+#if GAUGE_STYLE == GAUGE_STYLE_DIAL
+    ui_widget_add(&tank1_widget, dial_bounds(dial_center_x(1), dial_center_y(1)), 1, draw_tank, &tank1_view);
+    ui_widget_add(&tank2_widget, dial_bounds(dial_center_x(2), dial_center_y(2)), 1, draw_tank, &tank2_view);
+#else
+    ui_widget_add(&tank1_widget, gauge_bounds(tank1_x, gauge_y), 1, draw_tank, &tank1_view);
+    ui_widget_add(&tank2_widget, gauge_bounds(tank2_x, gauge_y), 1, draw_tank, &tank2_view);
+#endif
+    ui_widget_add(&summary_widget, ScreenLayout::summary(), 1, draw_summary, nullptr);
+    ui_widget_add(&trip_widget, screen, 1, draw_trip, nullptr);
+#if HISTORY_PAGE_ENABLE
+    ui_widget_add(&history_widget, screen, 1, draw_history, nullptr);
+#endif
+    ui_widget_add(&overlay_widget, ScreenLayout::overlay(), 2, draw_overlay, nullptr);
+}
+
+// Show the widgets of a mode. Changing page repaints the whole screen;
+// staying on the gauge page only repaints what the overlay uncovers.
+static void ui_show_mode(OperatingMode current) {
+    int page = mode_page(current);
+    bool gauges = (page == PAGE_GAUGES);
+    ui_set_visible(&ui, &background_widget, true);
+    ui_set_visible(&ui, &tank1_widget, gauges);
+    ui_set_visible(&ui, &tank2_widget, gauges);
+    ui_set_visible(&ui, &summary_widget,
+                   gauges && TANK_SUMMARY_ENABLE && GAUGE_STYLE == GAUGE_STYLE_BAR);
+    ui_set_visible(&ui, &trip_widget, page == PAGE_TRIP);
+#if HISTORY_PAGE_ENABLE
+    ui_set_visible(&ui, &history_widget, page == PAGE_HISTORY);
+#endif
+    ui_set_visible(&ui, &overlay_widget, current == OP_MODE_DEBUG);
+    if (page != ui_page) {
+        ui_page = page;
+        ui_damage(&ui, 0, 0, LCD_WIDTH, LCD_HEIGHT);
+    }
+}
 
 // ============================================================================
 // Setup
@@ -48,6 +293,24 @@ void setup() {
     // Initialize serial for debugging
     Serial.begin(115200);
     
+#if LP_SAMPLER_ENABLE
+    // Woken by the LP core: ingest the samples it buffered while we slept
+    if (lp_sampler_woke_from_lp()) {
+        uint32_t reason = lp_sampler_wake_reason();
+        FuelReading lp_tank1;
+        FuelReading lp_tank2;
+        if (lp_sampler_ingest(&lp_tank1, &lp_tank2) > 0) {
+            tank1_percent = lp_tank1.percent;
+            tank2_percent = lp_tank2.percent;
+        }
+        // Buffer drained and nothing else happened - keep sleeping, with the
+        // drop threshold still measured from the level at ignition off
+        if (reason == LP_WAKE_BUFFER_FULL) {
+            lp_sampler_resume_and_sleep();
+        }
+    }
+#endif
+    
     // Wait for serial to be ready (important for USB CDC)
     delay(2000);  // Give time for USB serial to connect
     
@@ -89,11 +352,29 @@ void setup() {
     }
     Serial.println("OK");
     
+#if ASSET_SPLASH_ENABLE
+    // Boot splash from flash, replaced by the first page
+    asset_draw(&asset_splash, (LCD_WIDTH - asset_splash.width) / 2,
+               (LCD_HEIGHT - asset_splash.height) / 2);
+#endif
+    
     // Initialize fuel sensors (needed for Normal and Debug modes)
     Serial.print("Initializing fuel sensors... ");
     fuel_sensor_init();
     Serial.println("OK");
     
+#if TRIP_COMPUTER_ENABLE
+    // Initialize trip computer (hardware pulse counter + lifetime totals)
+    Serial.print("Initializing speed sensor... ");
+    Serial.println(speed_sensor_init() ? "OK" : "FAILED");
+    trip_init(&trip);
+    trip_storage_load(&trip);
+#endif
+    
+#if HISTORY_PAGE_ENABLE
+    fuel_history_init(&history);
+#endif
+    
     // Initialize brightness control (auto-dimming)
     brightness_init();
     
@@ -101,69 +382,154 @@ void setup() {
     Serial.println("Initializing demo mode...");
     demo_mode_init();
     
-    // Calculate gauge positions for portrait mode (170 wide x 320 tall)
-    // In portrait mode (rotation 0): 
-    //   - Screen width = 170 pixels (narrow)
-    //   - Screen height = 320 pixels (tall)
-    int16_t screen_width = LCD_WIDTH;    // 170 pixels
-    int16_t screen_height = LCD_HEIGHT;  // 320 pixels
-    
-    Serial.print("[LAYOUT] Screen dimensions: ");
-    Serial.print(screen_width);
+    tank_aggregate_init(&tank_agg);
+#if LOW_FUEL_ALERT_ENABLE && GAUGE_STYLE == GAUGE_STYLE_BAR
+    gauge_alert_init(&tank1_alert);
+    gauge_alert_init(&tank2_alert);
+#endif
+    page_define(PAGE_GAUGES, draw_gauges_background);
+    page_define(PAGE_TRIP, trip_page_draw_background);
+    page_define(PAGE_HISTORY, history_page_draw_background);
+    ui_setup();
+    
+    // Positions are compile-time constants (display/layout.h)
+    Serial.print("[LAYOUT] Screen ");
+    Serial.print(LCD_WIDTH);
     Serial.print("x");
-    Serial.println(screen_height);
-    
-    // Position gauges side by side, centered horizontally
-    // Each gauge is GAUGE_WIDTH wide with a gap between them
-    int16_t gap_between = 20;  // Gap between the two gauges
-    int16_t total_gauge_width = GAUGE_WIDTH * 2 + gap_between;
-    int16_t start_x = (screen_width - total_gauge_width) / 2;
-    
-    tank1_x = start_x;
-    tank2_x = start_x + GAUGE_WIDTH + gap_between;
-    
-    // Vertical position - Layout: [Gallons text] [Bar] [Percentage text]
-    // Maximize bar usage - minimal margins
-    int text_height = 18;  // Height for text rows (size 2 = ~16px + small padding)
-    int top_margin = 1;    // Small margin from top of screen
-    int bottom_margin = 2; // Small margin from bottom
-    int total_bar_height = GAUGE_SEGMENT_COUNT * (GAUGE_SEGMENT_HEIGHT + GAUGE_SEGMENT_GAP) - GAUGE_SEGMENT_GAP;
-    
-    // Bar starts after top margin + top text
-    gauge_y = top_margin + text_height;
-    
-    Serial.print("[LAYOUT] Bar starts at y=");
-    Serial.print(gauge_y);
-    Serial.print(" total_bar_height=");
-    Serial.print(total_bar_height);
-    Serial.print(" bar ends at y=");
-    Serial.println(gauge_y + total_bar_height);
-    
-    Serial.print("Gauge positions - Tank1: (");
+    Serial.print(LCD_HEIGHT);
+    Serial.print(" - Tank1 x=");
     Serial.print(tank1_x);
-    Serial.print(", ");
-    Serial.print(gauge_y);
-    Serial.print(") Tank2: (");
+    Serial.print(" Tank2 x=");
     Serial.print(tank2_x);
-    Serial.print(", ");
+    Serial.print(" bar y=");
     Serial.print(gauge_y);
-    Serial.println(")");
-    
-    Serial.print("[LAYOUT] GAUGE_WIDTH=");
-    Serial.print(GAUGE_WIDTH);
-    Serial.print(" total_gauge_width=");
-    Serial.print(total_gauge_width);
-    Serial.print(" start_x=");
-    Serial.println(start_x);
-    
-    Serial.print("[LAYOUT] total_bar_height=");
-    Serial.print(total_bar_height);
-    Serial.print(" gauge_y=");
-    Serial.println(gauge_y);    
+    Serial.print(" segment=");
+    Serial.println(GAUGE_SEGMENT_HEIGHT);
     Serial.println("Setup complete!");
     Serial.println();
 }
 
+// ============================================================================
+// Gauge Updates
+// ============================================================================
+
+// Move the gauge widgets toward the filtered levels. With animation enabled
+// they show the tweened level; between sensor updates a tween frame runs
+// only while a bar is moving, so idle loops cost nothing.
+static void step_gauges(unsigned long now, bool sampled) {
+    if (!gauges_shown(mode_get_current())) {
+        return;
+    }
+#if GAUGE_ANIM_ENABLE
+    if (sampled) {
+        gauge_anim_set_target(&tank1_anim, tank1_percent, (uint32_t)now);
+        gauge_anim_set_target(&tank2_anim, tank2_percent, (uint32_t)now);
+    } else if ((!gauge_anim_active(&tank1_anim) && !gauge_anim_active(&tank2_anim)) ||
+               now - last_anim_frame < GAUGE_ANIM_FRAME_MS) {
+        return;
+    }
+    tank1_view.shown = gauge_anim_step(&tank1_anim, (uint32_t)now);
+    tank2_view.shown = gauge_anim_step(&tank2_anim, (uint32_t)now);
+    last_anim_frame = now;
+#else
+    if (!sampled) {
+        return;
+    }
+    tank1_view.shown = tank1_percent;
+    tank2_view.shown = tank2_percent;
+#endif
+    ui_mark_dirty(&ui, &tank1_widget);
+    ui_mark_dirty(&ui, &tank2_widget);
+}
+
+#if LOW_FUEL_ALERT_ENABLE && GAUGE_STYLE == GAUGE_STYLE_BAR
+// Step the low-fuel effect. Only the red-zone rows of a low tank are
+// repainted, and only when their color actually changes.
+static void alert_gauges(unsigned long now) {
+    if (!gauges_shown(mode_get_current())) {
+        return;
+    }
+    gauge_alert_update(&tank1_alert, tank1_view.drawn, (uint32_t)now);
+    gauge_alert_update(&tank2_alert, tank2_view.drawn, (uint32_t)now);
+    uint16_t color1 = gauge_alert_color(&tank1_alert, (uint32_t)now);
+    uint16_t color2 = gauge_alert_color(&tank2_alert, (uint32_t)now);
+    if (color1 != tank1_view.alert_color) {
+        tank1_view.alert_color = color1;
+        ui_mark_dirty(&ui, &tank1_widget);
+    }
+    if (color2 != tank2_view.alert_color) {
+        tank2_view.alert_color = color2;
+        ui_mark_dirty(&ui, &tank2_widget);
+    }
+}
+#endif
+
+// ============================================================================
+// Sensor Updates
+// ============================================================================
+
+// Read (or simulate) the tank levels and feed everything derived from them
+static void sample_inputs(unsigned long now, OperatingMode current) {
+    if (current == OP_MODE_DEMO) {
+        // Demo mode: Use simulated cycling values
+        demo_mode_update(&tank1_percent, &tank2_percent);
+    } else {
+        // Normal or Debug mode: Read real sensors with EMA damping
+        debug_reading1 = fuel_sensor_read_damped(1, ADC_SAMPLES);
+        debug_reading2 = fuel_sensor_read_damped(2, ADC_SAMPLES);
+        
+        tank1_percent = debug_reading1.percent;
+        tank2_percent = debug_reading2.percent;
+    }
+    
+#if LP_SAMPLER_ENABLE
+    // Ignition off long enough - hand sampling over to the LP core
+    static unsigned long last_ignition_check = 0;
+    if (current != OP_MODE_DEMO && now - last_ignition_check >= 1000) {
+        last_ignition_check = now;
+        if (lp_sampler_ignition_off(brightness_read_voltage(), (uint32_t)now)) {
+            brightness_set(0);
+#if TRIP_COMPUTER_ENABLE
+            trip_storage_save(&trip);  // RAM is lost in deep sleep
+#endif
+            lp_sampler_start_and_sleep(tank1_percent, tank2_percent);
+        }
+    }
+#endif
+    
+    // Aggregate the filtered levels (no extra ADC reads)
+    tank_aggregate_update(&tank_agg, tank1_percent, tank2_percent, (uint32_t)now);
+    
+#if TRIP_COMPUTER_ENABLE
+    // Trip computer integrates real levels only (demo values are simulated)
+    if (current != OP_MODE_DEMO) {
+        if (trip_update(&trip, speed_sensor_get_count(),
+                        calc_gallons_to_mgal(tank_agg.total_gallons))) {
+            Serial.println("[TRIP] Refuel detected");
+        }
+    }
+    if (now - last_trip_save >= TRIP_SAVE_INTERVAL_MS) {
+        last_trip_save = now;
+        trip_storage_save(&trip);
+    }
+#endif
+    
+#if HISTORY_PAGE_ENABLE
+    // History records real levels only
+    if (current != OP_MODE_DEMO) {
+        fuel_history_update(&history, tank1_percent, tank2_percent, (uint32_t)now);
+    }
+#endif
+    
+    // Widgets fed by the new values (each redraws only what changed)
+    ui_mark_dirty(&ui, &summary_widget);
+    ui_mark_dirty(&ui, &trip_widget);
+#if HISTORY_PAGE_ENABLE
+    ui_mark_dirty(&ui, &history_widget);
+#endif
+    ui_mark_dirty(&ui, &overlay_widget);
+}
+
 // ============================================================================
 // Main Loop
 // ============================================================================
@@ -185,85 +551,58 @@ void loop() {
         Serial.print("Mode changed to: ");
         Serial.println(mode_get_name(new_mode));
         
-        // Force a full redraw when mode changes
+        // Re-lay out the screen for the new mode
         force_redraw = true;
         
+        // Level source changed - restart rate measurement
+        tank_aggregate_init(&tank_agg);
+        
         // Reset demo mode when switching to it
         if (new_mode == OP_MODE_DEMO) {
             demo_mode_init();
         }
     }
     
-    // Rate limit updates
-    if (now - last_update_time < UPDATE_INTERVAL_MS && initial_draw_done && !force_redraw) {
-        return;
-    }
-    last_update_time = now;
-    
     // ========================================================================
-    // Read/Update Tank Values Based on Current Mode
+    // Read/Update Tank Values Based on Current Mode (rate limited)
     // ========================================================================
     
     OperatingMode current = mode_get_current();
-    
-    // Store sensor readings for debug display (used after gauge update)
-    static FuelReading debug_reading1;
-    static FuelReading debug_reading2;
-    
-    if (current == OP_MODE_DEMO) {
-        // Demo mode: Use simulated cycling values
-        demo_mode_update(&tank1_percent, &tank2_percent);
-    } else {
-        // Normal or Debug mode: Read real sensors with EMA damping
-        debug_reading1 = fuel_sensor_read_damped(1, ADC_SAMPLES);
-        debug_reading2 = fuel_sensor_read_damped(2, ADC_SAMPLES);
-        
-        tank1_percent = debug_reading1.percent;
-        tank2_percent = debug_reading2.percent;
+    bool sampled = false;
+    if (now - last_update_time >= UPDATE_INTERVAL_MS || !initial_draw_done || force_redraw) {
+        last_update_time = now;
+        sample_inputs(now, current);
+        sampled = true;
     }
     
-    // ========================================================================
-    // Update Display
-    // ========================================================================
-    
+    // Mode change: show its widgets; gauges start at the current levels
     if (!initial_draw_done || force_redraw) {
-        // First draw or mode change - render everything
-        display_clear(UI_COLOR_BACKGROUND);
-        gauge_draw(tank1_x, gauge_y, tank1_percent, 1);
-        gauge_draw(tank2_x, gauge_y, tank2_percent, 2);
-        
-        prev_tank1_percent = tank1_percent;
-        prev_tank2_percent = tank2_percent;
+        ui_show_mode(current);
+        tank1_view.shown = tank1_percent;
+        tank2_view.shown = tank2_percent;
+#if GAUGE_ANIM_ENABLE
+        gauge_anim_init(&tank1_anim, tank1_percent);
+        gauge_anim_init(&tank2_anim, tank2_percent);
+#endif
         initial_draw_done = true;
         force_redraw = false;
-        
         Serial.println("Display redrawn");
-    } else {
-        // Subsequent draws - only update if changed
-        bool tank1_changed = gauge_update_if_changed(tank1_x, gauge_y, 
-                                                      prev_tank1_percent, 
-                                                      tank1_percent, 1);
-        bool tank2_changed = gauge_update_if_changed(tank2_x, gauge_y, 
-                                                      prev_tank2_percent, 
-                                                      tank2_percent, 2);
-        
-        if (tank1_changed) {
-            prev_tank1_percent = tank1_percent;
-        }
-        if (tank2_changed) {
-            prev_tank2_percent = tank2_percent;
-        }
     }
     
+    step_gauges(now, sampled);
+#if LOW_FUEL_ALERT_ENABLE && GAUGE_STYLE == GAUGE_STYLE_BAR
+    alert_gauges(now);
+#endif
+    
     // ========================================================================
-    // Debug Mode Overlay (drawn AFTER gauge to prevent flashing)
+    // Update Display (dirty widgets and damaged areas, one bus transaction)
     // ========================================================================
     
-    if (current == OP_MODE_DEBUG) {
-        debug_draw_overlay(
-            debug_reading1.raw_adc, debug_reading1.voltage, debug_reading1.resistance,
-            debug_reading2.raw_adc, debug_reading2.voltage, debug_reading2.resistance
-        );
+    if (ui_pending(&ui)) {
+        display_frame_begin();
+        page_restored = false;
+        ui_render(&ui);
+        display_frame_end();
     }
     
     // Debug output to serial (in Demo or Debug modes)
@@ -276,6 +615,17 @@ void loop() {
         Serial.print(tank1_percent, 1);
         Serial.print("% | Tank2: ");
         Serial.print(tank2_percent, 1);
-        Serial.println("%");
+        Serial.print("% | Frame ");
+        DisplayTiming t = display_timing_get();
+        Serial.print(t.frame_us);
+        Serial.print("us (draw ");
+        Serial.print(t.draw_us);
+        Serial.print(", push ");
+        Serial.print(t.push_us);
+        Serial.print(", wait ");
+        Serial.print(t.wait_us);
+        Serial.print(", bus idle ");
+        Serial.print(t.bus_idle_us);
+        Serial.println(")");
     }
 }
@@ -1,6 +1,8 @@
 #include "modes.h"
 #include "../display/display.h"
 #include "../display/brightness.h"
+#include "../display/shown_value.h"
+#include "../display/layout.h"
 
 #ifndef NATIVE_BUILD
 #include <Arduino.h>
@@ -18,6 +20,9 @@ static bool debug_overlay_drawn = false;
 // Demo mode brightness cycling (5 levels)
 #define DEMO_BRIGHTNESS_LEVELS 5
 static int demo_brightness_step = 0;  // 0 = full brightness, 4 = lowest
+
+// History page zoom, stepped by the button before leaving the page
+static int history_zoom = 0;
 static const uint8_t demo_brightness_values[DEMO_BRIGHTNESS_LEVELS] = {
     255,  // Level 0: 100% (full)
     192,  // Level 1: 75%
@@ -44,9 +49,26 @@ OperatingMode mode_cycle_next() {
         debug_overlay_drawn = false;
     }
     
-    // Sequence: Normal -> Debug -> Demo (with brightness cycling) -> Normal
+    // Sequence: Normal -> Trip -> History (with zoom cycling) -> Debug ->
+    // Demo (with brightness cycling) -> Normal
     switch (current_mode) {
         case OP_MODE_NORMAL:
+#if TRIP_COMPUTER_ENABLE
+            current_mode = OP_MODE_TRIP;
+            break;
+        case OP_MODE_TRIP:
+#endif
+#if HISTORY_PAGE_ENABLE
+            current_mode = OP_MODE_HISTORY;
+            history_zoom = 0;
+            break;
+        case OP_MODE_HISTORY:
+            // Step through the zoom levels before leaving the history page
+            if (current_mode == OP_MODE_HISTORY && ++history_zoom < HISTORY_ZOOM_LEVELS) {
+                break;
+            }
+            history_zoom = 0;
+#endif
             current_mode = OP_MODE_DEBUG;
             debug_overlay_drawn = false;  // Force redraw when entering debug
             brightness_set(255);  // Full brightness for debug
@@ -82,6 +104,8 @@ const char* mode_get_name(OperatingMode mode) {
         case OP_MODE_NORMAL: return "NORMAL";
         case OP_MODE_DEMO:   return "DEMO";
         case OP_MODE_DEBUG:  return "DEBUG";
+        case OP_MODE_TRIP:   return "TRIP";
+        case OP_MODE_HISTORY: return "HISTORY";
         default:             return "UNKNOWN";
     }
 }
@@ -94,6 +118,10 @@ int demo_get_brightness_levels() {
     return DEMO_BRIGHTNESS_LEVELS;
 }
 
+int history_get_zoom() {
+    return history_zoom;
+}
+
 // ============================================================================
 // Button Handling
 // ============================================================================
@@ -202,30 +230,44 @@ void demo_mode_update(float* tank1_percent, float* tank2_percent) {
 // Debug Mode Implementation
 // ============================================================================
 
-// Debug overlay position - centered on screen
-// In portrait mode: LCD_WIDTH=170 (screen width), LCD_HEIGHT=320 (screen height)
-#define DEBUG_OVERLAY_HEIGHT  120     // Height of debug overlay area (9 lines including separator)
-#define DEBUG_OVERLAY_Y     ((LCD_HEIGHT - DEBUG_OVERLAY_HEIGHT) / 2)  // Center vertically
+// Debug overlay position - full width, centered vertically (see layout.h)
+#define DEBUG_OVERLAY_Y     (ScreenLayout::OVERLAY_Y + LAYOUT_OVERLAY_BORDER)  // Text area top
 #define DEBUG_OVERLAY_X     3         // Left margin
 #define DEBUG_LINE_SPACING  12        // Pixels between lines (text size 1 = 8px + 4px gap)
 
 // Expose overlay region for gauge clipping
 int16_t debug_get_overlay_y() {
-    return DEBUG_OVERLAY_Y - 3;  // Include border
+    return ScreenLayout::OVERLAY_Y;  // Include border
 }
 
 int16_t debug_get_overlay_height() {
-    return DEBUG_OVERLAY_HEIGHT + 6;  // Include border
+    return ScreenLayout::OVERLAY_H;  // Include border
 }
 
-// Track last drawn values to avoid unnecessary redraws
-// (debug_overlay_drawn is defined at top of file for mode_cycle_next access)
-static uint16_t last_tank1_raw = 0xFFFF;
-static uint16_t last_tank2_raw = 0xFFFF;
-static float last_tank1_voltage = -1;
-static float last_tank2_voltage = -1;
-static float last_tank1_resistance = -1;
-static float last_tank2_resistance = -1;
+// Overlay fields, each redrawn only once its value has moved past the
+// display hysteresis (debug_overlay_drawn is defined at top of file for
+// mode_cycle_next access)
+enum {
+    DEBUG_ADC1, DEBUG_ADC2,
+    DEBUG_V1, DEBUG_V2,
+    DEBUG_R1, DEBUG_R2,
+    DEBUG_PCT1, DEBUG_PCT2,
+    DEBUG_BRI_ADC, DEBUG_BRI_VPIN,
+    DEBUG_BRI_VIN, DEBUG_BRI_PCT,
+    DEBUG_FIELD_COUNT
+};
+
+// Display step of each field (its last printed digit)
+static const float debug_field_step[DEBUG_FIELD_COUNT] = {
+    1.0f, 1.0f,                         // ADC counts
+    0.01f, 0.01f,                       // Volts, 2 decimals
+    1.0f, 1.0f,                         // Ohms
+    1.0f, 1.0f,                         // Percent
+    1.0f, 0.01f,                        // Brightness ADC, pin volts
+    0.1f, 1.0f                          // Brightness input volts, percent
+};
+
+static ShownValue debug_fields[DEBUG_FIELD_COUNT];
 
 void debug_draw_value(int16_t x, int16_t y, const char* label, float value, int decimals) {
     display_set_text_size(1);
@@ -247,26 +289,31 @@ static void debug_clear_line(int16_t x, int16_t y, int16_t width) {
     display_fill_rect(x, y, width, 10, UI_COLOR_BACKGROUND);
 }
 
+// Redraw one field (label and value) if its shown value changed
+static void debug_draw_field(int field, int16_t x, int16_t y, int16_t width,
+                             const char* label, float value, int decimals) {
+    ShownValue* shown = &debug_fields[field];
+    if (!shown_value_update(shown, value)) {
+        return;
+    }
+    debug_clear_line(x, y, width);
+    debug_draw_value(x, y, label, shown->level * shown->step, decimals);
+}
+
+void debug_overlay_invalidate() {
+    debug_overlay_drawn = false;
+}
+
 void debug_draw_overlay(uint16_t tank1_raw, float tank1_voltage, float tank1_resistance,
                         uint16_t tank2_raw, float tank2_voltage, float tank2_resistance) {
-    // Check if any values changed (with some tolerance for floats)
-    bool values_changed = !debug_overlay_drawn ||
-        tank1_raw != last_tank1_raw ||
-        tank2_raw != last_tank2_raw ||
-        (int)(tank1_voltage * 100) != (int)(last_tank1_voltage * 100) ||
-        (int)(tank2_voltage * 100) != (int)(last_tank2_voltage * 100) ||
-        (int)tank1_resistance != (int)last_tank1_resistance ||
-        (int)tank2_resistance != (int)last_tank2_resistance;
-    
-    if (!values_changed) {
-        return;  // Nothing changed, skip redraw
-    }
-    
     // Only do full clear on first draw, otherwise clear just the value areas
     if (!debug_overlay_drawn) {
         // First draw - clear entire region and draw border
-        display_fill_rect(0, DEBUG_OVERLAY_Y - 3, LCD_WIDTH, DEBUG_OVERLAY_HEIGHT + 6, UI_COLOR_BACKGROUND);
-        display_draw_rect(0, DEBUG_OVERLAY_Y - 3, LCD_WIDTH, DEBUG_OVERLAY_HEIGHT + 6, UI_COLOR_BORDER);
+        display_fill_rect(0, ScreenLayout::OVERLAY_Y, LCD_WIDTH, ScreenLayout::OVERLAY_H, UI_COLOR_BACKGROUND);
+        display_draw_rect(0, ScreenLayout::OVERLAY_Y, LCD_WIDTH, ScreenLayout::OVERLAY_H, UI_COLOR_BORDER);
+        for (int i = 0; i < DEBUG_FIELD_COUNT; i++) {
+            shown_value_init(&debug_fields[i], debug_field_step[i], DEBUG_HYSTERESIS_STEPS);
+        }
     }
     
     int16_t y = DEBUG_OVERLAY_Y;
@@ -287,37 +334,19 @@ void debug_draw_overlay(uint16_t tank1_raw, float tank1_voltage, float tank1_res
     }
     y += DEBUG_LINE_SPACING;
     
-    // Raw ADC values - clear and redraw only if changed
-    if (!debug_overlay_drawn || tank1_raw != last_tank1_raw) {
-        debug_clear_line(x1, y, col_width);
-        debug_draw_value(x1, y, "ADC", tank1_raw, 0);
-    }
-    if (!debug_overlay_drawn || tank2_raw != last_tank2_raw) {
-        debug_clear_line(x2, y, col_width);
-        debug_draw_value(x2, y, "ADC", tank2_raw, 0);
-    }
+    // Raw ADC values
+    debug_draw_field(DEBUG_ADC1, x1, y, col_width, "ADC", tank1_raw, 0);
+    debug_draw_field(DEBUG_ADC2, x2, y, col_width, "ADC", tank2_raw, 0);
     y += DEBUG_LINE_SPACING;
     
     // Voltage values
-    if (!debug_overlay_drawn || (int)(tank1_voltage * 100) != (int)(last_tank1_voltage * 100)) {
-        debug_clear_line(x1, y, col_width);
-        debug_draw_value(x1, y, "V", tank1_voltage, 2);
-    }
-    if (!debug_overlay_drawn || (int)(tank2_voltage * 100) != (int)(last_tank2_voltage * 100)) {
-        debug_clear_line(x2, y, col_width);
-        debug_draw_value(x2, y, "V", tank2_voltage, 2);
-    }
+    debug_draw_field(DEBUG_V1, x1, y, col_width, "V", tank1_voltage, 2);
+    debug_draw_field(DEBUG_V2, x2, y, col_width, "V", tank2_voltage, 2);
     y += DEBUG_LINE_SPACING;
     
     // Resistance values
-    if (!debug_overlay_drawn || (int)tank1_resistance != (int)last_tank1_resistance) {
-        debug_clear_line(x1, y, col_width);
-        debug_draw_value(x1, y, "R", tank1_resistance, 0);
-    }
-    if (!debug_overlay_drawn || (int)tank2_resistance != (int)last_tank2_resistance) {
-        debug_clear_line(x2, y, col_width);
-        debug_draw_value(x2, y, "R", tank2_resistance, 0);
-    }
+    debug_draw_field(DEBUG_R1, x1, y, col_width, "R", tank1_resistance, 0);
+    debug_draw_field(DEBUG_R2, x2, y, col_width, "R", tank2_resistance, 0);
     y += DEBUG_LINE_SPACING;
     
     // Percentage values
@@ -326,16 +355,8 @@ void debug_draw_overlay(uint16_t tank1_raw, float tank1_voltage, float tank1_res
     if (pct1 < 0) pct1 = 0; if (pct1 > 100) pct1 = 100;
     if (pct2 < 0) pct2 = 0; if (pct2 > 100) pct2 = 100;
     
-    if (!debug_overlay_drawn || (int)tank1_resistance != (int)last_tank1_resistance) {
-        debug_clear_line(x1, y, col_width);
-        display_set_text_color(UI_COLOR_YELLOW);
-        debug_draw_value(x1, y, "%", pct1, 0);
-    }
-    if (!debug_overlay_drawn || (int)tank2_resistance != (int)last_tank2_resistance) {
-        debug_clear_line(x2, y, col_width);
-        display_set_text_color(UI_COLOR_YELLOW);
-        debug_draw_value(x2, y, "%", pct2, 0);
-    }
+    debug_draw_field(DEBUG_PCT1, x1, y, col_width, "%", pct1, 0);
+    debug_draw_field(DEBUG_PCT2, x2, y, col_width, "%", pct2, 0);
     y += DEBUG_LINE_SPACING;
     
     // Separator line and Variable Brightness header
@@ -371,51 +392,22 @@ void debug_draw_overlay(uint16_t tank1_raw, float tank1_voltage, float tank1_res
     }
     y += DEBUG_LINE_SPACING;
     
-    // Brightness line 2: Raw ADC value and ADC pin voltage (always update)
-    {
-        uint16_t bri_raw = brightness_read_raw();
-        // Calculate voltage at ADC pin (before voltage divider math)
-        float adc_voltage = ((float)bri_raw / 4095.0f) * 3.3f;
-        
-        debug_clear_line(x1, y, col_width);
-        display_set_text_color(UI_COLOR_DEBUG);
-        display_set_cursor(x1, y);
-        display_print("ADC: ");
-        display_print_int(bri_raw);
-        
-        debug_clear_line(x2, y, col_width);
-        display_set_cursor(x2, y);
-        display_print("Vpin: ");
-        display_print_float(adc_voltage, 2);
-    }
+    // Brightness line 2: Raw ADC value and ADC pin voltage
+    uint16_t bri_raw = brightness_read_raw();
+    // Calculate voltage at ADC pin (before voltage divider math)
+    float adc_voltage = ((float)bri_raw / 4095.0f) * 3.3f;
+    debug_draw_field(DEBUG_BRI_ADC, x1, y, col_width, "ADC", bri_raw, 0);
+    debug_draw_field(DEBUG_BRI_VPIN, x2, y, col_width, "Vpin", adc_voltage, 2);
     y += DEBUG_LINE_SPACING;
     
-    // Brightness line 3: Interpreted input voltage and percentage (always update)
-    {
-        float bri_voltage = brightness_read_voltage();
-        // Calculate brightness percentage (0V = 0%, 14V = 100%)
-        float bri_pct = (bri_voltage / 14.0f) * 100.0f;
-        if (bri_pct < 0) bri_pct = 0;
-        if (bri_pct > 100) bri_pct = 100;
-        
-        debug_clear_line(x1, y, col_width);
-        display_set_text_color(UI_COLOR_DEBUG);
-        display_set_cursor(x1, y);
-        display_print("Vin: ");
-        display_print_float(bri_voltage, 1);
-        
-        debug_clear_line(x2, y, col_width);
-        display_set_cursor(x2, y);
-        display_print("%: ");
-        display_print_int((int)bri_pct);
-    }
+    // Brightness line 3: Interpreted input voltage and percentage
+    float bri_voltage = brightness_read_voltage();
+    // Calculate brightness percentage (0V = 0%, 14V = 100%)
+    float bri_pct = (bri_voltage / 14.0f) * 100.0f;
+    if (bri_pct < 0) bri_pct = 0;
+    if (bri_pct > 100) bri_pct = 100;
+    debug_draw_field(DEBUG_BRI_VIN, x1, y, col_width, "Vin", bri_voltage, 1);
+    debug_draw_field(DEBUG_BRI_PCT, x2, y, col_width, "%", bri_pct, 0);
     
-    // Update cached values
-    last_tank1_raw = tank1_raw;
-    last_tank2_raw = tank2_raw;
-    last_tank1_voltage = tank1_voltage;
-    last_tank2_voltage = tank2_voltage;
-    last_tank1_resistance = tank1_resistance;
-    last_tank2_resistance = tank2_resistance;
     debug_overlay_drawn = true;
 }
@@ -11,7 +11,9 @@
 typedef enum {
     OP_MODE_NORMAL = 0,   // Real ADC readings from fuel senders
     OP_MODE_DEMO = 1,     // Simulated cycling values for testing
-    OP_MODE_DEBUG = 2     // Real ADC readings with diagnostic overlay
+    OP_MODE_DEBUG = 2,    // Real ADC readings with diagnostic overlay
+    OP_MODE_TRIP = 3,     // Real ADC readings, trip computer page
+    OP_MODE_HISTORY = 4   // Real ADC readings, fuel history page
 } OperatingMode;
 
 // ============================================================================
@@ -35,7 +37,9 @@ OperatingMode mode_get_current();
 void mode_set(OperatingMode mode);
 
 /**
- * @brief Cycle to the next mode (Normal -> Debug -> Demo w/brightness -> Normal)
+ * @brief Cycle to the next mode (Normal -> Trip -> History w/zoom -> Debug -> Demo w/brightness -> Normal)
+ * Trip is skipped when TRIP_COMPUTER_ENABLE is 0, History when HISTORY_PAGE_ENABLE is 0
+ * In History mode, steps through the zoom levels before moving on
  * In Demo mode, cycles through brightness levels before returning to Normal
  * @return The new mode after cycling
  */
@@ -56,6 +60,11 @@ int demo_get_brightness_step();
  */
 int demo_get_brightness_levels();
 
+/**
+ * @brief Get the history page zoom level (0 = finest)
+ */
+int history_get_zoom();
+
 // ============================================================================
 // Button Handling
 // ============================================================================
@@ -117,4 +126,9 @@ void demo_mode_update(float* tank1_percent, float* tank2_percent);
 void debug_draw_overlay(uint16_t tank1_raw, float tank1_voltage, float tank1_resistance,
                         uint16_t tank2_raw, float tank2_voltage, float tank2_resistance);
 
+/**
+ * @brief Forget what the overlay shows so the next draw repaints it in full
+ */
+void debug_overlay_invalidate();
+
 #endif // MODES_H
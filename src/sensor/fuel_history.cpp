@@ -0,0 +1,75 @@
+#include "fuel_history.h"
+#include <string.h>
+
+static uint8_t level_to_code(float percent) {
+    if (percent < 0.0f) percent = 0.0f;
+    if (percent > 100.0f) percent = 100.0f;
+    return (uint8_t)(percent * 2.0f + 0.5f);
+}
+
+void fuel_history_init(FuelHistory* h) {
+    memset(h, 0, sizeof(*h));
+}
+
+// Append one sample to a level, passing an average up every ZOOM_FACTOR
+static void ring_add(FuelHistory* h, int zoom, uint8_t code1, uint8_t code2) {
+    HistoryRing* r = &h->zoom[zoom];
+    r->level[0][r->head] = code1;
+    r->level[1][r->head] = code2;
+    r->head = (r->head + 1) % HISTORY_SAMPLES;
+    if (r->count < HISTORY_SAMPLES) {
+        r->count++;
+    }
+    r->total++;
+
+    if (zoom + 1 >= HISTORY_ZOOM_LEVELS) {
+        return;
+    }
+    r->acc[0] += code1;
+    r->acc[1] += code2;
+    if (++r->acc_count == HISTORY_ZOOM_FACTOR) {
+        uint8_t avg1 = (uint8_t)((r->acc[0] + HISTORY_ZOOM_FACTOR / 2) / HISTORY_ZOOM_FACTOR);
+        uint8_t avg2 = (uint8_t)((r->acc[1] + HISTORY_ZOOM_FACTOR / 2) / HISTORY_ZOOM_FACTOR);
+        r->acc[0] = 0;
+        r->acc[1] = 0;
+        r->acc_count = 0;
+        ring_add(h, zoom + 1, avg1, avg2);
+    }
+}
+
+void fuel_history_add(FuelHistory* h, float tank1_percent, float tank2_percent) {
+    ring_add(h, 0, level_to_code(tank1_percent), level_to_code(tank2_percent));
+}
+
+bool fuel_history_update(FuelHistory* h, float tank1_percent, float tank2_percent,
+                         uint32_t now_ms) {
+    if (h->started && now_ms - h->last_sample_ms < HISTORY_SAMPLE_MS) {
+        return false;
+    }
+    h->started = true;
+    h->last_sample_ms = now_ms;
+    fuel_history_add(h, tank1_percent, tank2_percent);
+    return true;
+}
+
+int fuel_history_count(const FuelHistory* h, int zoom) {
+    return h->zoom[zoom].count;
+}
+
+uint32_t fuel_history_total(const FuelHistory* h, int zoom) {
+    return h->zoom[zoom].total;
+}
+
+float fuel_history_get(const FuelHistory* h, int zoom, int tank, int age) {
+    const HistoryRing* r = &h->zoom[zoom];
+    int i = ((int)r->head - 1 - age + 2 * HISTORY_SAMPLES) % HISTORY_SAMPLES;
+    return r->level[tank == 2 ? 1 : 0][i] * 0.5f;
+}
+
+uint32_t fuel_history_interval_ms(int zoom) {
+    uint32_t ms = HISTORY_SAMPLE_MS;
+    for (int z = 0; z < zoom; z++) {
+        ms *= HISTORY_ZOOM_FACTOR;
+    }
+    return ms;
+}
@@ -0,0 +1,80 @@
+#ifndef FUEL_HISTORY_H
+#define FUEL_HISTORY_H
+
+#include "config.h"
+#include <stdint.h>
+
+/**
+ * @brief Sample ring for one zoom level
+ * Levels are stored as half-percent steps (0-200) to keep the rings small.
+ */
+typedef struct {
+    uint8_t level[2][HISTORY_SAMPLES];  // Per tank, ring indexed by head
+    uint16_t head;                      // Next write index
+    uint16_t count;                     // Valid samples (up to HISTORY_SAMPLES)
+    uint32_t total;                     // Samples ever added (for "new since")
+    uint16_t acc[2];                    // Running sum toward the next zoom level
+    uint8_t acc_count;
+} HistoryRing;
+
+/**
+ * @brief Downsampled level history of both tanks
+ *
+ * Zoom 0 takes a sample every HISTORY_SAMPLE_MS. Every HISTORY_ZOOM_FACTOR
+ * samples of a level are averaged into one sample of the next, so every
+ * zoom level is ready to draw without touching the finer ones.
+ */
+typedef struct {
+    HistoryRing zoom[HISTORY_ZOOM_LEVELS];
+    uint32_t last_sample_ms;
+    bool started;
+} FuelHistory;
+
+/**
+ * @brief Clear all history
+ */
+void fuel_history_init(FuelHistory* h);
+
+/**
+ * @brief Record the filtered levels if a sample is due
+ * @param h History
+ * @param tank1_percent Filtered tank 1 level (0-100)
+ * @param tank2_percent Filtered tank 2 level (0-100)
+ * @param now_ms Current time in milliseconds
+ * @return true if a zoom 0 sample was added
+ */
+bool fuel_history_update(FuelHistory* h, float tank1_percent, float tank2_percent,
+                         uint32_t now_ms);
+
+/**
+ * @brief Add a zoom 0 sample now (cascades into the coarser levels)
+ */
+void fuel_history_add(FuelHistory* h, float tank1_percent, float tank2_percent);
+
+/**
+ * @brief Number of samples held at a zoom level
+ */
+int fuel_history_count(const FuelHistory* h, int zoom);
+
+/**
+ * @brief Number of samples ever added at a zoom level
+ * The difference between two calls is how many new samples arrived.
+ */
+uint32_t fuel_history_total(const FuelHistory* h, int zoom);
+
+/**
+ * @brief Get a sample
+ * @param h History
+ * @param zoom Zoom level
+ * @param tank Tank number (1 or 2)
+ * @param age 0 = newest, count - 1 = oldest
+ * @return Level in percent
+ */
+float fuel_history_get(const FuelHistory* h, int zoom, int tank, int age);
+
+/**
+ * @brief Time covered by one sample at a zoom level
+ */
+uint32_t fuel_history_interval_ms(int zoom);
+
+#endif // FUEL_HISTORY_H
@@ -1,34 +1,47 @@
 #include "fuel_sensor.h"
 
+#include <math.h>
+
 #ifndef NATIVE_BUILD
 #include <Arduino.h>
+#include "esp_timer.h"
 #endif
 
 // ============================================================================
 // EMA Damping State (per tank)
 // ============================================================================
 
-static float ema_tank1_percent = -1.0f;  // -1 indicates uninitialized
-static float ema_tank2_percent = -1.0f;
-static bool ema_initialized[2] = {false, false};
+typedef struct {
+    float value;            // Filtered percentage
+    uint32_t last_us;       // Timestamp of the previous sample
+    bool initialized;
+} EmaState;
+
+static EmaState ema_tank[2] = {
+    {0.0f, 0, false},
+    {0.0f, 0, false}
+};
 
-// Apply EMA damping to a reading
-static float apply_ema(float new_value, float* ema_state, bool* initialized) {
+// Apply time-aware EMA damping to a reading
+static float apply_ema(float new_value, uint32_t timestamp_us, EmaState* ema) {
 #if FUEL_DAMPING_ENABLE
-    if (!(*initialized)) {
+    if (!ema->initialized) {
         // First reading - initialize EMA to current value
-        *ema_state = new_value;
-        *initialized = true;
+        ema->value = new_value;
+        ema->last_us = timestamp_us;
+        ema->initialized = true;
         return new_value;
     }
     
-    // EMA formula: smoothed = alpha * new + (1 - alpha) * previous
-    *ema_state = FUEL_DAMPING_ALPHA * new_value + (1.0f - FUEL_DAMPING_ALPHA) * (*ema_state);
-    return *ema_state;
+    // Gain from the real interval (unsigned difference handles wrap)
+    float dt_s = (uint32_t)(timestamp_us - ema->last_us) / 1000000.0f;
+    ema->last_us = timestamp_us;
+    ema->value = calc_ema_step(ema->value, new_value, dt_s, FUEL_DAMPING_TAU_S);
+    return ema->value;
 #else
     // Damping disabled - return raw value
-    (void)ema_state;
-    (void)initialized;
+    (void)timestamp_us;
+    (void)ema;
     return new_value;
 #endif
 }
@@ -74,6 +87,36 @@ float calc_resistance_to_percent(float resistance, float r_empty, float r_full)
     return percent;
 }
 
+float calc_ema_alpha(float dt_s, float tau_s) {
+    if (dt_s <= 0.0f) {
+        return 0.0f;  // No time elapsed - no change
+    }
+    if (tau_s <= 0.0f) {
+        return 1.0f;  // No damping
+    }
+    return 1.0f - expf(-dt_s / tau_s);
+}
+
+float calc_ema_step(float previous, float input, float dt_s, float tau_s) {
+    // EMA formula: smoothed = previous + alpha * (new - previous)
+    return previous + calc_ema_alpha(dt_s, tau_s) * (input - previous);
+}
+
+uint16_t calc_percent_to_adc(float percent, float v_ref, float r_ref,
+                             float r_empty, float r_full, int adc_max) {
+    if (percent < 0.0f) percent = 0.0f;
+    if (percent > 100.0f) percent = 100.0f;
+    
+    // Sender resistance at this level, then divider voltage and ADC code
+    float resistance = r_empty - (percent / 100.0f) * (r_empty - r_full);
+    float v_adc = v_ref * resistance / (r_ref + resistance);
+    float code = (v_adc / v_ref) * adc_max + 0.5f;
+    
+    if (code < 0.0f) code = 0.0f;
+    if (code > adc_max) code = (float)adc_max;
+    return (uint16_t)code;
+}
+
 // ============================================================================
 // Hardware-dependent functions
 // ============================================================================
@@ -98,6 +141,10 @@ uint16_t fuel_sensor_read_raw(int tank_number) {
     return analogRead(pin);
 }
 
+uint32_t fuel_sensor_timestamp_us() {
+    return (uint32_t)esp_timer_get_time();
+}
+
 #else
 
 // Native build stubs
@@ -106,6 +153,11 @@ uint16_t fuel_sensor_read_raw(int tank_number) {
     (void)tank_number;
     return 2048; // Mid-range for testing
 }
+uint32_t fuel_sensor_timestamp_us() {
+    static uint32_t fake_us = 0;
+    fake_us += 50000;  // Simulate a 50ms loop in native tests
+    return fake_us;
+}
 
 #endif
 
@@ -129,9 +181,53 @@ float fuel_sensor_resistance_to_percent(float resistance) {
 
 bool fuel_sensor_is_valid_resistance(float resistance) {
     // Allow some tolerance outside nominal range
-    float tolerance = 10.0f; // 10 ohms tolerance
-    return (resistance >= (SENDER_RESISTANCE_FULL - tolerance) &&
-            resistance <= (SENDER_RESISTANCE_EMPTY + tolerance));
+    return (resistance >= (SENDER_RESISTANCE_FULL - SENDER_R_TOLERANCE) &&
+            resistance <= (SENDER_RESISTANCE_EMPTY + SENDER_R_TOLERANCE));
+}
+
+// ============================================================================
+// Conversion kernel (shared by the single-reading and batch paths)
+// ============================================================================
+
+// Same formulas as the calc_* chain, with branches replaced by selects so
+// the batch loop can be vectorized. Results match the scalar chain exactly.
+static inline void convert_kernel(uint16_t raw_adc, float* voltage, float* resistance,
+                                  float* percent, uint8_t* valid) {
+    const float v_ref = ADC_VREF;
+    const float r_ref = VOLTAGE_DIVIDER_R_REF;
+    const float r_empty = SENDER_RESISTANCE_EMPTY;
+    const float r_full = SENDER_RESISTANCE_FULL;
+    const float tolerance = SENDER_R_TOLERANCE;
+    
+    float v = (raw_adc / (float)ADC_MAX_VALUE) * v_ref;
+    
+    // Divider solved for the sender; -1 marks an open/shorted input
+    // (the division always runs on a safe denominator so no branch is needed)
+    bool in_range = (v < v_ref) & (v >= 0.001f);
+    float denom = in_range ? (v_ref - v) : 1.0f;
+    float r = (v * r_ref) / denom;
+    r = in_range ? r : -1.0f;
+    
+    float p = 100.0f * (r_empty - r) / (r_empty - r_full);
+    p = (r <= r_full) ? 100.0f : p;
+    p = (r >= r_empty) ? 0.0f : p;
+    
+    *voltage = v;
+    *resistance = r;
+    *percent = p;
+    *valid = (uint8_t)((r >= r_full - tolerance) & (r <= r_empty + tolerance));
+}
+
+int fuel_sensor_convert_batch(const uint16_t* raw_adc, int count, const FuelReadingBatch* out) {
+    float* __restrict voltage = out->voltage;
+    float* __restrict resistance = out->resistance;
+    float* __restrict percent = out->percent;
+    uint8_t* __restrict valid = out->valid;
+    
+    for (int i = 0; i < count; i++) {
+        convert_kernel(raw_adc[i], &voltage[i], &resistance[i], &percent[i], &valid[i]);
+    }
+    return count;
 }
 
 FuelReading fuel_sensor_read_averaged(int tank_number, int num_samples) {
@@ -139,6 +235,7 @@ FuelReading fuel_sensor_read_averaged(int tank_number, int num_samples) {
     if (num_samples > 100) num_samples = 100;
     
     uint32_t sum = 0;
+    uint32_t start_us = fuel_sensor_timestamp_us();
     
     for (int i = 0; i < num_samples; i++) {
         sum += fuel_sensor_read_raw(tank_number);
@@ -147,27 +244,44 @@ FuelReading fuel_sensor_read_averaged(int tank_number, int num_samples) {
         #endif
     }
     
+    // Stamp the averaged reading at the middle of the sampling burst
+    uint32_t end_us = fuel_sensor_timestamp_us();
+    uint32_t timestamp_us = start_us + (end_us - start_us) / 2;
+    
     // Create reading from averaged ADC value
+    return fuel_sensor_convert_raw(sum / num_samples, timestamp_us);
+}
+
+FuelReading fuel_sensor_convert_raw(uint16_t raw_adc, uint32_t timestamp_us) {
     FuelReading reading;
-    reading.raw_adc = sum / num_samples;
-    reading.voltage = fuel_sensor_adc_to_voltage(reading.raw_adc);
-    reading.resistance = fuel_sensor_voltage_to_resistance(reading.voltage);
-    reading.percent = fuel_sensor_resistance_to_percent(reading.resistance);
-    reading.valid = fuel_sensor_is_valid_resistance(reading.resistance);
+    reading.raw_adc = raw_adc;
+    reading.timestamp_us = timestamp_us;
+    
+    uint8_t valid;
+    convert_kernel(raw_adc, &reading.voltage, &reading.resistance, &reading.percent, &valid);
+    reading.valid = (valid != 0);
     
     return reading;
 }
 
-FuelReading fuel_sensor_read_damped(int tank_number, int num_samples) {
-    // Get averaged reading first
-    FuelReading reading = fuel_sensor_read_averaged(tank_number, num_samples);
-    
-    // Apply EMA damping to the percentage
-    if (tank_number == 1) {
-        reading.percent = apply_ema(reading.percent, &ema_tank1_percent, &ema_initialized[0]);
-    } else {
-        reading.percent = apply_ema(reading.percent, &ema_tank2_percent, &ema_initialized[1]);
-    }
+// Apply per-tank EMA damping to a converted reading
+static FuelReading apply_tank_damping(int tank_number, FuelReading reading) {
+    EmaState* ema = (tank_number == 1) ? &ema_tank[0] : &ema_tank[1];
+    reading.percent = apply_ema(reading.percent, reading.timestamp_us, ema);
     
     return reading;
 }
+
+FuelReading fuel_sensor_read_damped(int tank_number, int num_samples) {
+    // Get averaged reading first, then damp
+    return apply_tank_damping(tank_number, fuel_sensor_read_averaged(tank_number, num_samples));
+}
+
+FuelReading fuel_sensor_ingest_raw(int tank_number, uint16_t raw_adc, uint32_t timestamp_us) {
+    return apply_tank_damping(tank_number, fuel_sensor_convert_raw(raw_adc, timestamp_us));
+}
+
+void fuel_sensor_reset_damping() {
+    ema_tank[0].initialized = false;
+    ema_tank[1].initialized = false;
+}
@@ -13,13 +13,31 @@ typedef struct {
     float resistance;       // Calculated sender resistance
     float percent;          // Calculated fuel percentage (0-100)
     bool valid;             // True if reading is within expected range
+    uint32_t timestamp_us;  // Sample time (microseconds, wraps ~71 min)
 } FuelReading;
 
+/**
+ * @brief Structure-of-arrays output for batch conversion
+ * Each array must hold at least `count` elements of the batch call.
+ */
+typedef struct {
+    float* voltage;         // Voltage at ADC pin
+    float* resistance;      // Sender resistance (-1 if invalid)
+    float* percent;         // Fuel percentage (0-100)
+    uint8_t* valid;         // 1 if within expected range, else 0
+} FuelReadingBatch;
+
 /**
  * @brief Initialize the fuel sensor ADC pins
  */
 void fuel_sensor_init();
 
+/**
+ * @brief Current sample timestamp (esp_timer, microseconds)
+ * @return Free-running microsecond timestamp (wraps at 2^32)
+ */
+uint32_t fuel_sensor_timestamp_us();
+
 /**
  * @brief Read raw ADC value from specified tank sensor
  * @param tank_number Tank identifier (1 or 2)
@@ -58,12 +76,49 @@ FuelReading fuel_sensor_read_averaged(int tank_number, int num_samples);
 
 /**
  * @brief Read with EMA damping applied (configurable via FUEL_DAMPING_ENABLE)
+ * The filter gain follows the real time since the previous reading, so the
+ * response time is FUEL_DAMPING_TAU_S regardless of how often this is called.
  * @param tank_number Tank identifier (1 or 2)
  * @param num_samples Number of samples to average before damping
  * @return Damped FuelReading with smoothed percentage
  */
 FuelReading fuel_sensor_read_damped(int tank_number, int num_samples);
 
+/**
+ * @brief Convert an already-averaged raw ADC code (no damping)
+ * @param raw_adc Raw ADC value (0-4095)
+ * @param timestamp_us Time the code was sampled (microseconds)
+ * @return FuelReading with voltage, resistance, percent and validity
+ */
+FuelReading fuel_sensor_convert_raw(uint16_t raw_adc, uint32_t timestamp_us);
+
+/**
+ * @brief Convert an array of raw ADC codes (no damping)
+ * Uses the same per-sample kernel as fuel_sensor_convert_raw(), written
+ * branch-free so the loop vectorizes on the host. Intended for log replay
+ * and offline analysis.
+ * @param raw_adc Raw ADC values (0-4095)
+ * @param count Number of samples
+ * @param out Output arrays (must not alias raw_adc)
+ * @return Number of samples converted
+ */
+int fuel_sensor_convert_batch(const uint16_t* raw_adc, int count, const FuelReadingBatch* out);
+
+/**
+ * @brief Feed an externally sampled code through conversion and EMA damping
+ * Used for samples taken while the main core was asleep (LP core batches)
+ * @param tank_number Tank identifier (1 or 2)
+ * @param raw_adc Raw ADC value (0-4095)
+ * @param timestamp_us Time the code was sampled (microseconds)
+ * @return Damped FuelReading
+ */
+FuelReading fuel_sensor_ingest_raw(int tank_number, uint16_t raw_adc, uint32_t timestamp_us);
+
+/**
+ * @brief Reset EMA damping state so the next reading seeds the filter
+ */
+void fuel_sensor_reset_damping();
+
 /**
  * @brief Check if a resistance value is within valid sender range
  * @param resistance Resistance in ohms
@@ -92,4 +147,32 @@ float calc_voltage_to_resistance(float v_adc, float v_ref, float r_ref);
  */
 float calc_resistance_to_percent(float resistance, float r_empty, float r_full);
 
+/**
+ * @brief Pure calculation: EMA gain for a sample interval
+ * alpha = 1 - exp(-dt / tau), so any sequence of steps covering the same
+ * total time gives the same response
+ * @param dt_s Time since the previous sample (seconds)
+ * @param tau_s Filter time constant (seconds)
+ * @return Gain in [0, 1]
+ */
+float calc_ema_alpha(float dt_s, float tau_s);
+
+/**
+ * @brief Pure calculation: One time-aware EMA step
+ * @param previous Previous filtered value
+ * @param input New sample
+ * @param dt_s Time since the previous sample (seconds)
+ * @param tau_s Filter time constant (seconds)
+ * @return New filtered value
+ */
+float calc_ema_step(float previous, float input, float dt_s, float tau_s);
+
+/**
+ * @brief Pure calculation: Fuel percentage back to the expected raw ADC code
+ * Inverse of the ADC -> voltage -> resistance -> percent chain, used to
+ * derive integer thresholds for code that cannot do the float conversion
+ */
+uint16_t calc_percent_to_adc(float percent, float v_ref, float r_ref,
+                             float r_empty, float r_full, int adc_max);
+
 #endif // FUEL_SENSOR_H
@@ -0,0 +1,153 @@
+#ifndef LP_SAMPLE_LOGIC_H
+#define LP_SAMPLE_LOGIC_H
+
+/*******************************************************************************
+ * Shared LP-core sampling logic (decimation, ring buffer, wake thresholds)
+ *
+ * Plain C, header-only and integer-only so the same code is compiled into
+ * the LP-core program (lp_core/lp_sampler_main.c), the HP firmware and the
+ * native unit tests. Thresholds are raw ADC codes computed by the HP core
+ * before sleeping, so the LP core never needs floating point.
+ ******************************************************************************/
+
+#include "config.h"
+#include <stdint.h>
+
+// Sampled channels
+#define LP_CH_TANK1           0
+#define LP_CH_TANK2           1
+#define LP_CH_IGNITION        2       // Brightness / dimmer input
+#define LP_CHANNELS           3
+
+// Wake reasons (bit flags)
+#define LP_WAKE_NONE          0x00
+#define LP_WAKE_IGNITION      0x01    // Ignition channel crossed the on threshold
+#define LP_WAKE_LEVEL_DROP    0x02    // A tank fell past its drop threshold
+#define LP_WAKE_BUFFER_FULL   0x04    // Ring buffer needs draining
+
+/**
+ * @brief One decimated sample (averaged raw codes)
+ */
+typedef struct {
+    uint16_t code[LP_CHANNELS];
+} LpSample;
+
+/**
+ * @brief LP SRAM state shared between the LP program and the HP core
+ */
+typedef struct {
+    // Configuration (written by the HP core before sleeping)
+    uint16_t decimation;                // Raw samples per stored sample
+    uint16_t ignition_on_code;          // Wake when ignition code >= this
+    uint16_t level_drop_code[2];        // Per-tank drop threshold code
+    uint16_t level_drop_above;          // 1 = code rises as level falls
+
+    // Decimation accumulator
+    uint16_t acc_count;
+    uint32_t acc[LP_CHANNELS];
+
+    // Ring buffer of decimated samples (oldest at head - count)
+    uint16_t head;                      // Next write index
+    uint16_t count;                     // Valid samples
+    LpSample ring[LP_BUFFER_SIZE];
+
+    // Status
+    uint32_t wake_reason;               // Accumulated LP_WAKE_* flags
+    uint32_t stored;                    // Total decimated samples stored
+} LpSampleState;
+
+/**
+ * @brief Initialize shared state and thresholds
+ */
+static inline void lp_logic_init(LpSampleState* s, uint16_t decimation,
+                                 uint16_t ignition_on_code,
+                                 uint16_t drop_code1, uint16_t drop_code2,
+                                 uint16_t drop_above) {
+    s->decimation = decimation ? decimation : 1;
+    s->ignition_on_code = ignition_on_code;
+    s->level_drop_code[0] = drop_code1;
+    s->level_drop_code[1] = drop_code2;
+    s->level_drop_above = drop_above;
+    s->acc_count = 0;
+    for (int ch = 0; ch < LP_CHANNELS; ch++) {
+        s->acc[ch] = 0;
+    }
+    s->head = 0;
+    s->count = 0;
+    s->wake_reason = LP_WAKE_NONE;
+    s->stored = 0;
+}
+
+// Check one tank code against its drop threshold
+static inline int lp_logic_tank_dropped(const LpSampleState* s, int tank, uint16_t code) {
+    uint16_t limit = s->level_drop_code[tank];
+    return s->level_drop_above ? (code >= limit) : (code <= limit);
+}
+
+/**
+ * @brief Add one raw sample; stores a decimated sample every `decimation` calls
+ * Thresholds are evaluated on decimated samples so single-sample noise
+ * cannot wake the HP core.
+ * @param s Shared state
+ * @param raw Raw codes indexed by LP_CH_*
+ * @return Newly raised LP_WAKE_* flags (LP_WAKE_NONE if none)
+ */
+static inline uint32_t lp_logic_push(LpSampleState* s, const uint16_t raw[LP_CHANNELS]) {
+    for (int ch = 0; ch < LP_CHANNELS; ch++) {
+        s->acc[ch] += raw[ch];
+    }
+    s->acc_count++;
+    if (s->acc_count < s->decimation) {
+        return LP_WAKE_NONE;
+    }
+
+    // Store the rounded average, overwriting the oldest sample if full
+    LpSample* out = &s->ring[s->head];
+    for (int ch = 0; ch < LP_CHANNELS; ch++) {
+        out->code[ch] = (uint16_t)((s->acc[ch] + s->acc_count / 2) / s->acc_count);
+        s->acc[ch] = 0;
+    }
+    s->acc_count = 0;
+    s->head = (uint16_t)((s->head + 1) % LP_BUFFER_SIZE);
+    if (s->count < LP_BUFFER_SIZE) {
+        s->count++;
+    }
+    s->stored++;
+
+    uint32_t reasons = LP_WAKE_NONE;
+    if (out->code[LP_CH_IGNITION] >= s->ignition_on_code) {
+        reasons |= LP_WAKE_IGNITION;
+    }
+    if (lp_logic_tank_dropped(s, 0, out->code[LP_CH_TANK1]) ||
+        lp_logic_tank_dropped(s, 1, out->code[LP_CH_TANK2])) {
+        reasons |= LP_WAKE_LEVEL_DROP;
+    }
+    if (s->count >= LP_BUFFER_SIZE) {
+        reasons |= LP_WAKE_BUFFER_FULL;
+    }
+
+    // Only report reasons not already pending
+    uint32_t raised = reasons & ~s->wake_reason;
+    s->wake_reason |= reasons;
+    return raised;
+}
+
+/**
+ * @brief Copy buffered samples oldest-first and empty the buffer
+ * @param s Shared state
+ * @param out Destination array
+ * @param max Capacity of out
+ * @return Number of samples copied
+ */
+static inline uint16_t lp_logic_drain(LpSampleState* s, LpSample* out, uint16_t max) {
+    uint16_t n = s->count < max ? s->count : max;
+    uint16_t start = (uint16_t)((s->head + LP_BUFFER_SIZE - s->count) % LP_BUFFER_SIZE);
+    for (uint16_t i = 0; i < n; i++) {
+        out[i] = s->ring[(start + i) % LP_BUFFER_SIZE];
+    }
+    s->count = 0;
+    s->wake_reason = LP_WAKE_NONE;
+    return n;
+}
+
+#endif // LP_SAMPLE_LOGIC_H
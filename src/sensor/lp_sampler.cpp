@@ -0,0 +1,186 @@
+#include "lp_sampler.h"
+
+#if LP_SAMPLER_ENABLE && !defined(NATIVE_BUILD)
+#include <Arduino.h>
+#include "esp_sleep.h"
+#include "ulp_lp_core.h"
+#include "ulp_lp_core_lp_adc_shared.h"
+#include "ulp_lp_sampler.h"     // Generated by ulp_embed_binary(lp_sampler ...)
+
+extern const uint8_t lp_sampler_bin_start[] asm("_binary_lp_sampler_bin_start");
+extern const uint8_t lp_sampler_bin_end[] asm("_binary_lp_sampler_bin_end");
+#endif
+
+// ============================================================================
+// Hardware-independent helpers (testable)
+// ============================================================================
+
+uint16_t calc_ignition_volts_to_adc(float volts) {
+    // Input divider: Vpin = Vin * R2 / (R1 + R2)
+    float v_pin = volts * BRIGHTNESS_DIVIDER_R2 / (BRIGHTNESS_DIVIDER_R1 + BRIGHTNESS_DIVIDER_R2);
+    float code = (v_pin / ADC_VREF) * ADC_MAX_VALUE + 0.5f;
+    if (code < 0.0f) code = 0.0f;
+    if (code > ADC_MAX_VALUE) code = (float)ADC_MAX_VALUE;
+    return (uint16_t)code;
+}
+
+// Raw code at which a tank is considered to have dropped
+static uint16_t level_drop_code(float percent) {
+    return calc_percent_to_adc(percent - LP_LEVEL_DROP_PERCENT, ADC_VREF,
+                               VOLTAGE_DIVIDER_R_REF, SENDER_RESISTANCE_EMPTY,
+                               SENDER_RESISTANCE_FULL, ADC_MAX_VALUE);
+}
+
+void lp_sampler_configure(LpSampleState* s, float tank1_percent, float tank2_percent) {
+    // Standard senders read a higher code when emptier; reversed senders lower
+    uint16_t empty_code = calc_percent_to_adc(0.0f, ADC_VREF, VOLTAGE_DIVIDER_R_REF,
+                                              SENDER_RESISTANCE_EMPTY, SENDER_RESISTANCE_FULL,
+                                              ADC_MAX_VALUE);
+    uint16_t full_code = calc_percent_to_adc(100.0f, ADC_VREF, VOLTAGE_DIVIDER_R_REF,
+                                             SENDER_RESISTANCE_EMPTY, SENDER_RESISTANCE_FULL,
+                                             ADC_MAX_VALUE);
+
+    lp_logic_init(s, LP_DECIMATION,
+                  calc_ignition_volts_to_adc(LP_IGNITION_ON_VOLTS),
+                  level_drop_code(tank1_percent),
+                  level_drop_code(tank2_percent),
+                  empty_code > full_code ? 1 : 0);
+}
+
+int lp_sampler_ingest_batch(const LpSample* samples, int count, uint32_t last_timestamp_us,
+                            FuelReading* tank1, FuelReading* tank2) {
+    // One stored sample per LP_DECIMATION timer periods
+    const uint32_t interval_us = (uint32_t)LP_SAMPLE_PERIOD_MS * LP_DECIMATION * 1000;
+    for (int i = 0; i < count; i++) {
+        uint32_t t_us = last_timestamp_us - (uint32_t)(count - 1 - i) * interval_us;
+        FuelReading r1 = fuel_sensor_ingest_raw(1, samples[i].code[LP_CH_TANK1], t_us);
+        FuelReading r2 = fuel_sensor_ingest_raw(2, samples[i].code[LP_CH_TANK2], t_us);
+        if (tank1) *tank1 = r1;
+        if (tank2) *tank2 = r2;
+    }
+    return count;
+}
+
+static uint32_t ignition_off_since = 0;
+static bool ignition_was_off = false;
+
+bool lp_sampler_ignition_off(float ignition_volts, uint32_t now_ms) {
+    if (ignition_volts >= LP_IGNITION_ON_VOLTS) {
+        ignition_was_off = false;
+        return false;
+    }
+    if (!ignition_was_off) {
+        ignition_was_off = true;
+        ignition_off_since = now_ms;
+    }
+    return (now_ms - ignition_off_since) >= LP_IGNITION_OFF_DELAY_MS;
+}
+
+// ============================================================================
+// Hardware-dependent functions
+// ============================================================================
+
+#if LP_SAMPLER_ENABLE && !defined(NATIVE_BUILD)
+
+// The LP program's global `lp_shared` is exported to the HP side as ulp_lp_shared
+static LpSampleState* lp_shared_state() {
+    return (LpSampleState*)&ulp_lp_shared;
+}
+
+// Levels at the hand-off to the LP core; loading the LP binary resets
+// lp_shared, so the reference lives in HP RTC memory across deep sleeps
+RTC_DATA_ATTR static float lp_reference_percent[2];
+
+bool lp_sampler_woke_from_lp() {
+    return esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_ULP;
+}
+
+uint32_t lp_sampler_wake_reason() {
+    return lp_sampler_woke_from_lp() ? lp_shared_state()->wake_reason : LP_WAKE_NONE;
+}
+
+int lp_sampler_ingest(FuelReading* tank1, FuelReading* tank2) {
+    if (!lp_sampler_woke_from_lp()) {
+        return 0;
+    }
+
+    // Stop the LP core so the buffer is not modified while draining
+    ulp_lp_core_stop();
+
+    LpSample batch[LP_BUFFER_SIZE];
+    int count = lp_logic_drain(lp_shared_state(), batch, LP_BUFFER_SIZE);
+
+    // Seed the EMA from the batch rather than from a stale pre-sleep value
+    fuel_sensor_reset_damping();
+    lp_sampler_ingest_batch(batch, count, fuel_sensor_timestamp_us(), tank1, tank2);
+
+    Serial.print("[LP] Ingested ");
+    Serial.print(count);
+    Serial.println(" samples from LP core");
+    return count;
+}
+
+static bool lp_start_and_sleep(float tank1_percent, float tank2_percent) {
+    // LP ADC channels: on the C6, GPIO0-6 map to ADC1 channels 0-6
+    if (lp_core_lp_adc_init(ADC_UNIT_1) != ESP_OK) {
+        Serial.println("[LP] ERROR: LP ADC init failed");
+        return false;
+    }
+    lp_core_lp_adc_chan_cfg_t chan_cfg = {};
+    chan_cfg.atten = ADC_ATTEN_DB_12;
+    chan_cfg.bitwidth = ADC_BITWIDTH_12;
+    lp_core_lp_adc_config_channel(ADC_UNIT_1, (adc_channel_t)PIN_TANK1_ADC, &chan_cfg);
+    lp_core_lp_adc_config_channel(ADC_UNIT_1, (adc_channel_t)PIN_TANK2_ADC, &chan_cfg);
+    lp_core_lp_adc_config_channel(ADC_UNIT_1, (adc_channel_t)PIN_BRIGHTNESS_ADC, &chan_cfg);
+
+    if (ulp_lp_core_load_binary(lp_sampler_bin_start,
+                                lp_sampler_bin_end - lp_sampler_bin_start) != ESP_OK) {
+        Serial.println("[LP] ERROR: Failed to load LP core program");
+        return false;
+    }
+
+    lp_sampler_configure(lp_shared_state(), tank1_percent, tank2_percent);
+
+    ulp_lp_core_cfg_t cfg = {};
+    cfg.wakeup_source = ULP_LP_CORE_WAKEUP_SOURCE_LP_TIMER;
+    cfg.lp_timer_sleep_duration_us = (uint32_t)LP_SAMPLE_PERIOD_MS * 1000;
+    if (ulp_lp_core_run(&cfg) != ESP_OK) {
+        Serial.println("[LP] ERROR: Failed to start LP core");
+        return false;
+    }
+
+    Serial.println("[LP] Ignition off - LP core sampling, HP core entering deep sleep");
+    Serial.flush();
+    esp_sleep_enable_ulp_wakeup();
+    esp_deep_sleep_start();
+    return true;  // Not reached
+}
+
+bool lp_sampler_start_and_sleep(float tank1_percent, float tank2_percent) {
+    lp_reference_percent[0] = tank1_percent;
+    lp_reference_percent[1] = tank2_percent;
+    return lp_start_and_sleep(tank1_percent, tank2_percent);
+}
+
+bool lp_sampler_resume_and_sleep() {
+    return lp_start_and_sleep(lp_reference_percent[0], lp_reference_percent[1]);
+}
+
+#else
+
+// LP core sampling disabled (or native build)
+bool lp_sampler_woke_from_lp() { return false; }
+uint32_t lp_sampler_wake_reason() { return LP_WAKE_NONE; }
+int lp_sampler_ingest(FuelReading* tank1, FuelReading* tank2) {
+    (void)tank1;
+    (void)tank2;
+    return 0;
+}
+bool lp_sampler_start_and_sleep(float tank1_percent, float tank2_percent) {
+    (void)tank1_percent;
+    (void)tank2_percent;
+    return false;
+}
+bool lp_sampler_resume_and_sleep() { return false; }
+
+#endif
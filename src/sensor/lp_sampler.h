@@ -0,0 +1,87 @@
+#ifndef LP_SAMPLER_H
+#define LP_SAMPLER_H
+
+#include "config.h"
+#include "fuel_sensor.h"
+#include "lp_sample_logic.h"
+#include <stdint.h>
+
+/**
+ * @brief Check if this boot is a wake-up requested by the LP core
+ * @return true if the HP core was woken by the LP sampling program
+ */
+bool lp_sampler_woke_from_lp();
+
+/**
+ * @brief Get the wake reason flags left by the LP core (LP_WAKE_*)
+ */
+uint32_t lp_sampler_wake_reason();
+
+/**
+ * @brief Drain the LP SRAM buffer into the normal fuel_sensor pipeline
+ * @param tank1 Output: last damped reading for tank 1 (may be nullptr)
+ * @param tank2 Output: last damped reading for tank 2 (may be nullptr)
+ * @return Number of samples ingested
+ */
+int lp_sampler_ingest(FuelReading* tank1, FuelReading* tank2);
+
+/**
+ * @brief Track ignition state from the brightness input voltage
+ * @param ignition_volts Input voltage on the brightness/dimmer channel
+ * @param now_ms Current time in milliseconds
+ * @return true once ignition has been off for LP_IGNITION_OFF_DELAY_MS
+ */
+bool lp_sampler_ignition_off(float ignition_volts, uint32_t now_ms);
+
+/**
+ * @brief Start the LP-core sampling program and put the HP core to sleep
+ * Thresholds are derived from the current levels, which are kept in RTC
+ * memory as the reference for later buffer-full wakes. Does not return on
+ * success (the next wake-up is a fresh boot).
+ * @param tank1_percent Current filtered tank 1 level
+ * @param tank2_percent Current filtered tank 2 level
+ * @return false if the LP core could not be started
+ */
+bool lp_sampler_start_and_sleep(float tank1_percent, float tank2_percent);
+
+/**
+ * @brief Restart LP-core sampling after a buffer-full wake and sleep again
+ * Thresholds are re-armed from the reference levels stored by
+ * lp_sampler_start_and_sleep(), so a slow leak spread over several
+ * buffer-full wakes still raises LP_WAKE_LEVEL_DROP.
+ * @return false if the LP core could not be started
+ */
+bool lp_sampler_resume_and_sleep();
+
+// ============================================================================
+// Hardware-independent helpers (for unit testing without hardware)
+// ============================================================================
+
+/**
+ * @brief Initialize shared state with integer thresholds for the current levels
+ * @param s Shared state to configure
+ * @param tank1_percent Current filtered tank 1 level
+ * @param tank2_percent Current filtered tank 2 level
+ */
+void lp_sampler_configure(LpSampleState* s, float tank1_percent, float tank2_percent);
+
+/**
+ * @brief Feed a batch of decimated samples through the fuel_sensor pipeline
+ * Samples are timestamped backwards from last_timestamp_us at the
+ * decimated interval so the time-aware EMA sees their real spacing.
+ * @param samples Samples, oldest first
+ * @param count Number of samples
+ * @param last_timestamp_us Timestamp to assign to the newest sample
+ * @param tank1 Output: last damped reading for tank 1 (may be nullptr)
+ * @param tank2 Output: last damped reading for tank 2 (may be nullptr)
+ * @return Number of samples ingested
+ */
+int lp_sampler_ingest_batch(const LpSample* samples, int count, uint32_t last_timestamp_us,
+                            FuelReading* tank1, FuelReading* tank2);
+
+/**
+ * @brief Pure calculation: Brightness input voltage to raw ADC code
+ */
+uint16_t calc_ignition_volts_to_adc(float volts);
+
+#endif // LP_SAMPLER_H
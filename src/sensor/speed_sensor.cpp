@@ -0,0 +1,77 @@
+#include "speed_sensor.h"
+
+#ifndef NATIVE_BUILD
+#include <Arduino.h>
+#include "driver/pulse_cnt.h"
+#endif
+
+// Hardware counter limit. With accum_count the driver folds the counter
+// into a software total each time this watch point is hit, so the CPU
+// sees one interrupt per SPEED_PCNT_HIGH_LIMIT pulses instead of per pulse.
+#define SPEED_PCNT_HIGH_LIMIT  30000
+
+#ifndef NATIVE_BUILD
+
+static pcnt_unit_handle_t pcnt_unit = nullptr;
+
+bool speed_sensor_init() {
+#if TRIP_COMPUTER_ENABLE
+    pinMode(PIN_SPEED_PULSE, INPUT);
+
+    pcnt_unit_config_t unit_config = {};
+    unit_config.low_limit = -SPEED_PCNT_HIGH_LIMIT;
+    unit_config.high_limit = SPEED_PCNT_HIGH_LIMIT;
+    unit_config.flags.accum_count = 1;
+    if (pcnt_new_unit(&unit_config, &pcnt_unit) != ESP_OK) {
+        Serial.println("[SPEED] ERROR: Failed to create PCNT unit");
+        pcnt_unit = nullptr;
+        return false;
+    }
+
+    pcnt_glitch_filter_config_t filter_config = {};
+    filter_config.max_glitch_ns = SPEED_PCNT_GLITCH_NS;
+    pcnt_unit_set_glitch_filter(pcnt_unit, &filter_config);
+
+    // Count rising edges only, no level gating
+    pcnt_chan_config_t chan_config = {};
+    chan_config.edge_gpio_num = PIN_SPEED_PULSE;
+    chan_config.level_gpio_num = -1;
+    pcnt_channel_handle_t channel = nullptr;
+    if (pcnt_new_channel(pcnt_unit, &chan_config, &channel) != ESP_OK) {
+        Serial.println("[SPEED] ERROR: Failed to create PCNT channel");
+        return false;
+    }
+    pcnt_channel_set_edge_action(channel, PCNT_CHANNEL_EDGE_ACTION_INCREASE,
+                                 PCNT_CHANNEL_EDGE_ACTION_HOLD);
+    pcnt_channel_set_level_action(channel, PCNT_CHANNEL_LEVEL_ACTION_KEEP,
+                                  PCNT_CHANNEL_LEVEL_ACTION_KEEP);
+
+    pcnt_unit_add_watch_point(pcnt_unit, SPEED_PCNT_HIGH_LIMIT);
+    pcnt_unit_enable(pcnt_unit);
+    pcnt_unit_clear_count(pcnt_unit);
+    pcnt_unit_start(pcnt_unit);
+
+    Serial.print("[SPEED] Pulse counter started on GPIO");
+    Serial.println(PIN_SPEED_PULSE);
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint32_t speed_sensor_get_count() {
+    if (!pcnt_unit) {
+        return 0;
+    }
+    int count = 0;
+    pcnt_unit_get_count(pcnt_unit, &count);
+    return (uint32_t)count;
+}
+
+#else
+
+// Native build stubs
+bool speed_sensor_init() { return true; }
+uint32_t speed_sensor_get_count() { return 0; }
+
+#endif
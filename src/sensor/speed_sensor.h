@@ -0,0 +1,21 @@
+#ifndef SPEED_SENSOR_H
+#define SPEED_SENSOR_H
+
+#include "config.h"
+#include <stdint.h>
+
+/**
+ * @brief Initialize hardware pulse counting (PCNT) on PIN_SPEED_PULSE
+ * Pulses are counted by the peripheral; the CPU only reads the total.
+ * @return true if the counter was started
+ */
+bool speed_sensor_init();
+
+/**
+ * @brief Get the total number of pulses counted since init
+ * The value wraps at 2^32; consumers should use unsigned differences.
+ * @return Free-running pulse count
+ */
+uint32_t speed_sensor_get_count();
+
+#endif // SPEED_SENSOR_H
@@ -0,0 +1,111 @@
+#include "tank_aggregate.h"
+
+// ============================================================================
+// Pure calculation functions (hardware-independent, testable)
+// ============================================================================
+
+float calc_percent_to_gallons(float percent, float capacity_gallons) {
+    if (percent < 0.0f) percent = 0.0f;
+    if (percent > 100.0f) percent = 100.0f;
+    return (percent / 100.0f) * capacity_gallons;
+}
+
+float calc_transfer_rate(float rate1, float rate2, float min_rate) {
+    // Transfer requires opposite signs - both falling is consumption,
+    // both rising is refueling
+    if (rate1 <= -min_rate && rate2 >= min_rate) {
+        // Tank 1 draining into tank 2
+        return (-rate1 < rate2) ? -rate1 : rate2;
+    }
+    if (rate2 <= -min_rate && rate1 >= min_rate) {
+        // Tank 2 draining into tank 1
+        return (-rate2 < rate1) ? rate2 : -rate1;
+    }
+    return 0.0f;
+}
+
+// Round half away from zero (display rounding for signed values)
+static int16_t round_to_int(float value) {
+    return (int16_t)(value >= 0.0f ? value + 0.5f : value - 0.5f);
+}
+
+// ============================================================================
+// Aggregation
+// ============================================================================
+
+void tank_aggregate_init(TankAggregate* agg) {
+    agg->total_gallons = 0.0f;
+    agg->imbalance_gallons = 0.0f;
+    agg->rate1_gpm = 0.0f;
+    agg->rate2_gpm = 0.0f;
+    agg->transfer_gpm = 0.0f;
+    agg->window_pct1 = 0.0f;
+    agg->window_pct2 = 0.0f;
+    agg->window_start_ms = 0;
+    agg->initialized = false;
+}
+
+void tank_aggregate_update(TankAggregate* agg, float tank1_percent,
+                           float tank2_percent, uint32_t now_ms) {
+    float gal1 = calc_percent_to_gallons(tank1_percent, TANK_CAPACITY_GALLONS);
+    float gal2 = calc_percent_to_gallons(tank2_percent, TANK_CAPACITY_GALLONS);
+
+    agg->total_gallons = gal1 + gal2;
+    agg->imbalance_gallons = gal1 - gal2;
+
+    if (!agg->initialized) {
+        // First sample - open the rate window
+        agg->window_pct1 = tank1_percent;
+        agg->window_pct2 = tank2_percent;
+        agg->window_start_ms = now_ms;
+        agg->initialized = true;
+        return;
+    }
+
+    uint32_t elapsed = now_ms - agg->window_start_ms;
+    if (elapsed < TRANSFER_RATE_WINDOW_MS) {
+        return;  // Keep the previous rates until the window closes
+    }
+
+    // Rate over the window in gal/min
+    float minutes = elapsed / 60000.0f;
+    float delta1 = calc_percent_to_gallons(tank1_percent, TANK_CAPACITY_GALLONS) -
+                   calc_percent_to_gallons(agg->window_pct1, TANK_CAPACITY_GALLONS);
+    float delta2 = calc_percent_to_gallons(tank2_percent, TANK_CAPACITY_GALLONS) -
+                   calc_percent_to_gallons(agg->window_pct2, TANK_CAPACITY_GALLONS);
+
+    agg->rate1_gpm = delta1 / minutes;
+    agg->rate2_gpm = delta2 / minutes;
+    agg->transfer_gpm = calc_transfer_rate(agg->rate1_gpm, agg->rate2_gpm,
+                                           TRANSFER_MIN_RATE_GPM);
+
+    // Start the next window
+    agg->window_pct1 = tank1_percent;
+    agg->window_pct2 = tank2_percent;
+    agg->window_start_ms = now_ms;
+}
+
+TankSummaryView tank_aggregate_view(const TankAggregate* agg) {
+    TankSummaryView view;
+    view.total_gallons = round_to_int(agg->total_gallons);
+    view.imbalance_gallons = round_to_int(agg->imbalance_gallons);
+
+    if (agg->transfer_gpm > 0.0f) {
+        view.transfer_dir = 1;
+    } else if (agg->transfer_gpm < 0.0f) {
+        view.transfer_dir = -1;
+    } else {
+        view.transfer_dir = 0;
+    }
+
+    float rate = agg->transfer_gpm < 0.0f ? -agg->transfer_gpm : agg->transfer_gpm;
+    view.transfer_tenths = round_to_int(rate * 10.0f);
+    return view;
+}
+
+bool tank_summary_view_equal(const TankSummaryView* a, const TankSummaryView* b) {
+    return a->total_gallons == b->total_gallons &&
+           a->imbalance_gallons == b->imbalance_gallons &&
+           a->transfer_dir == b->transfer_dir &&
+           a->transfer_tenths == b->transfer_tenths;
+}
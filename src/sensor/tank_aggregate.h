@@ -0,0 +1,83 @@
+#ifndef TANK_AGGREGATE_H
+#define TANK_AGGREGATE_H
+
+#include "config.h"
+#include <stdint.h>
+
+/**
+ * @brief Combined view of both tanks, derived from the filtered levels
+ *
+ * Rates are measured over TRANSFER_RATE_WINDOW_MS so that the EMA-smoothed
+ * levels produce a stable slope. No ADC access happens here.
+ */
+typedef struct {
+    float total_gallons;        // Tank 1 + Tank 2
+    float imbalance_gallons;    // Tank 1 - Tank 2 (positive = left heavier)
+    float rate1_gpm;            // Tank 1 level rate (gal/min, negative = falling)
+    float rate2_gpm;            // Tank 2 level rate (gal/min, negative = falling)
+    float transfer_gpm;         // >0: T1 -> T2, <0: T2 -> T1, 0: no transfer
+
+    // Rate window state
+    float window_pct1;          // Tank 1 percent at window start
+    float window_pct2;          // Tank 2 percent at window start
+    uint32_t window_start_ms;   // Timestamp of window start
+    bool initialized;
+} TankAggregate;
+
+/**
+ * @brief Quantized values shown by the summary widget
+ * Compared between frames so the widget only redraws when these change
+ */
+typedef struct {
+    int16_t total_gallons;      // Rounded total
+    int16_t imbalance_gallons;  // Rounded imbalance (signed)
+    int8_t transfer_dir;        // +1: T1 -> T2, -1: T2 -> T1, 0: none
+    int16_t transfer_tenths;    // |transfer rate| in 0.1 gal/min
+} TankSummaryView;
+
+/**
+ * @brief Reset aggregation state
+ */
+void tank_aggregate_init(TankAggregate* agg);
+
+/**
+ * @brief Update aggregation from the filtered tank levels
+ * @param agg Aggregation state
+ * @param tank1_percent Filtered tank 1 level (0-100)
+ * @param tank2_percent Filtered tank 2 level (0-100)
+ * @param now_ms Current time in milliseconds
+ */
+void tank_aggregate_update(TankAggregate* agg, float tank1_percent,
+                           float tank2_percent, uint32_t now_ms);
+
+/**
+ * @brief Get the quantized display view of the aggregation
+ */
+TankSummaryView tank_aggregate_view(const TankAggregate* agg);
+
+/**
+ * @brief Check if two views would render identically
+ */
+bool tank_summary_view_equal(const TankSummaryView* a, const TankSummaryView* b);
+
+// ============================================================================
+// Pure calculation functions (for unit testing without hardware)
+// ============================================================================
+
+/**
+ * @brief Pure calculation: Percent to gallons for a given capacity
+ */
+float calc_percent_to_gallons(float percent, float capacity_gallons);
+
+/**
+ * @brief Pure calculation: Inter-tank transfer rate
+ * A transfer exists only when one tank rises while the other falls and
+ * both rates exceed min_rate. The slower of the two rates is reported.
+ * @param rate1 Tank 1 rate (gal/min)
+ * @param rate2 Tank 2 rate (gal/min)
+ * @param min_rate Minimum absolute rate per tank
+ * @return >0 for T1 -> T2, <0 for T2 -> T1, 0 for no transfer
+ */
+float calc_transfer_rate(float rate1, float rate2, float min_rate);
+
+#endif // TANK_AGGREGATE_H
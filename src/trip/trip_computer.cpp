@@ -0,0 +1,152 @@
+#include "trip_computer.h"
+
+#ifndef NATIVE_BUILD
+#include <Arduino.h>
+#include <Preferences.h>
+#endif
+
+// ============================================================================
+// Pure calculation functions (hardware-independent, testable)
+// ============================================================================
+
+int32_t calc_gallons_to_mgal(float gallons) {
+    return (int32_t)(gallons * 1000.0f + (gallons >= 0.0f ? 0.5f : -0.5f));
+}
+
+float calc_mpg(uint32_t pulses, uint32_t fuel_mgal, uint32_t pulses_per_mile) {
+    if (fuel_mgal == 0 || pulses_per_mile == 0) {
+        return 0.0f;
+    }
+    // miles / gallons = (pulses / ppm) / (mgal / 1000)
+    return ((float)pulses * 1000.0f) / ((float)fuel_mgal * (float)pulses_per_mile);
+}
+
+// ============================================================================
+// Accumulation
+// ============================================================================
+
+static void accumulator_clear(TripAccumulator* acc) {
+    acc->pulses = 0;
+    acc->fuel_used_mgal = 0;
+}
+
+void trip_init(TripComputer* tc) {
+    accumulator_clear(&tc->trip);
+    accumulator_clear(&tc->lifetime);
+    tc->last_pulse_count = 0;
+    tc->fuel_ref_mgal = 0;
+    tc->initialized = false;
+}
+
+void trip_reset(TripComputer* tc) {
+    accumulator_clear(&tc->trip);
+}
+
+bool trip_update(TripComputer* tc, uint32_t pulse_count, int32_t fuel_mgal) {
+    if (!tc->initialized) {
+        // First sample - establish references only
+        tc->last_pulse_count = pulse_count;
+        tc->fuel_ref_mgal = fuel_mgal;
+        tc->initialized = true;
+        return false;
+    }
+
+    // Distance: unsigned subtraction handles counter wrap
+    uint32_t new_pulses = pulse_count - tc->last_pulse_count;
+    tc->last_pulse_count = pulse_count;
+    tc->trip.pulses += new_pulses;
+    tc->lifetime.pulses += new_pulses;
+
+    // Fuel: the reference follows the running minimum of the filtered level.
+    // Drops are consumption; small rises (slosh, noise) are ignored so they
+    // cannot be counted twice. Over-counting is bounded by the noise amplitude.
+    bool refuel = false;
+    int32_t refuel_mgal = calc_gallons_to_mgal(TRIP_REFUEL_GALLONS);
+
+    if (fuel_mgal < tc->fuel_ref_mgal) {
+        uint32_t used = (uint32_t)(tc->fuel_ref_mgal - fuel_mgal);
+        tc->trip.fuel_used_mgal += used;
+        tc->lifetime.fuel_used_mgal += used;
+        tc->fuel_ref_mgal = fuel_mgal;
+    } else if (fuel_mgal - tc->fuel_ref_mgal >= refuel_mgal) {
+        // Level rose well beyond noise - refueled
+        tc->fuel_ref_mgal = fuel_mgal;
+        refuel = true;
+#if TRIP_RESET_ON_REFUEL
+        trip_reset(tc);
+#endif
+    }
+
+    return refuel;
+}
+
+float trip_get_miles(const TripAccumulator* acc) {
+    return (float)acc->pulses / (float)SPEED_PULSES_PER_MILE;
+}
+
+float trip_get_gallons(const TripAccumulator* acc) {
+    return (float)acc->fuel_used_mgal / 1000.0f;
+}
+
+float trip_get_mpg(const TripAccumulator* acc) {
+    return calc_mpg(acc->pulses, acc->fuel_used_mgal, SPEED_PULSES_PER_MILE);
+}
+
+float trip_get_range_miles(const TripComputer* tc, float remaining_gallons) {
+    float mpg = 0.0f;
+    if (tc->trip.pulses >= (uint32_t)TRIP_MIN_MILES_FOR_MPG * SPEED_PULSES_PER_MILE) {
+        mpg = trip_get_mpg(&tc->trip);
+    }
+    if (mpg <= 0.0f) {
+        mpg = trip_get_mpg(&tc->lifetime);
+    }
+    if (remaining_gallons < 0.0f) remaining_gallons = 0.0f;
+    return remaining_gallons * mpg;
+}
+
+// ============================================================================
+// Persistence (lifetime totals in NVS)
+// ============================================================================
+
+#ifndef NATIVE_BUILD
+
+static TripAccumulator saved_lifetime = {0, 0};
+
+void trip_storage_load(TripComputer* tc) {
+    Preferences prefs;
+    if (prefs.begin("trip", true)) {
+        tc->lifetime.pulses = prefs.getULong("pulses", 0);
+        tc->lifetime.fuel_used_mgal = prefs.getULong("fuel_mgal", 0);
+        prefs.end();
+    }
+    saved_lifetime = tc->lifetime;
+
+    Serial.print("[TRIP] Lifetime: ");
+    Serial.print(trip_get_miles(&tc->lifetime), 1);
+    Serial.print(" mi, ");
+    Serial.print(trip_get_gallons(&tc->lifetime), 2);
+    Serial.println(" gal");
+}
+
+void trip_storage_save(const TripComputer* tc) {
+    if (tc->lifetime.pulses == saved_lifetime.pulses &&
+        tc->lifetime.fuel_used_mgal == saved_lifetime.fuel_used_mgal) {
+        return;  // Unchanged - avoid flash wear
+    }
+
+    Preferences prefs;
+    if (prefs.begin("trip", false)) {
+        prefs.putULong("pulses", tc->lifetime.pulses);
+        prefs.putULong("fuel_mgal", tc->lifetime.fuel_used_mgal);
+        prefs.end();
+        saved_lifetime = tc->lifetime;
+    }
+}
+
+#else
+
+// Native build stubs
+void trip_storage_load(TripComputer* tc) { (void)tc; }
+void trip_storage_save(const TripComputer* tc) { (void)tc; }
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef TRIP_COMPUTER_H
+#define TRIP_COMPUTER_H
+
+#include "config.h"
+#include <stdint.h>
+
+/**
+ * @brief Integer distance/fuel accumulator
+ * Stored as raw pulses and milligallons so repeated updates never drift.
+ */
+typedef struct {
+    uint32_t pulses;            // Speed sensor pulses (distance)
+    uint32_t fuel_used_mgal;    // Fuel consumed in milligallons
+} TripAccumulator;
+
+/**
+ * @brief Trip computer state
+ */
+typedef struct {
+    TripAccumulator trip;       // Since last reset (or refuel)
+    TripAccumulator lifetime;   // Persistent total
+
+    uint32_t last_pulse_count;  // Last raw counter value (for wrap-safe deltas)
+    int32_t fuel_ref_mgal;      // Running-minimum fuel level reference
+    bool initialized;
+} TripComputer;
+
+/**
+ * @brief Reset all trip computer state (trip and lifetime)
+ */
+void trip_init(TripComputer* tc);
+
+/**
+ * @brief Reset the trip accumulator only
+ */
+void trip_reset(TripComputer* tc);
+
+/**
+ * @brief Feed the trip computer with the latest counter and fuel level
+ * @param tc Trip computer state
+ * @param pulse_count Free-running pulse counter (may wrap at 2^32)
+ * @param fuel_mgal Filtered total fuel level in milligallons
+ * @return true if a refuel was detected on this update
+ */
+bool trip_update(TripComputer* tc, uint32_t pulse_count, int32_t fuel_mgal);
+
+/**
+ * @brief Distance covered by an accumulator in miles
+ */
+float trip_get_miles(const TripAccumulator* acc);
+
+/**
+ * @brief Fuel used by an accumulator in gallons
+ */
+float trip_get_gallons(const TripAccumulator* acc);
+
+/**
+ * @brief Fuel economy of an accumulator
+ * @return Miles per gallon, or 0 if no fuel has been used yet
+ */
+float trip_get_mpg(const TripAccumulator* acc);
+
+/**
+ * @brief Estimated range on the remaining fuel
+ * Uses trip economy once TRIP_MIN_MILES_FOR_MPG is covered, else lifetime.
+ * @param tc Trip computer state
+ * @param remaining_gallons Fuel currently in the tanks
+ * @return Range in miles, or 0 if no economy figure is available
+ */
+float trip_get_range_miles(const TripComputer* tc, float remaining_gallons);
+
+/**
+ * @brief Load lifetime totals from flash (no-op in native build)
+ */
+void trip_storage_load(TripComputer* tc);
+
+/**
+ * @brief Save lifetime totals to flash if changed (no-op in native build)
+ */
+void trip_storage_save(const TripComputer* tc);
+
+// ============================================================================
+// Pure calculation functions (for unit testing without hardware)
+// ============================================================================
+
+/**
+ * @brief Pure calculation: Gallons to integer milligallons (rounded)
+ */
+int32_t calc_gallons_to_mgal(float gallons);
+
+/**
+ * @brief Pure calculation: Miles per gallon from pulses and milligallons
+ * @return MPG, or 0 if fuel_mgal is 0
+ */
+float calc_mpg(uint32_t pulses, uint32_t fuel_mgal, uint32_t pulses_per_mile);
+
+#endif // TRIP_COMPUTER_H
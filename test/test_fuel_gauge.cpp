@@ -1,6 +1,34 @@
 #include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
 #include "../src/sensor/fuel_sensor.h"
 #include "../src/display/gauge.h"
+#include "../src/sensor/tank_aggregate.h"
+#include "../src/trip/trip_computer.h"
+#include "../src/sensor/lp_sampler.h"
+#include "../src/display/display.h"
+#include "../src/display/draw_batch.h"
+#include "../src/display/glyph_cache.h"
+#include "../src/display/clip_region.h"
+#include "../src/display/gauge_anim.h"
+#include "../src/sensor/fuel_history.h"
+#include "../src/display/history_page.h"
+#include "../src/display/dial.h"
+#include "../src/display/gauge_widget.h"
+#include "../src/display/gauge_alert.h"
+#include "../src/display/page_compositor.h"
+#include "../src/display/trip_page.h"
+#include "../src/display/asset.h"
+#include "../src/display/asset_data.h"
+#include "../src/display/shown_value.h"
+#include "../src/modes/modes.h"
+#include "../src/display/text_format.h"
+#include "../src/display/ui_tree.h"
+#include "../src/display/layout.h"
+#include "../src/display/indexed_frame.h"
+#include "../src/display/push_pipeline.h"
 
 // ============================================================================
 // Test: ADC to Voltage Conversion
@@ -218,6 +246,2629 @@ void test_full_chain_half_tank() {
     TEST_ASSERT_FLOAT_WITHIN(5.0f, 50.0f, percent);
 }
 
+// ============================================================================
+// Test: Multi-Tank Aggregation
+// ============================================================================
+
+void test_aggregate_total_and_imbalance() {
+    TankAggregate agg;
+    tank_aggregate_init(&agg);
+    tank_aggregate_update(&agg, 50.0f, 20.0f, 0);
+    
+    // 50 gallon tanks: 25 + 10 gallons
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 35.0f, agg.total_gallons);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 15.0f, agg.imbalance_gallons);
+    
+    TankSummaryView view = tank_aggregate_view(&agg);
+    TEST_ASSERT_EQUAL_INT(35, view.total_gallons);
+    TEST_ASSERT_EQUAL_INT(15, view.imbalance_gallons);
+    TEST_ASSERT_EQUAL_INT(0, view.transfer_dir);
+}
+
+void test_transfer_rate_opposite_signs() {
+    // Tank 1 falling 2 gal/min, tank 2 rising 1.5 gal/min -> 1.5 T1->T2
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.5f, calc_transfer_rate(-2.0f, 1.5f, 0.2f));
+    // Mirror: tank 2 draining into tank 1
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -1.0f, calc_transfer_rate(1.0f, -3.0f, 0.2f));
+}
+
+void test_transfer_rate_consumption_is_not_transfer() {
+    // Both falling (engine consumption) and both rising (refuel)
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, calc_transfer_rate(-1.0f, -1.0f, 0.2f));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, calc_transfer_rate(2.0f, 2.0f, 0.2f));
+    // Below the noise threshold on one side
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, calc_transfer_rate(-1.0f, 0.1f, 0.2f));
+}
+
+void test_aggregate_detects_transfer_trace() {
+    TankAggregate agg;
+    tank_aggregate_init(&agg);
+    
+    // Synthetic trace: 1 gal/min from T1 to T2 (2% of 50 gal per minute),
+    // sampled every 50 ms for two rate windows
+    float pct1 = 60.0f;
+    float pct2 = 30.0f;
+    float pct_per_ms = 2.0f / 60000.0f;
+    for (uint32_t t = 0; t <= 2 * TRANSFER_RATE_WINDOW_MS; t += 50) {
+        tank_aggregate_update(&agg, pct1 - pct_per_ms * t, pct2 + pct_per_ms * t, t);
+    }
+    
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, -1.0f, agg.rate1_gpm);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 1.0f, agg.rate2_gpm);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 1.0f, agg.transfer_gpm);
+    
+    TankSummaryView view = tank_aggregate_view(&agg);
+    TEST_ASSERT_EQUAL_INT(1, view.transfer_dir);
+    TEST_ASSERT_EQUAL_INT(10, view.transfer_tenths);
+    // Total is conserved during a transfer
+    TEST_ASSERT_EQUAL_INT(45, view.total_gallons);
+}
+
+void test_summary_view_equal() {
+    TankAggregate agg;
+    tank_aggregate_init(&agg);
+    tank_aggregate_update(&agg, 50.0f, 50.0f, 0);
+    TankSummaryView a = tank_aggregate_view(&agg);
+    
+    // Sub-gallon change does not alter the rendered view
+    tank_aggregate_update(&agg, 50.2f, 50.0f, 50);
+    TankSummaryView b = tank_aggregate_view(&agg);
+    TEST_ASSERT_TRUE(tank_summary_view_equal(&a, &b));
+    
+    tank_aggregate_update(&agg, 54.0f, 50.0f, 100);
+    b = tank_aggregate_view(&agg);
+    TEST_ASSERT_FALSE(tank_summary_view_equal(&a, &b));
+}
+
+// ============================================================================
+// Test: Trip Computer
+// ============================================================================
+
+void test_trip_mpg_calculation() {
+    // 20 miles on 1 gallon
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 20.0f, calc_mpg(80000, 1000, 4000));
+    // No fuel used yet
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, calc_mpg(80000, 0, 4000));
+}
+
+void test_trip_distance_and_fuel_trace() {
+    TripComputer tc;
+    trip_init(&tc);
+    
+    // Synthetic trace: 10 miles at 4000 pulses/mile, fuel dropping 0.5 gal,
+    // with +/-20 mgal of slosh noise on the filtered level
+    uint32_t pulses = 0;
+    int32_t level = calc_gallons_to_mgal(30.0f);
+    trip_update(&tc, pulses, level);
+    
+    const int steps = 1000;
+    for (int i = 1; i <= steps; i++) {
+        pulses += 40;  // 40 pulses per step
+        int32_t noise = (i % 7 == 0) ? 20 : ((i % 5 == 0) ? -20 : 0);
+        trip_update(&tc, pulses, level - (500 * i) / steps + noise);
+    }
+    
+    TEST_ASSERT_EQUAL_UINT32(40000, tc.trip.pulses);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 10.0f, trip_get_miles(&tc.trip));
+    // Over-count bounded by the noise amplitude, never accumulated
+    TEST_ASSERT_UINT32_WITHIN(20, 500, tc.trip.fuel_used_mgal);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 20.0f, trip_get_mpg(&tc.trip));
+}
+
+void test_trip_counter_wrap_is_drift_free() {
+    TripComputer tc;
+    trip_init(&tc);
+    
+    // Start just below the 32-bit wrap point
+    uint32_t count = 0xFFFFFF00u;
+    trip_update(&tc, count, 10000);
+    for (int i = 0; i < 100; i++) {
+        count += 7;
+        trip_update(&tc, count, 10000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(700, tc.trip.pulses);
+    TEST_ASSERT_EQUAL_UINT32(700, tc.lifetime.pulses);
+}
+
+void test_trip_refuel_resets_trip_keeps_lifetime() {
+    TripComputer tc;
+    trip_init(&tc);
+    trip_update(&tc, 0, calc_gallons_to_mgal(10.0f));
+    trip_update(&tc, 4000, calc_gallons_to_mgal(9.0f));
+    TEST_ASSERT_EQUAL_UINT32(1000, tc.trip.fuel_used_mgal);
+    
+    // Refuel to 40 gallons
+    bool refuel = trip_update(&tc, 4000, calc_gallons_to_mgal(40.0f));
+    TEST_ASSERT_TRUE(refuel);
+    TEST_ASSERT_EQUAL_UINT32(1000, tc.lifetime.fuel_used_mgal);
+    TEST_ASSERT_EQUAL_UINT32(4000, tc.lifetime.pulses);
+#if TRIP_RESET_ON_REFUEL
+    TEST_ASSERT_EQUAL_UINT32(0, tc.trip.fuel_used_mgal);
+    TEST_ASSERT_EQUAL_UINT32(0, tc.trip.pulses);
+#endif
+    
+    // Consumption continues from the new level
+    trip_update(&tc, 8000, calc_gallons_to_mgal(39.5f));
+    TEST_ASSERT_EQUAL_UINT32(1500, tc.lifetime.fuel_used_mgal);
+}
+
+void test_trip_range_uses_economy() {
+    TripComputer tc;
+    trip_init(&tc);
+    
+    // No economy yet
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, trip_get_range_miles(&tc, 20.0f));
+    
+    // 20 mpg lifetime/trip economy, 15 gallons left -> 300 miles
+    tc.trip.pulses = 20 * SPEED_PULSES_PER_MILE;
+    tc.trip.fuel_used_mgal = 1000;
+    tc.lifetime = tc.trip;
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 300.0f, trip_get_range_miles(&tc, 15.0f));
+}
+
+// ============================================================================
+// Test: LP-Core Sampling Logic
+// ============================================================================
+
+static void lp_push_n(LpSampleState* s, uint16_t t1, uint16_t t2, uint16_t ign, int n,
+                      uint32_t* reasons) {
+    uint16_t raw[LP_CHANNELS];
+    raw[LP_CH_TANK1] = t1;
+    raw[LP_CH_TANK2] = t2;
+    raw[LP_CH_IGNITION] = ign;
+    for (int i = 0; i < n; i++) {
+        *reasons |= lp_logic_push(s, raw);
+    }
+}
+
+void test_lp_decimation_averages_samples() {
+    LpSampleState s;
+    lp_logic_init(&s, 4, 4000, 4095, 4095, 1);
+    
+    uint32_t reasons = 0;
+    lp_push_n(&s, 2000, 2100, 100, 2, &reasons);
+    TEST_ASSERT_EQUAL_UINT16(0, s.count);  // Not yet decimated
+    lp_push_n(&s, 2004, 2104, 104, 2, &reasons);
+    
+    TEST_ASSERT_EQUAL_UINT16(1, s.count);
+    LpSample out[LP_BUFFER_SIZE];
+    TEST_ASSERT_EQUAL_UINT16(1, lp_logic_drain(&s, out, LP_BUFFER_SIZE));
+    TEST_ASSERT_EQUAL_UINT16(2002, out[0].code[LP_CH_TANK1]);
+    TEST_ASSERT_EQUAL_UINT16(2102, out[0].code[LP_CH_TANK2]);
+    TEST_ASSERT_EQUAL_UINT16(102, out[0].code[LP_CH_IGNITION]);
+    TEST_ASSERT_EQUAL_UINT32(LP_WAKE_NONE, reasons);
+}
+
+void test_lp_wakes_on_ignition_and_buffer_full() {
+    LpSampleState s;
+    lp_sampler_configure(&s, 50.0f, 50.0f);
+    uint16_t tank_code = calc_percent_to_adc(50.0f, ADC_VREF, VOLTAGE_DIVIDER_R_REF,
+                                             SENDER_RESISTANCE_EMPTY, SENDER_RESISTANCE_FULL,
+                                             ADC_MAX_VALUE);
+    uint16_t ign_off = calc_ignition_volts_to_adc(1.0f);
+    uint16_t ign_on = calc_ignition_volts_to_adc(12.5f);
+    
+    // Ignition off: fill the buffer exactly once
+    uint32_t reasons = 0;
+    lp_push_n(&s, tank_code, tank_code, ign_off, LP_DECIMATION * LP_BUFFER_SIZE, &reasons);
+    TEST_ASSERT_EQUAL_UINT32(LP_WAKE_BUFFER_FULL, reasons);
+    
+    // A single noisy raw sample above threshold does not wake
+    LpSample out[LP_BUFFER_SIZE];
+    lp_logic_drain(&s, out, LP_BUFFER_SIZE);
+    reasons = 0;
+    lp_push_n(&s, tank_code, tank_code, ign_on, 1, &reasons);
+    lp_push_n(&s, tank_code, tank_code, ign_off, LP_DECIMATION - 1, &reasons);
+    TEST_ASSERT_EQUAL_UINT32(LP_WAKE_NONE, reasons);
+    
+    // Sustained ignition voltage wakes the HP core
+    lp_push_n(&s, tank_code, tank_code, ign_on, LP_DECIMATION, &reasons);
+    TEST_ASSERT_TRUE(reasons & LP_WAKE_IGNITION);
+}
+
+void test_lp_wakes_on_level_drop() {
+    LpSampleState s;
+    lp_sampler_configure(&s, 60.0f, 60.0f);
+    uint16_t code_60 = calc_percent_to_adc(60.0f, ADC_VREF, VOLTAGE_DIVIDER_R_REF,
+                                           SENDER_RESISTANCE_EMPTY, SENDER_RESISTANCE_FULL,
+                                           ADC_MAX_VALUE);
+    uint16_t code_58 = calc_percent_to_adc(58.0f, ADC_VREF, VOLTAGE_DIVIDER_R_REF,
+                                           SENDER_RESISTANCE_EMPTY, SENDER_RESISTANCE_FULL,
+                                           ADC_MAX_VALUE);
+    uint16_t code_50 = calc_percent_to_adc(50.0f, ADC_VREF, VOLTAGE_DIVIDER_R_REF,
+                                           SENDER_RESISTANCE_EMPTY, SENDER_RESISTANCE_FULL,
+                                           ADC_MAX_VALUE);
+    uint16_t ign_off = calc_ignition_volts_to_adc(0.0f);
+    
+    uint32_t reasons = 0;
+    lp_push_n(&s, code_58, code_60, ign_off, LP_DECIMATION, &reasons);
+    TEST_ASSERT_EQUAL_UINT32(LP_WAKE_NONE, reasons);  // Within LP_LEVEL_DROP_PERCENT
+    lp_push_n(&s, code_60, code_50, ign_off, LP_DECIMATION, &reasons);
+    TEST_ASSERT_EQUAL_UINT32(LP_WAKE_LEVEL_DROP, reasons);
+}
+
+void test_lp_slow_leak_across_buffer_full_wakes() {
+    // Re-arming from the hand-off level, not the latest reading
+    LpSampleState s;
+    lp_sampler_configure(&s, 60.0f, 60.0f);
+    uint16_t code_60 = calc_percent_to_adc(60.0f, ADC_VREF, VOLTAGE_DIVIDER_R_REF,
+                                           SENDER_RESISTANCE_EMPTY, SENDER_RESISTANCE_FULL,
+                                           ADC_MAX_VALUE);
+    uint16_t code_57 = calc_percent_to_adc(57.0f, ADC_VREF, VOLTAGE_DIVIDER_R_REF,
+                                           SENDER_RESISTANCE_EMPTY, SENDER_RESISTANCE_FULL,
+                                           ADC_MAX_VALUE);
+    uint16_t code_54 = calc_percent_to_adc(54.0f, ADC_VREF, VOLTAGE_DIVIDER_R_REF,
+                                           SENDER_RESISTANCE_EMPTY, SENDER_RESISTANCE_FULL,
+                                           ADC_MAX_VALUE);
+    uint16_t ign_off = calc_ignition_volts_to_adc(0.0f);
+    
+    // First buffer: a 3% loss only fills the buffer
+    uint32_t reasons = 0;
+    lp_push_n(&s, code_57, code_60, ign_off, LP_DECIMATION * LP_BUFFER_SIZE, &reasons);
+    TEST_ASSERT_EQUAL_UINT32(LP_WAKE_BUFFER_FULL, reasons);
+    
+    // Re-armed from 60%: another 3% crosses LP_LEVEL_DROP_PERCENT
+    LpSample out[LP_BUFFER_SIZE];
+    lp_logic_drain(&s, out, LP_BUFFER_SIZE);
+    lp_sampler_configure(&s, 60.0f, 60.0f);
+    reasons = 0;
+    lp_push_n(&s, code_54, code_60, ign_off, LP_DECIMATION, &reasons);
+    TEST_ASSERT_EQUAL_UINT32(LP_WAKE_LEVEL_DROP, reasons);
+    
+    // Re-armed from the latest 57% reading, the same leak goes unnoticed
+    lp_sampler_configure(&s, 57.0f, 60.0f);
+    reasons = 0;
+    lp_push_n(&s, code_54, code_60, ign_off, LP_DECIMATION, &reasons);
+    TEST_ASSERT_EQUAL_UINT32(LP_WAKE_NONE, reasons);
+}
+
+void test_lp_batch_ingest_through_pipeline() {
+    LpSampleState s;
+    lp_sampler_configure(&s, 50.0f, 50.0f);
+    uint16_t code_25 = calc_percent_to_adc(25.0f, ADC_VREF, VOLTAGE_DIVIDER_R_REF,
+                                           SENDER_RESISTANCE_EMPTY, SENDER_RESISTANCE_FULL,
+                                           ADC_MAX_VALUE);
+    uint16_t code_75 = calc_percent_to_adc(75.0f, ADC_VREF, VOLTAGE_DIVIDER_R_REF,
+                                           SENDER_RESISTANCE_EMPTY, SENDER_RESISTANCE_FULL,
+                                           ADC_MAX_VALUE);
+    uint32_t reasons = 0;
+    lp_push_n(&s, code_25, code_75, 0, LP_DECIMATION * 4, &reasons);
+    
+    LpSample batch[LP_BUFFER_SIZE];
+    int n = lp_logic_drain(&s, batch, LP_BUFFER_SIZE);
+    TEST_ASSERT_EQUAL_INT(4, n);
+    TEST_ASSERT_EQUAL_UINT16(0, s.count);
+    
+    FuelReading r1;
+    FuelReading r2;
+    fuel_sensor_reset_damping();
+    TEST_ASSERT_EQUAL_INT(4, lp_sampler_ingest_batch(batch, n, 10000000, &r1, &r2));
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 25.0f, r1.percent);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 75.0f, r2.percent);
+    TEST_ASSERT_TRUE(r1.valid);
+    fuel_sensor_reset_damping();
+}
+
+// ============================================================================
+// Test: Time-Aware Damping
+// ============================================================================
+
+void test_ema_alpha_limits() {
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.0f, calc_ema_alpha(0.0f, 0.5f));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 1.0f, calc_ema_alpha(0.05f, 0.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.632f, calc_ema_alpha(0.5f, 0.5f));
+}
+
+void test_ema_time_constant_with_irregular_steps() {
+    // Jittery intervals (ms) summing to exactly 1000ms = tau
+    const int steps_ms[] = {13, 97, 50, 3, 180, 42, 66, 250, 9, 120, 70, 100};
+    const float tau_s = 1.0f;
+    float value = 0.0f;
+    int total_ms = 0;
+    for (unsigned i = 0; i < sizeof(steps_ms) / sizeof(steps_ms[0]); i++) {
+        value = calc_ema_step(value, 100.0f, steps_ms[i] / 1000.0f, tau_s);
+        total_ms += steps_ms[i];
+    }
+    TEST_ASSERT_EQUAL_INT(1000, total_ms);
+    // Step response reaches 1 - 1/e after one time constant
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 63.21f, value);
+}
+
+void test_ema_response_independent_of_sample_rate() {
+    // Same 2 seconds at 10ms and at 200ms intervals
+    float fast = 0.0f;
+    float slow = 0.0f;
+    for (int i = 0; i < 200; i++) fast = calc_ema_step(fast, 100.0f, 0.010f, 0.5f);
+    for (int i = 0; i < 10; i++) slow = calc_ema_step(slow, 100.0f, 0.200f, 0.5f);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, fast, slow);
+}
+
+void test_ingest_uses_sample_timestamps() {
+    uint16_t code_0 = calc_percent_to_adc(0.0f, ADC_VREF, VOLTAGE_DIVIDER_R_REF,
+                                          SENDER_RESISTANCE_EMPTY, SENDER_RESISTANCE_FULL,
+                                          ADC_MAX_VALUE);
+    uint16_t code_100 = calc_percent_to_adc(100.0f, ADC_VREF, VOLTAGE_DIVIDER_R_REF,
+                                            SENDER_RESISTANCE_EMPTY, SENDER_RESISTANCE_FULL,
+                                            ADC_MAX_VALUE);
+    fuel_sensor_reset_damping();
+    // Seed near the 32-bit wrap to check wrap-safe intervals
+    uint32_t t_us = 0xFFFFFFFFu - 100000u;
+    FuelReading r = fuel_sensor_ingest_raw(1, code_0, t_us);
+    TEST_ASSERT_EQUAL_UINT32(t_us, r.timestamp_us);
+
+    // Irregular steps covering one time constant
+    const uint32_t steps_us[] = {7000, 93000, 150000, 20000, 230000};
+    uint32_t total_us = 0;
+    for (unsigned i = 0; i < sizeof(steps_us) / sizeof(steps_us[0]); i++) {
+        t_us += steps_us[i];
+        total_us += steps_us[i];
+        r = fuel_sensor_ingest_raw(1, code_100, t_us);
+    }
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(FUEL_DAMPING_TAU_S * 1000000.0f), total_us);
+#if FUEL_DAMPING_ENABLE
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 63.2f, r.percent);
+#endif
+    fuel_sensor_reset_damping();
+}
+
+// ============================================================================
+// Test: Batch Conversion
+// ============================================================================
+
+#define BATCH_TEST_SAMPLES    (ADC_MAX_VALUE + 1)
+#define BATCH_BENCH_REPEATS   256
+
+static uint16_t batch_raw[BATCH_TEST_SAMPLES];
+static float batch_voltage[BATCH_TEST_SAMPLES];
+static float batch_resistance[BATCH_TEST_SAMPLES];
+static float batch_percent[BATCH_TEST_SAMPLES];
+static uint8_t batch_valid[BATCH_TEST_SAMPLES];
+
+static double bench_now_s() {
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void test_batch_matches_scalar_chain() {
+    for (int i = 0; i < BATCH_TEST_SAMPLES; i++) {
+        batch_raw[i] = (uint16_t)i;
+    }
+    FuelReadingBatch out = {batch_voltage, batch_resistance, batch_percent, batch_valid};
+    TEST_ASSERT_EQUAL_INT(BATCH_TEST_SAMPLES,
+                          fuel_sensor_convert_batch(batch_raw, BATCH_TEST_SAMPLES, &out));
+    
+    // Every ADC code must match the scalar calc_* chain bit for bit
+    for (int i = 0; i < BATCH_TEST_SAMPLES; i++) {
+        float v = fuel_sensor_adc_to_voltage(batch_raw[i]);
+        float r = fuel_sensor_voltage_to_resistance(v);
+        float p = fuel_sensor_resistance_to_percent(r);
+        TEST_ASSERT_EQUAL_FLOAT(v, batch_voltage[i]);
+        TEST_ASSERT_EQUAL_FLOAT(r, batch_resistance[i]);
+        TEST_ASSERT_EQUAL_FLOAT(p, batch_percent[i]);
+        TEST_ASSERT_EQUAL_UINT8(fuel_sensor_is_valid_resistance(r) ? 1 : 0, batch_valid[i]);
+        
+        FuelReading single = fuel_sensor_convert_raw(batch_raw[i], 0);
+        TEST_ASSERT_EQUAL_FLOAT(p, single.percent);
+    }
+}
+
+void test_batch_convert_throughput() {
+    FuelReadingBatch out = {batch_voltage, batch_resistance, batch_percent, batch_valid};
+    const double samples = (double)BATCH_TEST_SAMPLES * BATCH_BENCH_REPEATS;
+    volatile float sink = 0.0f;
+    
+    // Scalar loop: one FuelReading at a time through the calc_* chain
+    double t0 = bench_now_s();
+    for (int rep = 0; rep < BATCH_BENCH_REPEATS; rep++) {
+        for (int i = 0; i < BATCH_TEST_SAMPLES; i++) {
+            float v = fuel_sensor_adc_to_voltage(batch_raw[i]);
+            float r = fuel_sensor_voltage_to_resistance(v);
+            batch_percent[i] = fuel_sensor_resistance_to_percent(r);
+            batch_valid[i] = fuel_sensor_is_valid_resistance(r);
+        }
+        sink = sink + batch_percent[rep];
+    }
+    double scalar_s = bench_now_s() - t0;
+    
+    t0 = bench_now_s();
+    for (int rep = 0; rep < BATCH_BENCH_REPEATS; rep++) {
+        fuel_sensor_convert_batch(batch_raw, BATCH_TEST_SAMPLES, &out);
+        sink = sink + batch_percent[rep];
+    }
+    double batch_s = bench_now_s() - t0;
+    (void)sink;
+    
+    char msg[128];
+    snprintf(msg, sizeof(msg), "convert: scalar %.1f Msamples/s, batch %.1f Msamples/s",
+             samples / scalar_s / 1e6, samples / batch_s / 1e6);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(batch_s > 0.0 && scalar_s > 0.0);
+}
+
+// ============================================================================
+// Test: Display Host Harness / Gauge Composition
+// ============================================================================
+
+#define TEST_GAUGE_X          15
+#define TEST_GAUGE_Y          19
+#define TEST_BAR_HEIGHT       (GAUGE_SEGMENT_COUNT * (GAUGE_SEGMENT_HEIGHT + GAUGE_SEGMENT_GAP) - GAUGE_SEGMENT_GAP + 2)
+
+static uint16_t saved_frame[LCD_WIDTH * LCD_HEIGHT];
+
+static void save_frame() {
+    memcpy(saved_frame, display_host_framebuffer(), sizeof(saved_frame));
+}
+
+static int count_frame_diffs() {
+    const uint16_t* fb = display_host_framebuffer();
+    int diffs = 0;
+    for (int i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++) {
+        if (fb[i] != saved_frame[i]) diffs++;
+    }
+    return diffs;
+}
+
+// Draw a gauge the uncomposed way (every primitive straight to the panel)
+static void draw_gauge_direct(float percent) {
+    gauge_draw_gallons(TEST_GAUGE_X, TEST_GAUGE_Y - 18, percent);
+    gauge_redraw_bar(TEST_GAUGE_X, TEST_GAUGE_Y, percent);
+    gauge_draw_percentage(TEST_GAUGE_X, TEST_GAUGE_Y + TEST_BAR_HEIGHT + ScreenLayout::PERCENT_GAP, percent);
+}
+
+void test_host_harness_draws_pixels() {
+    display_init();
+    display_fill_rect(10, 10, 4, 3, UI_COLOR_RED);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, display_host_get_pixel(13, 12));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BACKGROUND, display_host_get_pixel(14, 12));
+    
+    display_stats_reset();
+    display_set_text_size(2);
+    display_set_text_color(UI_COLOR_TEXT);
+    display_set_cursor(0, 0);
+    display_print("1");
+    // '1' has a full-height stem in column 2
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_TEXT, display_host_get_pixel(4, 6));
+    TEST_ASSERT_TRUE(display_stats_get().transactions > 1);
+}
+
+void test_gauge_sprite_single_transfer() {
+    display_init();
+    display_stats_reset();
+    draw_gauge_direct(57.0f);
+    DisplayStats direct = display_stats_get();
+    save_frame();
+    
+    display_init();
+    display_stats_reset();
+    gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, 57.0f, 1);
+    DisplayStats composed = display_stats_get();
+    
+    char msg[96];
+    snprintf(msg, sizeof(msg), "gauge draw: direct %u transactions, composed %u",
+             (unsigned)direct.transactions, (unsigned)composed.transactions);
+    TEST_MESSAGE(msg);
+    
+#if GAUGE_SPRITE_ENABLE
+    TEST_ASSERT_EQUAL_UINT32(1, composed.transactions);
+    TEST_ASSERT_TRUE(direct.transactions > composed.transactions);
+#endif
+    // Same picture either way
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+}
+
+// ============================================================================
+// Test: Incremental Bar Updates
+// ============================================================================
+
+void test_delta_rows_match_full_redraw() {
+    const float levels[][2] = {
+        {50.0f, 50.4f},    // One pixel up
+        {50.0f, 49.6f},    // One pixel down
+        {12.0f, 63.0f},    // Across zones and many segments
+        {95.0f, 3.0f},     // Large drop
+        {0.0f, 100.0f},    // Empty to full
+        {100.0f, 0.0f},    // Full to empty
+        {64.9f, 65.1f},    // Segment boundary
+    };
+    for (unsigned i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+        // Reference: full redraw at the new level
+        display_init();
+        gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, levels[i][1], 1);
+        save_frame();
+        
+        // Incremental: full draw at the old level, then update
+        display_init();
+        gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, levels[i][0], 1);
+        gauge_update_if_changed(TEST_GAUGE_X, TEST_GAUGE_Y, levels[i][0], levels[i][1], 1);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, count_frame_diffs(), "incremental differs from full redraw");
+    }
+}
+
+void test_delta_rows_one_pixel_cost() {
+    display_init();
+    gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, 50.0f, 1);
+    
+    display_stats_reset();
+    int old_pixels = gauge_get_fill_pixels(50.0f);
+    gauge_update_bar_rows(TEST_GAUGE_X, TEST_GAUGE_Y, old_pixels, old_pixels + 1);
+    DisplayStats s = display_stats_get();
+    TEST_ASSERT_EQUAL_UINT32(1, s.transactions);
+    TEST_ASSERT_EQUAL_UINT32(GAUGE_WIDTH - 2, s.pixels);
+}
+
+// ============================================================================
+// Test: Draw Command Batching
+// ============================================================================
+
+void test_draw_batch_coalesces() {
+    static DrawBatch b;
+    draw_batch_clear(&b);
+    
+    // Two stacked same-color rows sharing a full edge merge into one
+    draw_batch_add(&b, 10, 10, 20, 5, UI_COLOR_GREEN);
+    draw_batch_add(&b, 10, 15, 20, 5, UI_COLOR_GREEN);
+    TEST_ASSERT_EQUAL_INT(1, b.count);
+    TEST_ASSERT_EQUAL_INT16(10, b.cmds[0].h);
+    
+    // A rect inside an existing same-color rect is dropped
+    draw_batch_add(&b, 12, 12, 4, 4, UI_COLOR_GREEN);
+    TEST_ASSERT_EQUAL_INT(1, b.count);
+    
+    // A rect that covers an earlier one replaces it
+    draw_batch_add(&b, 0, 0, 40, 40, UI_COLOR_EMPTY);
+    TEST_ASSERT_EQUAL_INT(1, b.count);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_EMPTY, b.cmds[0].color);
+    
+    // Overlapping commands keep painter's order through the sort
+    draw_batch_add(&b, 5, 5, 10, 10, UI_COLOR_RED);
+    draw_batch_add(&b, 50, 0, 10, 10, UI_COLOR_YELLOW);
+    draw_batch_sort(&b);
+    TEST_ASSERT_EQUAL_INT(3, b.count);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_EMPTY, b.cmds[0].color);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, b.cmds[2].color);
+}
+
+void test_frame_batch_gauge_identical() {
+    display_init();
+    display_stats_reset();
+    draw_gauge_direct(57.0f);
+    DisplayStats direct = display_stats_get();
+    save_frame();
+    
+    display_init();
+    display_stats_reset();
+    display_frame_begin();
+    draw_gauge_direct(57.0f);
+    DisplayStats frame = display_frame_end();
+    
+    char msg[112];
+    snprintf(msg, sizeof(msg), "frame batch: %u primitives in, %u transactions out (unbatched %u)",
+             (unsigned)frame.primitives, (unsigned)frame.transactions,
+             (unsigned)direct.transactions);
+    TEST_MESSAGE(msg);
+    
+    TEST_ASSERT_EQUAL_UINT32(direct.primitives, frame.primitives);
+#if DISPLAY_BATCH_ENABLE
+    // The gauge already draws its frame and padding as merged rects, so
+    // batching has nothing left to coalesce here; it must not add any
+    TEST_ASSERT_TRUE(frame.transactions <= direct.transactions);
+#endif
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+}
+
+// Two columns painted one row at a time, as a row-by-row caller would
+static void draw_row_fills() {
+    for (int16_t row = 0; row < 20; row++) {
+        display_fill_rect(40, 100 + row, 30, 1, UI_COLOR_GREEN);
+        display_fill_rect(80, 100 + row, 30, 1, UI_COLOR_RED);
+    }
+}
+
+void test_frame_batch_coalesces_row_fills() {
+    display_init();
+    display_stats_reset();
+    draw_row_fills();
+    DisplayStats direct = display_stats_get();
+    save_frame();
+    
+    display_init();
+    display_stats_reset();
+    display_frame_begin();
+    draw_row_fills();
+    DisplayStats frame = display_frame_end();
+    display_wait();
+    
+    char msg[112];
+    snprintf(msg, sizeof(msg), "row fills: %u primitives in, %u transactions out (unbatched %u)",
+             (unsigned)frame.primitives, (unsigned)frame.transactions,
+             (unsigned)direct.transactions);
+    TEST_MESSAGE(msg);
+    
+    TEST_ASSERT_EQUAL_UINT32(direct.primitives, frame.primitives);
+#if DISPLAY_BATCH_ENABLE
+    TEST_ASSERT_TRUE(frame.transactions < direct.transactions);
+#endif
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+}
+
+// ============================================================================
+// Test: Row-Color Bar Streaming
+// ============================================================================
+
+void test_row_stream_matches_bar() {
+    const float levels[] = {0.0f, 3.0f, 24.6f, 50.0f, 64.9f, 99.5f, 100.0f};
+    for (unsigned i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+        display_init();
+        gauge_redraw_bar(TEST_GAUGE_X, TEST_GAUGE_Y, levels[i]);
+        save_frame();
+        
+        display_init();
+        display_stats_reset();
+        gauge_stream_bar(TEST_GAUGE_X, TEST_GAUGE_Y, levels[i]);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, count_frame_diffs(), "streamed bar differs");
+        // 8 frame fills plus one window for the whole segment area
+        TEST_ASSERT_EQUAL_UINT32(9, display_stats_get().transactions);
+    }
+}
+
+void test_row_stream_vs_sprite_benchmark() {
+    const int iterations = 500;
+    const int16_t region_w = GAUGE_WIDTH + 2;
+    const int16_t region_h = TEST_BAR_HEIGHT + 2;
+    
+    display_init();
+    display_stats_reset();
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        display_canvas_begin(TEST_GAUGE_X - 1, TEST_GAUGE_Y - 1, region_w, region_h);
+        gauge_redraw_bar(TEST_GAUGE_X, TEST_GAUGE_Y, (float)(i % 101));
+        display_canvas_end();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    DisplayStats sprite = display_stats_get();
+    save_frame();
+    
+    display_init();
+    display_stats_reset();
+    auto t2 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        gauge_stream_bar(TEST_GAUGE_X, TEST_GAUGE_Y, (float)(i % 101));
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    DisplayStats stream = display_stats_get();
+    
+    double sprite_us = std::chrono::duration<double, std::micro>(t1 - t0).count() / iterations;
+    double stream_us = std::chrono::duration<double, std::micro>(t3 - t2).count() / iterations;
+    char msg[200];
+    snprintf(msg, sizeof(msg),
+             "bar repaint: sprite %u B RAM, %u tx, %u B bus, %.1f us host | "
+             "stream %u B RAM, %u tx, %u B bus, %.1f us host",
+             (unsigned)(region_w * region_h * 2), (unsigned)(sprite.transactions / iterations),
+             (unsigned)(sprite.pixels * 2 / iterations), sprite_us,
+             (unsigned)(GAUGE_BAR_ROWS * 2), (unsigned)(stream.transactions / iterations),
+             (unsigned)(stream.pixels * 2 / iterations), stream_us);
+    TEST_MESSAGE(msg);
+    
+    // Same final picture; the stream never sends more pixels than the sprite
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+    TEST_ASSERT_TRUE(stream.pixels <= sprite.pixels);
+}
+
+// ============================================================================
+// Test: Row Color Table
+// ============================================================================
+
+#if !GAUGE_GRADIENT_ENABLE
+// Zone color of a segment as the renderer computed it before the row table
+static uint16_t reference_segment_color(int seg) {
+    float segment_percent = ((float)seg / (float)GAUGE_SEGMENT_COUNT) * 100.0f;
+    if (segment_percent < FUEL_THRESHOLD_RED) return UI_COLOR_RED;
+    if (segment_percent < FUEL_THRESHOLD_YELLOW) return UI_COLOR_YELLOW;
+    return UI_COLOR_GREEN;
+}
+#endif
+
+void test_row_lut_discrete_pixel_identical() {
+#if !GAUGE_GRADIENT_ENABLE
+    const int pitch = GAUGE_SEGMENT_HEIGHT + GAUGE_SEGMENT_GAP;
+    const float levels[] = {0.0f, 7.3f, 20.0f, 33.3f, 64.9f, 100.0f};
+    for (unsigned i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+        display_init();
+        gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, levels[i], 1);
+        int fill = gauge_get_fill_pixels(levels[i]);
+        
+        // Every row of the segment area, across its full width
+        for (int r = 0; r < GAUGE_BAR_ROWS; r++) {
+            int within = r % pitch;
+            uint16_t expected = UI_COLOR_BACKGROUND;
+            if (within < GAUGE_SEGMENT_HEIGHT) {
+                int seg = GAUGE_SEGMENT_COUNT - 1 - r / pitch;
+                int pixel = seg * GAUGE_SEGMENT_HEIGHT + (GAUGE_SEGMENT_HEIGHT - 1 - within);
+                expected = (pixel < fill) ? reference_segment_color(seg) : UI_COLOR_EMPTY;
+            }
+            for (int col = 1; col < GAUGE_WIDTH - 1; col++) {
+                TEST_ASSERT_EQUAL_HEX16(expected,
+                    display_host_get_pixel(TEST_GAUGE_X + col, TEST_GAUGE_Y + 1 + r));
+            }
+        }
+    }
+#endif
+}
+
+void test_row_lut_covers_every_row() {
+    const int rows = GAUGE_SEGMENT_COUNT * GAUGE_SEGMENT_HEIGHT;
+    // Bottom is red, top is green in both modes
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, gauge_get_row_color(0));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_GREEN, gauge_get_row_color(rows - 1));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_EMPTY, gauge_get_row_color(rows));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_EMPTY, gauge_get_row_color(-1));
+}
+
+// ============================================================================
+// Test: Glyph Cache Readouts
+// ============================================================================
+
+// Draw a readout the font-engine way: clear the field, print at size 2
+static void draw_text_font(int16_t text_x, const char* text) {
+    display_fill_rect(TEST_GAUGE_X, 1, GAUGE_WIDTH, 16, UI_COLOR_BACKGROUND);
+    display_set_text_size(2);
+    display_set_text_color(UI_COLOR_TEXT);
+    display_set_cursor(text_x, 1);
+    display_print(text);
+}
+
+void test_glyph_readout_matches_font() {
+    static GlyphCache cache = {0, 0, 0, nullptr};
+    TEST_ASSERT_TRUE(glyph_cache_init(&cache, &glyph_font_glcd, 2, UI_COLOR_TEXT, UI_COLOR_BACKGROUND));
+    const char* strings[] = {"57G", " 3G", "100%", " 0%", "42%"};
+    for (unsigned i = 0; i < sizeof(strings) / sizeof(strings[0]); i++) {
+        int16_t text_x = TEST_GAUGE_X + (GAUGE_WIDTH - (int16_t)strlen(strings[i]) * 12) / 2;
+        display_init();
+        draw_text_font(text_x, strings[i]);
+        save_frame();
+        
+        display_init();
+        display_stats_reset();
+        GlyphText state = {0, 0, 0, "", 0, false};
+        TEST_ASSERT_TRUE(glyph_text_draw(&cache, &state, TEST_GAUGE_X, 1, GAUGE_WIDTH, text_x, strings[i]));
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, count_frame_diffs(), strings[i]);
+        TEST_ASSERT_EQUAL_UINT32(1, display_stats_get().transactions);
+    }
+    // Characters outside the cache are refused
+    GlyphText state = {0, 0, 0, "", 0, false};
+    TEST_ASSERT_FALSE(glyph_text_draw(&cache, &state, TEST_GAUGE_X, 1, GAUGE_WIDTH, TEST_GAUGE_X, "5.0"));
+}
+
+void test_glyph_readout_sends_changed_chars() {
+    static GlyphCache cache = {0, 0, 0, nullptr};
+    glyph_cache_init(&cache, &glyph_font_glcd, 2, UI_COLOR_TEXT, UI_COLOR_BACKGROUND);
+    int16_t text_x = TEST_GAUGE_X + (GAUGE_WIDTH - 36) / 2;
+    
+    // Reference: 58% drawn from scratch
+    display_init();
+    draw_text_font(text_x, "58%");
+    save_frame();
+    
+    display_init();
+    GlyphText state = {0, 0, 0, "", 0, false};
+    glyph_text_draw(&cache, &state, TEST_GAUGE_X, 1, GAUGE_WIDTH, text_x, "57%");
+    
+    display_stats_reset();
+    glyph_text_draw(&cache, &state, TEST_GAUGE_X, 1, GAUGE_WIDTH, text_x, "58%");
+    DisplayStats cached = display_stats_get();
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+    TEST_ASSERT_EQUAL_UINT32(1, cached.transactions);
+    TEST_ASSERT_EQUAL_UINT32(12 * 16, cached.pixels);      // One character cell
+    
+    // Unchanged text sends nothing
+    display_stats_reset();
+    glyph_text_draw(&cache, &state, TEST_GAUGE_X, 1, GAUGE_WIDTH, text_x, "58%");
+    TEST_ASSERT_EQUAL_UINT32(0, display_stats_get().transactions);
+    
+    // A screen clear forces a full field repaint
+    display_init();
+    display_stats_reset();
+    glyph_text_draw(&cache, &state, TEST_GAUGE_X, 1, GAUGE_WIDTH, text_x, "58%");
+    TEST_ASSERT_EQUAL_UINT32(GAUGE_WIDTH * 16, display_stats_get().pixels);
+    
+    display_init();
+    display_stats_reset();
+    draw_text_font(text_x, "58%");
+    DisplayStats font = display_stats_get();
+    char msg[112];
+    snprintf(msg, sizeof(msg), "readout 57%%->58%%: font %u tx / %u px, glyph cache %u tx / %u px",
+             (unsigned)font.transactions, (unsigned)font.pixels,
+             (unsigned)cached.transactions, (unsigned)cached.pixels);
+    TEST_MESSAGE(msg);
+}
+
+// ============================================================================
+// Test: Clip Regions
+// ============================================================================
+
+void test_clip_visible_subtracts_exclusions() {
+    ClipStack stack = {};
+    ClipRect pieces[CLIP_MAX_PIECES];
+    
+    // No exclusions: the rect itself
+    TEST_ASSERT_EQUAL_INT(1, clip_visible(&stack, 0, 0, 50, 50, pieces));
+    
+    // Hole in the middle: four pieces covering everything but the hole
+    clip_push(&stack, 10, 10, 20, 20);
+    int n = clip_visible(&stack, 0, 0, 50, 50, pieces);
+    TEST_ASSERT_EQUAL_INT(4, n);
+    int area = 0;
+    for (int i = 0; i < n; i++) {
+        area += pieces[i].w * pieces[i].h;
+        TEST_ASSERT_FALSE(clip_intersects(&stack, pieces[i].x, pieces[i].y, pieces[i].w, pieces[i].h));
+    }
+    TEST_ASSERT_EQUAL_INT(50 * 50 - 20 * 20, area);
+    
+    // Clear of the hole: untouched; inside it: nothing
+    TEST_ASSERT_EQUAL_INT(1, clip_visible(&stack, 40, 0, 10, 50, pieces));
+    TEST_ASSERT_EQUAL_INT(40, pieces[0].x);
+    TEST_ASSERT_EQUAL_INT(50, pieces[0].h);
+    TEST_ASSERT_EQUAL_INT(0, clip_visible(&stack, 12, 12, 5, 5, pieces));
+    
+    clip_pop(&stack);
+    TEST_ASSERT_FALSE(clip_intersects(&stack, 10, 10, 20, 20));
+}
+
+// Debug overlay band, as excluded by the main loop
+#define TEST_OVERLAY_Y        97
+#define TEST_OVERLAY_H        126
+
+// Draw a gauge with the overlay band excluded; the band holds a marker colour
+static DisplayStats draw_gauge_excluded(void (*draw)(float), float percent) {
+    display_init();
+    display_fill_rect(0, TEST_OVERLAY_Y, LCD_WIDTH, TEST_OVERLAY_H, UI_COLOR_RED);
+    TEST_ASSERT_TRUE(display_clip_exclude_push(0, TEST_OVERLAY_Y, LCD_WIDTH, TEST_OVERLAY_H));
+    display_stats_reset();
+    draw(percent);
+    DisplayStats stats = display_stats_get();
+    display_clip_exclude_pop();
+    return stats;
+}
+
+static void draw_gauge_composed(float percent) {
+    gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, percent, 1);
+}
+
+// Pixels outside the band match the saved frame; inside, the marker survived
+static int count_overlay_violations() {
+    const uint16_t* fb = display_host_framebuffer();
+    int bad = 0;
+    for (int i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++) {
+        int y = i / LCD_WIDTH;
+        bool in_band = y >= TEST_OVERLAY_Y && y < TEST_OVERLAY_Y + TEST_OVERLAY_H;
+        uint16_t expected = in_band ? UI_COLOR_RED : saved_frame[i];
+        if (fb[i] != expected) bad++;
+    }
+    return bad;
+}
+
+void test_clip_gauge_leaves_overlay_untouched() {
+    void (*const draws[])(float) = {draw_gauge_direct, draw_gauge_composed};
+    const char* names[] = {"direct", "composed"};
+    for (int d = 0; d < 2; d++) {
+        display_init();
+        display_stats_reset();
+        draws[d](57.0f);
+        DisplayStats normal = display_stats_get();
+        save_frame();
+        
+        DisplayStats clipped = draw_gauge_excluded(draws[d], 57.0f);
+        TEST_ASSERT_EQUAL_INT(0, count_overlay_violations());
+        
+        // Debug mode costs about the same as normal mode
+        char msg[96];
+        snprintf(msg, sizeof(msg), "%s gauge: normal %u transactions, overlay excluded %u",
+                 names[d], (unsigned)normal.transactions, (unsigned)clipped.transactions);
+        TEST_MESSAGE(msg);
+        TEST_ASSERT_TRUE(clipped.transactions <= normal.transactions + 8);
+    }
+}
+
+void test_clip_canvas_split_one_window_per_piece() {
+    // A narrow column excluded through the canvas leaves two strided pieces
+    display_init();
+    display_clip_exclude_push(40, 0, 4, LCD_HEIGHT);
+    TEST_ASSERT_TRUE(display_canvas_begin(10, 10, 80, 60));
+    display_fill_rect(10, 10, 80, 60, UI_COLOR_GREEN);
+    display_stats_reset();
+    display_canvas_end();
+    display_clip_exclude_pop();
+    
+    DisplayStats s = display_stats_get();
+    TEST_ASSERT_EQUAL_UINT32(2, s.transactions);
+    TEST_ASSERT_EQUAL_UINT32(76 * 60, s.pixels);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_GREEN, display_host_get_pixel(89, 69));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BACKGROUND, display_host_get_pixel(41, 20));
+}
+
+void test_clip_clear_ignores_exclusions() {
+    display_init();
+    display_fill_rect(0, TEST_OVERLAY_Y, LCD_WIDTH, TEST_OVERLAY_H, UI_COLOR_RED);
+    display_clip_exclude_push(0, TEST_OVERLAY_Y, LCD_WIDTH, TEST_OVERLAY_H);
+    display_clear(UI_COLOR_BACKGROUND);
+    display_fill_rect(0, TEST_OVERLAY_Y + 1, 4, 4, UI_COLOR_RED);
+    display_clip_exclude_pop();
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BACKGROUND, display_host_get_pixel(0, TEST_OVERLAY_Y + 1));
+}
+
+// ============================================================================
+// Test: Level Animation
+// ============================================================================
+
+void test_anim_ease_endpoints_and_monotonic() {
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, gauge_anim_ease(0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, gauge_anim_ease(1.0f));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, gauge_anim_ease(2.0f));
+    float prev = 0.0f;
+    for (int i = 1; i <= 100; i++) {
+        float k = gauge_anim_ease(i / 100.0f);
+        TEST_ASSERT_TRUE(k >= prev);
+        prev = k;
+    }
+}
+
+void test_anim_frame_rate_independent() {
+    GaugeAnim fast;
+    GaugeAnim slow;
+    gauge_anim_init(&fast, 20.0f);
+    gauge_anim_init(&slow, 20.0f);
+    gauge_anim_set_target(&fast, 80.0f, 1000);
+    gauge_anim_set_target(&slow, 80.0f, 1000);
+    
+    // 60 fps and ~30 fps land on the same level at the same moment
+    for (uint32_t t = 1000; t < 1200; t += 16) gauge_anim_step(&fast, t);
+    for (uint32_t t = 1000; t < 1200; t += 33) gauge_anim_step(&slow, t);
+    TEST_ASSERT_EQUAL_FLOAT(gauge_anim_step(&fast, 1200), gauge_anim_step(&slow, 1200));
+    TEST_ASSERT_TRUE(fast.shown > 20.0f && fast.shown < 80.0f);
+    
+    // Done after the duration, then idle
+    TEST_ASSERT_EQUAL_FLOAT(80.0f, gauge_anim_step(&fast, 1000 + GAUGE_ANIM_DURATION_MS));
+    TEST_ASSERT_FALSE(gauge_anim_active(&fast));
+}
+
+void test_anim_retarget_continues_from_shown() {
+    GaugeAnim anim;
+    gauge_anim_init(&anim, 20.0f);
+    gauge_anim_set_target(&anim, 80.0f, 0);
+    float shown = gauge_anim_step(&anim, 100);
+    
+    // Reversing mid-flight starts from the level on screen
+    gauge_anim_set_target(&anim, 10.0f, 100);
+    TEST_ASSERT_EQUAL_FLOAT(shown, gauge_anim_step(&anim, 100));
+    TEST_ASSERT_TRUE(gauge_anim_step(&anim, 150) < shown);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, gauge_anim_step(&anim, 100 + GAUGE_ANIM_DURATION_MS));
+}
+
+void test_anim_subpixel_target_stays_idle() {
+    GaugeAnim anim;
+    gauge_anim_init(&anim, 50.0f);
+    float nudged = 50.1f;
+    TEST_ASSERT_EQUAL_INT(gauge_get_fill_pixels(50.0f), gauge_get_fill_pixels(nudged));
+    gauge_anim_set_target(&anim, nudged, 0);
+    TEST_ASSERT_FALSE(gauge_anim_active(&anim));
+    TEST_ASSERT_EQUAL_FLOAT(nudged, gauge_anim_step(&anim, 5));
+}
+
+void test_anim_frames_end_on_full_redraw() {
+    display_init();
+    gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, 80.0f, 1);
+    save_frame();
+    
+    // Tween 20% -> 80% through the delta-update path at 60 fps
+    display_init();
+    gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, 20.0f, 1);
+    GaugeAnim anim;
+    gauge_anim_init(&anim, 20.0f);
+    gauge_anim_set_target(&anim, 80.0f, 0);
+    float on_screen = 20.0f;
+    int frames = 0;
+    uint32_t max_pixels = 0;
+    for (uint32_t t = GAUGE_ANIM_FRAME_MS; gauge_anim_active(&anim); t += GAUGE_ANIM_FRAME_MS) {
+        float shown = gauge_anim_step(&anim, t);
+        display_stats_reset();
+        if (gauge_update_if_changed(TEST_GAUGE_X, TEST_GAUGE_Y, on_screen, shown, 1)) {
+            on_screen = shown;
+        }
+        if (display_stats_get().pixels > max_pixels) max_pixels = display_stats_get().pixels;
+        frames++;
+    }
+    
+    char msg[96];
+    snprintf(msg, sizeof(msg), "20%%->80%% tween: %d frames, at most %u pixels per frame",
+             frames, (unsigned)max_pixels);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL_INT((GAUGE_ANIM_DURATION_MS + GAUGE_ANIM_FRAME_MS - 1) / GAUGE_ANIM_FRAME_MS, frames);
+    // Each frame repaints a band of rows, never the whole bar
+    TEST_ASSERT_TRUE(max_pixels < (uint32_t)(GAUGE_WIDTH * GAUGE_BAR_ROWS) / 2);
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+}
+
+// ============================================================================
+// Test: Fuel History
+// ============================================================================
+
+void test_history_cascades_averages() {
+    static FuelHistory h;
+    fuel_history_init(&h);
+    
+    // One zoom 1 sample per HISTORY_ZOOM_FACTOR zoom 0 samples, averaged
+    for (int i = 0; i < HISTORY_ZOOM_FACTOR * HISTORY_ZOOM_FACTOR; i++) {
+        fuel_history_add(&h, (float)(i % HISTORY_ZOOM_FACTOR) * 10.0f, 50.0f);
+    }
+    TEST_ASSERT_EQUAL_INT(HISTORY_ZOOM_FACTOR * HISTORY_ZOOM_FACTOR, fuel_history_count(&h, 0));
+    TEST_ASSERT_EQUAL_INT(HISTORY_ZOOM_FACTOR, fuel_history_count(&h, 1));
+    TEST_ASSERT_EQUAL_INT(1, fuel_history_count(&h, 2));
+    float expected = (HISTORY_ZOOM_FACTOR - 1) * 10.0f / 2.0f;
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, expected, fuel_history_get(&h, 1, 1, 0));
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 50.0f, fuel_history_get(&h, 2, 2, 0));
+    
+    // Newest first
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, (HISTORY_ZOOM_FACTOR - 1) * 10.0f, fuel_history_get(&h, 0, 1, 0));
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, (HISTORY_ZOOM_FACTOR - 2) * 10.0f, fuel_history_get(&h, 0, 1, 1));
+    
+    // The ring keeps the newest HISTORY_SAMPLES
+    for (int i = 0; i < HISTORY_SAMPLES + 5; i++) {
+        fuel_history_add(&h, (float)(i % 100), 0.0f);
+    }
+    TEST_ASSERT_EQUAL_INT(HISTORY_SAMPLES, fuel_history_count(&h, 0));
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, (float)((HISTORY_SAMPLES + 4) % 100), fuel_history_get(&h, 0, 1, 0));
+}
+
+void test_history_samples_on_interval() {
+    static FuelHistory h;
+    fuel_history_init(&h);
+    TEST_ASSERT_TRUE(fuel_history_update(&h, 50.0f, 50.0f, 1000));
+    TEST_ASSERT_FALSE(fuel_history_update(&h, 50.0f, 50.0f, 1000 + HISTORY_SAMPLE_MS - 1));
+    TEST_ASSERT_TRUE(fuel_history_update(&h, 50.0f, 50.0f, 1000 + HISTORY_SAMPLE_MS));
+    TEST_ASSERT_EQUAL_UINT32(2, fuel_history_total(&h, 0));
+}
+
+// Screen as the viewer sees it (hardware scroll applied)
+static uint16_t screen_a[LCD_WIDTH * LCD_HEIGHT];
+
+static void capture_screen(uint16_t* out) {
+    for (int16_t y = 0; y < LCD_HEIGHT; y++) {
+        for (int16_t x = 0; x < LCD_WIDTH; x++) {
+            out[y * LCD_WIDTH + x] = display_host_get_screen_pixel(x, y);
+        }
+    }
+}
+
+static int count_screen_diffs(const uint16_t* expected) {
+    int diffs = 0;
+    for (int16_t y = 0; y < LCD_HEIGHT; y++) {
+        for (int16_t x = 0; x < LCD_WIDTH; x++) {
+            if (display_host_get_screen_pixel(x, y) != expected[y * LCD_WIDTH + x]) diffs++;
+        }
+    }
+    return diffs;
+}
+
+void test_history_page_scrolls_one_row_per_sample() {
+    static FuelHistory h;
+    fuel_history_init(&h);
+    for (int i = 0; i < 100; i++) {
+        fuel_history_add(&h, 80.0f - i * 0.5f, 30.0f + i * 0.3f);
+    }
+    display_init();
+    history_page_invalidate();
+    history_page_draw(&h, 0);
+    
+    // Each new sample: one scroll command and one chart row, wherever the
+    // scroll position is (run past a full wrap of the chart)
+    uint32_t max_tx = 0;
+    uint32_t max_px = 0;
+    for (int i = 0; i < LCD_HEIGHT + 20; i++) {
+        fuel_history_add(&h, (float)(i % 100), (float)(99 - i % 100));
+        display_stats_reset();
+        history_page_draw(&h, 0);
+        DisplayStats s = display_stats_get();
+        if (s.transactions > max_tx) max_tx = s.transactions;
+        if (s.pixels > max_px) max_px = s.pixels;
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, max_tx);
+    TEST_ASSERT_EQUAL_UINT32(LCD_WIDTH, max_px);
+    capture_screen(screen_a);
+    
+    // Same picture as drawing the chart from scratch
+    display_init();
+    history_page_invalidate();
+    display_stats_reset();
+    history_page_draw(&h, 0);
+    DisplayStats full = display_stats_get();
+    TEST_ASSERT_EQUAL_INT(0, count_screen_diffs(screen_a));
+    
+    char msg[96];
+    snprintf(msg, sizeof(msg), "history page: full draw %u px, new sample %u px",
+             (unsigned)full.pixels, (unsigned)max_px);
+    TEST_MESSAGE(msg);
+}
+
+// ============================================================================
+// Test: Dial Gauge
+// ============================================================================
+
+#define TEST_DIAL_CX          dial_center_x(1)
+#define TEST_DIAL_CY          dial_center_y(1)
+
+void test_dial_band_pixels() {
+    TEST_ASSERT_TRUE(dial_init());
+    int16_t top_y = TEST_DIAL_CY - DIAL_RADIUS + 2;             // 12 o'clock, middle of the sweep
+    int16_t left_x = TEST_DIAL_CX - DIAL_RADIUS + 2;            // 9 o'clock, 1/6 of the sweep
+    int16_t gap_y = TEST_DIAL_CY + DIAL_RADIUS - 2;             // 6 o'clock, in the gap
+    
+    display_init();
+    dial_draw(TEST_DIAL_CX, TEST_DIAL_CY, 49.0f, 1);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_EMPTY, display_host_get_pixel(TEST_DIAL_CX, top_y));
+    TEST_ASSERT_EQUAL_HEX16(gauge_get_color_for_percent(10.0f), display_host_get_pixel(left_x, TEST_DIAL_CY));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BACKGROUND, display_host_get_pixel(TEST_DIAL_CX, gap_y));
+    
+    display_init();
+    dial_draw(TEST_DIAL_CX, TEST_DIAL_CY, 100.0f, 1);
+    TEST_ASSERT_EQUAL_HEX16(gauge_get_color_for_percent(50.0f), display_host_get_pixel(TEST_DIAL_CX, top_y));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BACKGROUND, display_host_get_pixel(TEST_DIAL_CX, gap_y));
+    // Outside the outer radius and inside the inner one stay background
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BACKGROUND,
+                            display_host_get_pixel(TEST_DIAL_CX - DIAL_RADIUS + 4, TEST_DIAL_CY - DIAL_RADIUS + 4));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BACKGROUND,
+                            display_host_get_pixel(TEST_DIAL_CX - DIAL_RADIUS + DIAL_THICKNESS + 2, TEST_DIAL_CY));
+}
+
+void test_dial_delta_spans_match_full_draw() {
+    const float levels[][2] = {
+        {50.0f, 50.5f},    // One step up
+        {50.0f, 49.5f},    // One step down
+        {12.0f, 63.0f},    // Across zones
+        {95.0f, 3.0f},     // Large drop
+        {0.0f, 100.0f},    // Empty to full
+        {100.0f, 0.0f},    // Full to empty
+    };
+    for (unsigned i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+        display_init();
+        dial_draw(TEST_DIAL_CX, TEST_DIAL_CY, levels[i][1], 1);
+        save_frame();
+        
+        display_init();
+        dial_draw(TEST_DIAL_CX, TEST_DIAL_CY, levels[i][0], 1);
+        dial_update_if_changed(TEST_DIAL_CX, TEST_DIAL_CY, levels[i][0], levels[i][1], 1);
+        TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+    }
+}
+
+void test_dial_one_step_cost() {
+    display_init();
+    display_stats_reset();
+    dial_draw(TEST_DIAL_CX, TEST_DIAL_CY, 50.0f, 1);
+    DisplayStats full = display_stats_get();
+    
+    // One fill step: a thin wedge across the band
+    display_stats_reset();
+    dial_update_spans(TEST_DIAL_CX, TEST_DIAL_CY, 100, 101);
+    DisplayStats step = display_stats_get();
+    
+    char msg[112];
+    snprintf(msg, sizeof(msg), "dial: full draw %u px / %u tx, one step %u px / %u tx",
+             (unsigned)full.pixels, (unsigned)full.transactions,
+             (unsigned)step.pixels, (unsigned)step.transactions);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(step.pixels > 0);
+    TEST_ASSERT_TRUE(step.pixels <= 4 * DIAL_THICKNESS);
+}
+
+// ============================================================================
+// Test: Compile-time Gauge Layout
+// ============================================================================
+
+typedef Gauge<GAUGE_VERTICAL, GAUGE_SEGMENT_COUNT, GAUGE_SEGMENT_HEIGHT,
+              GAUGE_SEGMENT_GAP, GAUGE_WIDTH> TestTankGauge;
+typedef Gauge<GAUGE_VERTICAL, 8, 6, 2, 24> TestAuxGauge;
+typedef Gauge<GAUGE_HORIZONTAL, 10, 12, 2, 30> TestWideGauge;
+
+#define TEST_AUX_X            100
+#define TEST_AUX_Y            40
+#define TEST_WIDE_X           10
+#define TEST_WIDE_Y           100
+
+// Screen column of a horizontal fill pixel
+static int16_t wide_fill_x(int pixel) {
+    return TEST_WIDE_X + TestWideGauge::segment_offset(pixel / 12) + pixel % 12;
+}
+
+void test_gauge_template_layout() {
+    // Layout constants are compile-time values
+    static uint16_t aux_lines[TestAuxGauge::BAR_LENGTH];
+    TEST_ASSERT_EQUAL_INT(62, (int)(sizeof(aux_lines) / sizeof(aux_lines[0])));
+    TEST_ASSERT_EQUAL_INT(48, TestAuxGauge::FILL_PIXELS);
+    TEST_ASSERT_EQUAL_INT(GAUGE_BAR_ROWS, TestTankGauge::BAR_LENGTH);
+    TEST_ASSERT_EQUAL_INT(TEST_BAR_HEIGHT, TestTankGauge::HEIGHT_PX);
+    TEST_ASSERT_EQUAL_INT(140, TestWideGauge::WIDTH_PX);
+    TEST_ASSERT_EQUAL_INT(30, TestWideGauge::HEIGHT_PX);
+    
+    // The tank bars are this template: same row vector as the C API
+    const float levels[] = {0.0f, 12.5f, 50.0f, 99.0f, 100.0f};
+    static uint16_t expected[GAUGE_BAR_ROWS];
+    static uint16_t actual[GAUGE_BAR_ROWS];
+    for (unsigned i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+        gauge_build_row_colors(levels[i], expected);
+        TestTankGauge::build_lines(levels[i], actual);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(expected, actual, GAUGE_BAR_ROWS);
+    }
+}
+
+void test_gauge_template_horizontal_fill() {
+    const int fill = TestWideGauge::fill_pixels(35.0f);
+    TEST_ASSERT_EQUAL_INT(42, fill);
+    
+    display_init();
+    TestWideGauge::draw(TEST_WIDE_X, TEST_WIDE_Y, 35.0f);
+    int16_t mid_y = TEST_WIDE_Y + 15;
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, display_host_get_pixel(wide_fill_x(0), mid_y));
+    TEST_ASSERT_EQUAL_HEX16(TestWideGauge::fill_color(fill - 1), display_host_get_pixel(wide_fill_x(fill - 1), mid_y));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_EMPTY, display_host_get_pixel(wide_fill_x(fill), mid_y));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_EMPTY, display_host_get_pixel(wide_fill_x(119), mid_y));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BACKGROUND, display_host_get_pixel(wide_fill_x(11) + 1, mid_y));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BORDER, display_host_get_pixel(TEST_WIDE_X - 1, mid_y));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BORDER, display_host_get_pixel(TEST_WIDE_X + 140, mid_y));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BORDER, display_host_get_pixel(wide_fill_x(5), TEST_WIDE_Y + 30));
+    
+    // Streaming and incremental updates land on the same pixels
+    save_frame();
+    display_init();
+    TestWideGauge::stream(TEST_WIDE_X, TEST_WIDE_Y, 35.0f);
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+    
+    display_init();
+    TestWideGauge::draw(TEST_WIDE_X, TEST_WIDE_Y, 80.0f);
+    save_frame();
+    display_init();
+    TestWideGauge::draw(TEST_WIDE_X, TEST_WIDE_Y, 35.0f);
+    TestWideGauge::update(TEST_WIDE_X, TEST_WIDE_Y, fill, TestWideGauge::fill_pixels(80.0f));
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+}
+
+void test_gauge_template_sizes_coexist() {
+    // Reference: both gauges drawn outright at their final levels
+    display_init();
+    gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, 64.0f, 1);
+    TestAuxGauge::draw(TEST_AUX_X, TEST_AUX_Y, 70.0f);
+    save_frame();
+    
+    // Aux bar moved incrementally next to the main bar
+    display_init();
+    gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, 64.0f, 1);
+    TestAuxGauge::draw(TEST_AUX_X, TEST_AUX_Y, 20.0f);
+    TestAuxGauge::update(TEST_AUX_X, TEST_AUX_Y, TestAuxGauge::fill_pixels(20.0f),
+                         TestAuxGauge::fill_pixels(70.0f));
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+    
+    // Each size keeps its own zone table
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, TestAuxGauge::fill_color(0));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_GREEN, TestAuxGauge::fill_color(TestAuxGauge::FILL_PIXELS - 1));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_EMPTY, TestAuxGauge::fill_color(TestAuxGauge::FILL_PIXELS));
+}
+
+// ============================================================================
+// Test: Low Fuel Alert
+// ============================================================================
+
+// Panel bytes for some traffic: RGB565 data plus CASET/RASET/RAMWR per window
+#define TEST_WINDOW_SETUP_BYTES 11
+
+static uint32_t spi_bytes(DisplayStats s) {
+    return s.pixels * 2 + s.transactions * TEST_WINDOW_SETUP_BYTES;
+}
+
+// Screen row of a tank bar fill pixel
+static int16_t tank_fill_y(int pixel) {
+    return TEST_GAUGE_Y + TestTankGauge::segment_offset(pixel / GAUGE_SEGMENT_HEIGHT) +
+           (GAUGE_SEGMENT_HEIGHT - 1 - pixel % GAUGE_SEGMENT_HEIGHT);
+}
+
+void test_alert_effect_colors() {
+    // Blink and invert alternate every LOW_FUEL_BLINK_MS
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, gauge_alert_effect_color(LOW_FUEL_EFFECT_BLINK, 0));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_EMPTY, gauge_alert_effect_color(LOW_FUEL_EFFECT_BLINK, LOW_FUEL_BLINK_MS));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, gauge_alert_effect_color(LOW_FUEL_EFFECT_BLINK, 2 * LOW_FUEL_BLINK_MS + 1));
+    TEST_ASSERT_EQUAL_HEX16((uint16_t)~UI_COLOR_RED,
+                            gauge_alert_effect_color(LOW_FUEL_EFFECT_INVERT, LOW_FUEL_BLINK_MS));
+    
+    // Pulse reaches empty halfway and changes only at step edges
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, gauge_alert_effect_color(LOW_FUEL_EFFECT_PULSE, 0));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_EMPTY, gauge_alert_effect_color(LOW_FUEL_EFFECT_PULSE, LOW_FUEL_PULSE_MS / 2));
+    int changes = 0;
+    uint16_t last = gauge_alert_effect_color(LOW_FUEL_EFFECT_PULSE, 0);
+    for (uint32_t t = 1; t <= LOW_FUEL_PULSE_MS; t++) {
+        uint16_t c = gauge_alert_effect_color(LOW_FUEL_EFFECT_PULSE, t);
+        if (c != last) changes++;
+        last = c;
+    }
+    TEST_ASSERT_EQUAL_INT(2 * LOW_FUEL_PULSE_STEPS, changes);
+}
+
+void test_alert_hysteresis() {
+    GaugeAlert alert;
+    gauge_alert_init(&alert);
+    TEST_ASSERT_FALSE(gauge_alert_update(&alert, 30.0f, 0));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, gauge_alert_color(&alert, 0));
+    
+    TEST_ASSERT_TRUE(gauge_alert_update(&alert, LOW_FUEL_ALERT_PERCENT - 0.5f, 1000));
+    // Phase starts when the alert does
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, gauge_alert_color(&alert, 1000));
+    // Hovering between the two levels keeps it on
+    TEST_ASSERT_TRUE(gauge_alert_update(&alert, LOW_FUEL_ALERT_PERCENT + 1.0f, 2000));
+    TEST_ASSERT_FALSE(gauge_alert_update(&alert, LOW_FUEL_ALERT_CLEAR + 0.5f, 3000));
+}
+
+void test_alert_toggle_bounded_bytes() {
+    const int lit = gauge_get_fill_pixels(12.0f);
+    display_init();
+    gauge_invalidate(1);
+    gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, 12.0f, 1);
+    save_frame();
+    
+    // Full bar repaint, for scale
+    display_stats_reset();
+    gauge_redraw_bar(TEST_GAUGE_X, TEST_GAUGE_Y, 12.0f);
+    uint32_t full_bytes = spi_bytes(display_stats_get());
+    
+    // Toggle off: exactly the lit red rows change
+    display_stats_reset();
+    TEST_ASSERT_TRUE(gauge_set_alert_color(TEST_GAUGE_X, TEST_GAUGE_Y, 1, UI_COLOR_EMPTY));
+    DisplayStats off = display_stats_get();
+    TEST_ASSERT_EQUAL_INT(lit * (GAUGE_WIDTH - 2), count_frame_diffs());
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_EMPTY, display_host_get_pixel(TEST_GAUGE_X + 5, tank_fill_y(0)));
+    
+    // Bounded by the red zone whatever the level: its pixels plus one window per segment
+    const int red_rows = (int)(FUEL_THRESHOLD_RED / 100.0f * GAUGE_SEGMENT_COUNT) * GAUGE_SEGMENT_HEIGHT;
+    const uint32_t bound = (uint32_t)red_rows * (GAUGE_WIDTH - 2) * 2 +
+        (uint32_t)(red_rows / GAUGE_SEGMENT_HEIGHT + 1) * TEST_WINDOW_SETUP_BYTES;
+    TEST_ASSERT_TRUE(spi_bytes(off) <= bound);
+    
+    // Toggle on restores the bar exactly; a repeat costs nothing
+    display_stats_reset();
+    TEST_ASSERT_TRUE(gauge_set_alert_color(TEST_GAUGE_X, TEST_GAUGE_Y, 1, UI_COLOR_RED));
+    DisplayStats on = display_stats_get();
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+    TEST_ASSERT_FALSE(gauge_set_alert_color(TEST_GAUGE_X, TEST_GAUGE_Y, 1, UI_COLOR_RED));
+    
+    char msg[96];
+    snprintf(msg, sizeof(msg), "alert toggle at 12%%: %u bytes off, %u on (bound %u, full bar %u)",
+             (unsigned)spi_bytes(off), (unsigned)spi_bytes(on), (unsigned)bound, (unsigned)full_bytes);
+    TEST_MESSAGE(msg);
+}
+
+void test_alert_slot_survives_updates() {
+    // Reference: bar drawn outright at 16% with the red zone blinked off
+    display_init();
+    gauge_invalidate(1);
+    gauge_set_alert_color(TEST_GAUGE_X, TEST_GAUGE_Y, 1, UI_COLOR_EMPTY);
+    gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, 16.0f, 1);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_EMPTY, display_host_get_pixel(TEST_GAUGE_X + 5, tank_fill_y(0)));
+    save_frame();
+    
+    // Same level reached by a delta update during the off phase
+    display_init();
+    gauge_invalidate(1);
+    gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, 9.0f, 1);
+    gauge_update_if_changed(TEST_GAUGE_X, TEST_GAUGE_Y, 9.0f, 16.0f, 1);
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+    
+    gauge_set_alert_color(TEST_GAUGE_X, TEST_GAUGE_Y, 1, UI_COLOR_RED);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, display_host_get_pixel(TEST_GAUGE_X + 5, tank_fill_y(0)));
+}
+
+// ============================================================================
+// Test: Page Compositor
+// ============================================================================
+
+// Background of the tank gauge page as main.cpp lays it out
+#define TEST_GAUGE2_X         (LCD_WIDTH - TEST_GAUGE_X - GAUGE_WIDTH)
+
+static void test_gauges_background() {
+    gauge_draw_background(TEST_GAUGE_X, TEST_GAUGE_Y);
+    gauge_draw_background(TEST_GAUGE2_X, TEST_GAUGE_Y);
+}
+
+// A background no run-length budget can hold: every pixel differs from the next
+static void test_noise_background() {
+    const int16_t rows = PAGE_CACHE_BYTES / (int)sizeof(DisplayRun) / LCD_WIDTH + 1;
+    for (int16_t y = 0; y < rows; y++) {
+        for (int16_t x = 0; x < LCD_WIDTH; x++) {
+            display_fill_rect(x, y, 1, 1, (uint16_t)(x * 31 + y * 7 + ((x + y) & 1)));
+        }
+    }
+}
+
+void test_page_show_restores_in_one_push() {
+    // Reference: clear and draw the trip page furniture directly
+    display_init();
+    display_clear(UI_COLOR_BACKGROUND);
+    trip_page_draw_background();
+    save_frame();
+    
+    page_cache_reset();
+    page_define(0, trip_page_draw_background);
+    display_init();
+    page_show(0);
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+#if PAGE_CACHE_ENABLE
+    TEST_ASSERT_TRUE(page_cached(0));
+    
+    // Second show: one window over the whole screen, and readouts see a clear
+    display_init();
+    uint32_t clears = display_get_clear_count();
+    display_stats_reset();
+    page_show(0);
+    DisplayStats s = display_stats_get();
+    TEST_ASSERT_EQUAL_UINT32(1, s.transactions);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)LCD_WIDTH * LCD_HEIGHT, s.pixels);
+    TEST_ASSERT_EQUAL_UINT32(clears + 1, display_get_clear_count());
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+#endif
+}
+
+void test_page_over_budget_draws_directly() {
+    page_cache_reset();
+    page_define(1, test_noise_background);
+    display_init();
+    display_clear(UI_COLOR_BACKGROUND);
+    test_noise_background();
+    save_frame();
+    
+    display_init();
+    page_show(1);
+    TEST_ASSERT_FALSE(page_cached(1));
+    TEST_ASSERT_EQUAL_UINT32(0, page_cache_used());
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+}
+
+void test_page_switch_gauges_background_plus_dynamic() {
+    // Reference: the old full redraw of both gauges
+    display_init();
+    display_clear(UI_COLOR_BACKGROUND);
+    gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, 64.0f, 1);
+    gauge_draw(TEST_GAUGE2_X, TEST_GAUGE_Y, 27.0f, 2);
+    save_frame();
+    
+    page_cache_reset();
+    page_define(0, test_gauges_background);
+    page_define(1, trip_page_draw_background);
+    page_define(2, history_page_draw_background);
+    page_show(1);
+    page_show(2);
+    display_init();
+    page_show(0);
+    
+    // Switching back: one bulk push, then only lit rows and readouts
+    display_init();
+    display_stats_reset();
+    page_show(0);
+    DisplayStats bulk = display_stats_get();
+    gauge_draw_over_background(TEST_GAUGE_X, TEST_GAUGE_Y, 64.0f, 1);
+    gauge_draw_over_background(TEST_GAUGE2_X, TEST_GAUGE_Y, 27.0f, 2);
+    DisplayStats total = display_stats_get();
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+    
+    // Incremental updates carry on from there
+    TEST_ASSERT_TRUE(gauge_update_if_changed(TEST_GAUGE_X, TEST_GAUGE_Y, 64.0f, 63.0f, 1));
+    
+#if PAGE_CACHE_ENABLE
+    TEST_ASSERT_EQUAL_UINT32(1, bulk.transactions);
+
+    // All three production backgrounds fit the pool together
+    TEST_ASSERT_TRUE(page_cached(0) && page_cached(1) && page_cached(2));
+    TEST_ASSERT_TRUE(page_cache_used() <= PAGE_CACHE_BYTES);
+    
+    char msg[112];
+    snprintf(msg, sizeof(msg), "page switch: %u tx / %u px (bulk 1 tx), cache %u bytes for 3 pages",
+             (unsigned)total.transactions, (unsigned)total.pixels, (unsigned)page_cache_used());
+    TEST_MESSAGE(msg);
+#else
+    (void)bulk;
+    (void)total;
+#endif
+    page_cache_reset();
+}
+
+// ============================================================================
+// Test: Flash Assets
+// ============================================================================
+
+// Encode an image, draw it at (x, y) and compare every pixel
+static void check_asset_round_trip(const uint16_t* pixels, uint16_t w, uint16_t h,
+                                   uint8_t format, int16_t x, int16_t y) {
+    static uint8_t stream[8192];
+    uint16_t palette[ASSET_PALETTE_MAX];
+    uint8_t palette_count = 0;
+    uint32_t size = asset_encode(pixels, w, h, format, palette, &palette_count,
+                                 stream, sizeof(stream));
+    TEST_ASSERT_TRUE(size > 0);
+    Asset asset = {w, h, format, palette_count,
+                   format == ASSET_FORMAT_PALETTE ? palette : nullptr, stream, size};
+    TEST_ASSERT_TRUE(asset_valid(&asset));
+
+    display_clear(UI_COLOR_BACKGROUND);
+    display_stats_reset();
+    TEST_ASSERT_TRUE(asset_draw(&asset, x, y));
+    DisplayStats s = display_stats_get();
+    TEST_ASSERT_EQUAL_UINT32(1, s.transactions);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)w * h, s.pixels);
+    for (int16_t py = 0; py < h; py++) {
+        for (int16_t px = 0; px < w; px++) {
+            TEST_ASSERT_EQUAL_HEX16(pixels[py * w + px], display_host_get_pixel(x + px, y + py));
+        }
+    }
+}
+
+void test_asset_round_trip_both_formats() {
+    static uint16_t img[LCD_WIDTH * 24];
+
+    // Icon: few colors, short runs and single pixels
+    for (int i = 0; i < 24 * 20; i++) {
+        int px = i % 24, py = i / 24;
+        img[i] = ((px + py) % 7 == 0) ? UI_COLOR_RED : (px < py ? UI_COLOR_BORDER : UI_COLOR_BACKGROUND);
+    }
+    check_asset_round_trip(img, 24, 20, ASSET_FORMAT_PALETTE, 10, 30);
+    check_asset_round_trip(img, 24, 20, ASSET_FORMAT_RLE565, 10, 30);
+
+    // Runs longer than one token in both formats, wrapping across rows
+    for (int i = 0; i < LCD_WIDTH * 24; i++) {
+        img[i] = (i < LCD_WIDTH * 10 + 3) ? UI_COLOR_GREEN : UI_COLOR_YELLOW;
+    }
+    check_asset_round_trip(img, LCD_WIDTH, 24, ASSET_FORMAT_PALETTE, 0, 100);
+    check_asset_round_trip(img, LCD_WIDTH, 24, ASSET_FORMAT_RLE565, 0, 100);
+
+    // Noise: no repeats, too many colors for a palette
+    uint32_t seed = 12345;
+    for (int i = 0; i < 40 * 30; i++) {
+        seed = seed * 1103515245u + 12345u;
+        img[i] = (uint16_t)(seed >> 16);
+    }
+    uint8_t scratch[64];
+    uint16_t palette[ASSET_PALETTE_MAX];
+    uint8_t count = 0;
+    TEST_ASSERT_EQUAL_UINT32(0, asset_encode(img, 40, 30, ASSET_FORMAT_PALETTE, palette, &count,
+                                             scratch, sizeof(scratch)));
+    check_asset_round_trip(img, 40, 30, ASSET_FORMAT_RLE565, 65, 200);
+}
+
+void test_asset_flash_images_match_encoder() {
+    const Asset* assets[] = {&asset_fuel_pump, &asset_splash};
+    static uint16_t pixels[LCD_WIDTH * LCD_HEIGHT];
+    static uint8_t stream[8192];
+
+    for (int a = 0; a < 2; a++) {
+        const Asset* asset = assets[a];
+        TEST_ASSERT_TRUE(asset_valid(asset));
+
+        display_clear(UI_COLOR_BACKGROUND);
+        display_stats_reset();
+        TEST_ASSERT_TRUE(asset_draw(asset, 0, 0));
+        DisplayStats s = display_stats_get();
+        TEST_ASSERT_EQUAL_UINT32(1, s.transactions);
+
+        // Re-encoding what was drawn gives back the build tool's stream
+        for (int16_t y = 0; y < asset->height; y++) {
+            for (int16_t x = 0; x < asset->width; x++) {
+                pixels[y * asset->width + x] = display_host_get_pixel(x, y);
+            }
+        }
+        uint16_t palette[ASSET_PALETTE_MAX];
+        uint8_t palette_count = 0;
+        uint32_t size = asset_encode(pixels, asset->width, asset->height, asset->format,
+                                     palette, &palette_count, stream, sizeof(stream));
+        TEST_ASSERT_EQUAL_UINT32(asset->size, size);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(asset->data, stream, size);
+        if (asset->format == ASSET_FORMAT_PALETTE) {
+            TEST_ASSERT_EQUAL_UINT8(asset->palette_count, palette_count);
+            TEST_ASSERT_EQUAL_HEX16_ARRAY(asset->palette, palette, palette_count);
+        }
+    }
+
+    uint32_t raw = (uint32_t)asset_splash.width * asset_splash.height * 2;
+    uint32_t flash = asset_splash.size + asset_splash.palette_count * 2;
+    TEST_ASSERT_TRUE(flash * 10 < raw);
+    char msg[96];
+    snprintf(msg, sizeof(msg), "splash %ux%u: %u bytes in flash vs %u raw RGB565",
+             (unsigned)asset_splash.width, (unsigned)asset_splash.height,
+             (unsigned)flash, (unsigned)raw);
+    TEST_MESSAGE(msg);
+}
+
+void test_asset_clipped_and_malformed() {
+    // Excluded band across the middle of the splash stays untouched
+    display_clear(UI_COLOR_BACKGROUND);
+    display_fill_rect(0, 150, LCD_WIDTH, 10, UI_COLOR_DEBUG);
+    TEST_ASSERT_TRUE(display_clip_exclude_push(0, 150, LCD_WIDTH, 10));
+    TEST_ASSERT_TRUE(asset_draw(&asset_splash, 25, 104));
+    display_clip_exclude_pop();
+    for (int16_t y = 150; y < 160; y++) {
+        for (int16_t x = 25; x < 25 + asset_splash.width; x++) {
+            TEST_ASSERT_EQUAL_HEX16(UI_COLOR_DEBUG, display_host_get_pixel(x, y));
+        }
+    }
+    static uint16_t expect[LCD_WIDTH * LCD_HEIGHT];
+    for (int16_t y = 0; y < asset_splash.height; y++) {
+        for (int16_t x = 0; x < asset_splash.width; x++) {
+            expect[y * asset_splash.width + x] = display_host_get_pixel(25 + x, 104 + y);
+        }
+    }
+    display_clear(UI_COLOR_BACKGROUND);
+    asset_draw(&asset_splash, 25, 104);
+    for (int16_t y = 0; y < asset_splash.height; y++) {
+        if (y + 104 >= 150 && y + 104 < 160) continue;
+        for (int16_t x = 0; x < asset_splash.width; x++) {
+            TEST_ASSERT_EQUAL_HEX16(display_host_get_pixel(25 + x, 104 + y),
+                                    expect[y * asset_splash.width + x]);
+        }
+    }
+
+    // Truncated or overlong streams are rejected
+    Asset cut = asset_splash;
+    cut.size -= 1;
+    TEST_ASSERT_FALSE(asset_valid(&cut));
+    Asset small = asset_fuel_pump;
+    small.height -= 1;
+    TEST_ASSERT_FALSE(asset_valid(&small));
+    TEST_ASSERT_FALSE(asset_draw(&small, 0, 0));
+}
+
+// ============================================================================
+// Test: Display Hysteresis
+// ============================================================================
+
+void test_shown_value_holds_on_reversal_only() {
+    ShownValue v;
+    shown_value_init(&v, 1.0f, 0.5f);
+    TEST_ASSERT_TRUE(shown_value_update(&v, 10.2f));
+    TEST_ASSERT_EQUAL_INT32(10, v.level);
+    TEST_ASSERT_TRUE(shown_value_update(&v, 10.6f));     // Rising: plain rounding
+    TEST_ASSERT_EQUAL_INT32(11, v.level);
+    TEST_ASSERT_FALSE(shown_value_update(&v, 10.4f));    // Back down inside the band
+    TEST_ASSERT_FALSE(shown_value_update(&v, 10.0f));
+    TEST_ASSERT_TRUE(shown_value_update(&v, 9.9f));      // Past 11 - 0.5 - 0.5
+    TEST_ASSERT_EQUAL_INT32(10, v.level);
+    TEST_ASSERT_FALSE(shown_value_update(&v, 10.6f));    // And up again needs the band too
+    TEST_ASSERT_TRUE(shown_value_update(&v, 12.7f));
+    TEST_ASSERT_EQUAL_INT32(13, v.level);
+    
+    // A monotone input is tracked exactly, like plain rounding
+    shown_value_set(&v, 0);
+    for (float x = 0.0f; x < 20.0f; x += 0.05f) {
+        shown_value_update(&v, x);
+        TEST_ASSERT_EQUAL_INT32(shown_value_round(x, 1.0f), v.level);
+    }
+    
+    // Band 0 is plain rounding in both directions
+    shown_value_init(&v, 0.01f, 0.0f);
+    shown_value_update(&v, 1.234f);
+    TEST_ASSERT_TRUE(shown_value_update(&v, 1.224f));
+    TEST_ASSERT_EQUAL_INT32(122, v.level);
+}
+
+// Noisy level trace: base level plus uniform noise of +/- amplitude
+static float noisy_level(uint32_t* seed, float base, float amplitude) {
+    *seed = *seed * 1103515245u + 12345u;
+    float u = (float)((*seed >> 8) & 0xFFFF) / 65535.0f;
+    return base + (2.0f * u - 1.0f) * amplitude;
+}
+
+// Redraws the gauge made before hysteresis: any change of rounded value
+static bool plain_rounding_redraw(float old_percent, float new_percent) {
+    int old_gallons = (int)((old_percent / 100.0f) * TANK_CAPACITY_GALLONS + 0.5f);
+    int new_gallons = (int)((new_percent / 100.0f) * TANK_CAPACITY_GALLONS + 0.5f);
+    return gauge_get_fill_pixels(old_percent) != gauge_get_fill_pixels(new_percent) ||
+           old_gallons != new_gallons || (int)(old_percent + 0.5f) != (int)(new_percent + 0.5f);
+}
+
+void test_gauge_noise_replay_redraws() {
+    // Parked on a percent, gallon and pixel boundary (50.5% = 25.25 G,
+    // 131.3 px), then a slow drain through many boundaries
+    struct { float start; float end; float noise; const char* name; } traces[] = {
+        {50.5f, 50.5f, 0.2f, "parked"},
+        {60.0f, 45.0f, 0.2f, "draining"},
+    };
+    const int samples = 1000;
+    for (unsigned t = 0; t < sizeof(traces) / sizeof(traces[0]); t++) {
+        uint32_t seed = 2024u + t;
+        display_init();
+        gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, traces[t].start, 1);
+        display_stats_reset();
+        
+        int before = 0;
+        int after = 0;
+        float plain_prev = traces[t].start;
+        float prev = traces[t].start;
+        float level = traces[t].start;
+        for (int i = 1; i <= samples; i++) {
+            float base = traces[t].start + (traces[t].end - traces[t].start) * i / samples;
+            level = noisy_level(&seed, base, traces[t].noise);
+            if (plain_rounding_redraw(plain_prev, level)) {
+                before++;
+                plain_prev = level;
+            }
+            if (gauge_update_if_changed(TEST_GAUGE_X, TEST_GAUGE_Y, prev, level, 1)) {
+                after++;
+                prev = level;
+            }
+        }
+        DisplayStats s = display_stats_get();
+        
+        char msg[128];
+        snprintf(msg, sizeof(msg), "%s +/-%.1f%%: %d redraws with plain rounding, %d with hysteresis (%u px)",
+                 traces[t].name, (double)traces[t].noise, before, after, (unsigned)s.pixels);
+        TEST_MESSAGE(msg);
+        TEST_ASSERT_TRUE(after * 4 < before);
+        
+        // The bar never strays further from the input than noise plus band
+        int shown_px = gauge_get_fill_pixels(prev);
+        float limit = (traces[t].noise * 2.0f + MIN_CHANGE_PERCENT) / 100.0f * GAUGE_SEGMENT_COUNT * GAUGE_SEGMENT_HEIGHT + 1.0f;
+        TEST_ASSERT_TRUE(fabsf(shown_px - level / 100.0f * GAUGE_SEGMENT_COUNT * GAUGE_SEGMENT_HEIGHT) <= limit);
+    }
+}
+
+void test_debug_overlay_ignores_adc_jitter() {
+    display_init();
+    debug_draw_overlay(2047, fuel_sensor_adc_to_voltage(2047), 120.0f,
+                       1000, fuel_sensor_adc_to_voltage(1000), 200.0f);
+    
+    // +/-1 count of ADC noise and a resistance sitting on an ohm boundary
+    int redraws = 0;
+    for (int i = 0; i < 200; i++) {
+        uint16_t raw = (i & 1) ? 2048 : 2047;
+        display_stats_reset();
+        debug_draw_overlay(raw, fuel_sensor_adc_to_voltage(raw), (i & 1) ? 120.6f : 120.4f,
+                           1000, fuel_sensor_adc_to_voltage(1000), 200.0f);
+        if (display_stats_get().transactions > 0) {
+            redraws++;
+        }
+    }
+    // The first move in each direction is taken, the jitter after it is not
+    TEST_ASSERT_TRUE(redraws <= 1);
+}
+
+// ============================================================================
+// Test: Text Formatter
+// ============================================================================
+
+void test_text_format_padding_and_alignment() {
+    char buf[16];
+    TEST_ASSERT_EQUAL_INT(1, text_format_int(buf, sizeof(buf), 0, 0, ' ', TEXT_ALIGN_LEFT));
+    TEST_ASSERT_EQUAL_STRING("0", buf);
+    text_format_int(buf, sizeof(buf), -2147483647 - 1, 0, ' ', TEXT_ALIGN_LEFT);
+    TEST_ASSERT_EQUAL_STRING("-2147483648", buf);
+    
+    // Field width with each alignment and zero padding after the sign
+    TEST_ASSERT_EQUAL_INT(3, text_format_int(buf, sizeof(buf), 7, 3, ' ', TEXT_ALIGN_RIGHT));
+    TEST_ASSERT_EQUAL_STRING("  7", buf);
+    text_format_int(buf, sizeof(buf), 7, 3, ' ', TEXT_ALIGN_LEFT);
+    TEST_ASSERT_EQUAL_STRING("7  ", buf);
+    text_format_int(buf, sizeof(buf), -7, 4, '*', TEXT_ALIGN_CENTER);
+    TEST_ASSERT_EQUAL_STRING("*-7*", buf);
+    text_format_int(buf, sizeof(buf), -7, 4, '0', TEXT_ALIGN_LEFT);
+    TEST_ASSERT_EQUAL_STRING("-007", buf);
+    text_format_int(buf, sizeof(buf), 1234, 2, ' ', TEXT_ALIGN_RIGHT);
+    TEST_ASSERT_EQUAL_STRING("1234", buf);  // Width is a minimum
+    
+    // Fixed point: leading zero, negative fractions
+    text_format_fixed(buf, sizeof(buf), 5, 2, 0, ' ', TEXT_ALIGN_LEFT);
+    TEST_ASSERT_EQUAL_STRING("0.05", buf);
+    text_format_fixed(buf, sizeof(buf), -125, 1, 6, ' ', TEXT_ALIGN_RIGHT);
+    TEST_ASSERT_EQUAL_STRING(" -12.5", buf);
+    text_format_float(buf, sizeof(buf), 3.14159f, 3, 0, ' ', TEXT_ALIGN_LEFT);
+    TEST_ASSERT_EQUAL_STRING("3.142", buf);
+    TEST_ASSERT_EQUAL_INT32(-13, text_scale_float(-1.25f, 1));
+    
+    // Too small a buffer leaves an empty string; append refuses to overflow
+    TEST_ASSERT_EQUAL_INT(0, text_format_int(buf, 3, 100, 0, ' ', TEXT_ALIGN_LEFT));
+    TEST_ASSERT_EQUAL_STRING("", buf);
+    int len = text_format_int(buf, 4, 42, 0, ' ', TEXT_ALIGN_LEFT);
+    TEST_ASSERT_EQUAL_INT(3, text_append(buf, 4, len, "G"));
+    TEST_ASSERT_EQUAL_INT(0, text_append(buf, 4, 3, "%"));
+    TEST_ASSERT_EQUAL_STRING("42G", buf);
+}
+
+void test_text_format_matches_printf() {
+    char ours[TEXT_NUMBER_MAX + 1];
+    char ref[32];
+    
+    // Values a few tenths of a last digit away from a rounding tie, so
+    // float and double rounding agree
+    static const int32_t scale[4] = {1, 10, 100, 1000};
+    for (uint8_t d = 0; d <= 3; d++) {
+        for (int32_t n = -20000; n <= 20000; n += 7) {
+            int32_t tenths = n * 10 + ((n & 1) ? 3 : 7);
+            float v = (float)tenths / (float)(scale[d] * 10);
+            text_format_float(ours, sizeof(ours), v, d, 0, ' ', TEXT_ALIGN_LEFT);
+            snprintf(ref, sizeof(ref), "%.*f", d, (double)v);
+            if (strcmp(ref, "-0") == 0 || strcmp(ref, "-0.0") == 0 ||
+                strcmp(ref, "-0.00") == 0 || strcmp(ref, "-0.000") == 0) {
+                continue;  // printf keeps the sign of a value that rounds to zero
+            }
+            TEST_ASSERT_EQUAL_STRING(ref, ours);
+        }
+    }
+}
+
+void test_text_width_from_font_metrics() {
+    // The gauge readouts keep their old centering
+    TEST_ASSERT_EQUAL_INT16(36, text_width(&glyph_font_glcd, " 7G", 2));
+    TEST_ASSERT_EQUAL_INT16(48, text_width(&glyph_font_glcd, "100%", 2));
+    TEST_ASSERT_EQUAL_INT16(6, display_get_text_width("\n1", 1));
+    
+    static const GlyphFont wide = {9, 12, nullptr};
+    TEST_ASSERT_EQUAL_INT16(27, text_width(&wide, "1.5", 1));
+    
+    // Printed text advances the cursor by the reported width
+    display_init();
+    display_set_text_size(2);
+    display_set_cursor(10, 0);
+    display_print_float(12.5f, 1);
+    char probe[8];
+    text_format_float(probe, sizeof(probe), 12.5f, 1, 0, ' ', TEXT_ALIGN_LEFT);
+    display_set_text_color(UI_COLOR_TEXT);
+    int16_t w = display_get_text_width(probe, 2);
+    uint16_t before = display_host_get_pixel(10 + w, 4);
+    display_print("|");  // Lands right after the number
+    TEST_ASSERT_NOT_EQUAL(before, display_host_get_pixel(10 + w + 4, 4));
+}
+
+// Arduino Print::printFloat() + printNumber(), writing into a buffer instead
+// of a stream (the path display_print_float() took through LovyanGFX)
+static int arduino_print_float(char* out, double number, uint8_t digits) {
+    int n = 0;
+    if (number < 0.0) {
+        out[n++] = '-';
+        number = -number;
+    }
+    double rounding = 0.5;
+    for (uint8_t i = 0; i < digits; ++i) {
+        rounding /= 10.0;
+    }
+    number += rounding;
+    unsigned long int_part = (unsigned long)number;
+    double remainder = number - (double)int_part;
+    
+    char digits_buf[12];
+    int k = 0;
+    do {
+        digits_buf[k++] = (char)('0' + int_part % 10);
+        int_part /= 10;
+    } while (int_part);
+    while (k) out[n++] = digits_buf[--k];
+    
+    if (digits > 0) out[n++] = '.';
+    while (digits-- > 0) {
+        remainder *= 10.0;
+        unsigned int to_print = (unsigned int)remainder;
+        out[n++] = (char)('0' + to_print);
+        remainder -= to_print;
+    }
+    out[n] = '\0';
+    return n;
+}
+
+void test_text_format_benchmark() {
+    const int count = 200000;
+    char buf[32];
+    volatile uint32_t sink = 0;
+    
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        sink += text_format_float(buf, sizeof(buf), (float)i * 0.013f, 2, 0, ' ', TEXT_ALIGN_LEFT);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        sink += arduino_print_float(buf, (double)((float)i * 0.013f), 2);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        sink += snprintf(buf, sizeof(buf), "%.*f", 2, (double)((float)i * 0.013f));
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        sink += text_format_int(buf, sizeof(buf), i * 37, 0, ' ', TEXT_ALIGN_LEFT);
+    }
+    auto t4 = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        sink += snprintf(buf, sizeof(buf), "%d", i * 37);
+    }
+    auto t5 = std::chrono::steady_clock::now();
+    
+    double fixed_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / count;
+    double print_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / count;
+    double printf_ns = std::chrono::duration<double, std::nano>(t3 - t2).count() / count;
+    double int_ns = std::chrono::duration<double, std::nano>(t4 - t3).count() / count;
+    double printf_int_ns = std::chrono::duration<double, std::nano>(t5 - t4).count() / count;
+    char msg[200];
+    snprintf(msg, sizeof(msg),
+             "host (hardware double) float 2dp: text_format %.1f ns, Arduino Print %.1f ns, "
+             "snprintf %.1f ns | "
+             "int: text_format %.1f ns, snprintf %.1f ns",
+             fixed_ns, print_ns, printf_ns, int_ns, printf_int_ns);
+    TEST_MESSAGE(msg);
+    
+    // Same text as Arduino Print away from rounding ties
+    for (int i = 0; i < 1000; i++) {
+        float v = (float)i * 0.013f;
+        char ref[32];
+        text_format_float(buf, sizeof(buf), v, 2, 0, ' ', TEXT_ALIGN_LEFT);
+        arduino_print_float(ref, (double)v, 2);
+        if (fabsf(v * 100.0f - floorf(v * 100.0f) - 0.5f) > 0.01f) {
+            TEST_ASSERT_EQUAL_STRING(ref, buf);
+        }
+    }
+    TEST_ASSERT_TRUE(sink > 0);
+}
+
+// ============================================================================
+// Test: Widget Tree
+// ============================================================================
+
+#define UI_TEST_GRID_COLS     4
+#define UI_TEST_GRID_ROWS     2
+#define UI_TEST_TILES         (UI_TEST_GRID_COLS * UI_TEST_GRID_ROWS)
+
+static int ui_test_draws[UI_WIDGET_MAX];
+static ClipRect ui_test_damage[UI_WIDGET_MAX];
+static UiWidget ui_test_widgets[UI_WIDGET_MAX];
+static uint16_t ui_test_colors[UI_WIDGET_MAX];
+
+// Test widget: paints its whole bounds in one color
+static void ui_test_draw(UiWidget* widget, const ClipRect* damage) {
+    int i = (int)(widget - ui_test_widgets);
+    ui_test_draws[i]++;
+    ui_test_damage[i] = damage ? *damage : ClipRect{0, 0, 0, 0};
+    display_fill_rect(widget->bounds.x, widget->bounds.y, widget->bounds.w, widget->bounds.h,
+                      *(uint16_t*)widget->context);
+}
+
+static UiWidget* ui_test_widget(UiTree* tree, int i, int16_t x, int16_t y, int16_t w, int16_t h,
+                                int8_t z, uint16_t color) {
+    UiWidget* widget = &ui_test_widgets[i];
+    ui_test_colors[i] = color;
+    widget->bounds = {x, y, w, h};
+    widget->z = z;
+    widget->draw = ui_test_draw;
+    widget->context = &ui_test_colors[i];
+    TEST_ASSERT_TRUE(ui_add(tree, widget));
+    ui_set_visible(tree, widget, true);
+    return widget;
+}
+
+// Grid of tiles covering the top of the screen
+static void ui_test_grid(UiTree* tree) {
+    ui_init(tree);
+    for (int r = 0; r < UI_TEST_GRID_ROWS; r++) {
+        for (int c = 0; c < UI_TEST_GRID_COLS; c++) {
+            int i = r * UI_TEST_GRID_COLS + c;
+            ui_test_widget(tree, i, (int16_t)(c * 40), (int16_t)(r * 50), 40, 50, 0,
+                           (uint16_t)(0x0841 * (i + 1)));
+        }
+    }
+    memset(ui_test_draws, 0, sizeof(ui_test_draws));
+}
+
+void test_ui_dirty_widget_draws_alone() {
+    static UiTree tree;
+    display_init();
+    ui_test_grid(&tree);
+    
+    // First frame: every shown widget paints once, damage merged into one rect
+    TEST_ASSERT_EQUAL_INT(UI_TEST_TILES, ui_render(&tree));
+    TEST_ASSERT_EQUAL_UINT16(1, ui_stats_get().damage_rects);
+    TEST_ASSERT_FALSE(ui_pending(&tree));
+    
+    // One value changed: one incremental draw, nothing else visited
+    memset(ui_test_draws, 0, sizeof(ui_test_draws));
+    ui_mark_dirty(&tree, &ui_test_widgets[5]);
+    TEST_ASSERT_EQUAL_INT(1, ui_render(&tree));
+    TEST_ASSERT_EQUAL_INT(1, ui_test_draws[5]);
+    TEST_ASSERT_EQUAL_INT16(0, ui_test_damage[5].w);  // Incremental
+    TEST_ASSERT_EQUAL_INT(0, ui_render(&tree));
+    
+    // A damaged area repaints only the tiles under it, with their share
+    ui_damage(&tree, 45, 55, 10, 10);
+    TEST_ASSERT_EQUAL_INT(1, ui_render(&tree));
+    TEST_ASSERT_EQUAL_INT(2, ui_test_draws[5]);
+    TEST_ASSERT_EQUAL_INT16(45, ui_test_damage[5].x);
+    TEST_ASSERT_EQUAL_INT16(10, ui_test_damage[5].w);
+    
+    ui_damage(&tree, 35, 45, 10, 10);  // Corner of four tiles
+    TEST_ASSERT_EQUAL_INT(4, ui_render(&tree));
+}
+
+void test_ui_overlay_keeps_its_pixels() {
+    static UiTree tree;
+    display_init();
+    ui_test_grid(&tree);
+    UiWidget* overlay = ui_test_widget(&tree, UI_TEST_TILES, 20, 30, 100, 40, 1, UI_COLOR_DEBUG);
+    UiWidget* late = ui_test_widget(&tree, UI_TEST_TILES + 1, 0, 200, 40, 40, 0, UI_COLOR_TEXT);
+    TEST_ASSERT_TRUE(late->slot < overlay->slot);  // Added later, still below
+    ui_render(&tree);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_DEBUG, display_host_get_pixel(50, 40));
+    
+    // A tile under the overlay redraws around it (no full-screen compare needed)
+    ui_mark_dirty(&tree, &ui_test_widgets[1]);
+    ui_render(&tree);
+    TEST_ASSERT_EQUAL_UINT16(1, ui_stats_get().exclusions);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_DEBUG, display_host_get_pixel(50, 40));
+    TEST_ASSERT_EQUAL_HEX16(ui_test_colors[1], display_host_get_pixel(50, 10));
+    
+    // Hiding the overlay repaints the tiles it covered, and only those
+    memset(ui_test_draws, 0, sizeof(ui_test_draws));
+    ui_set_visible(&tree, overlay, false);
+    TEST_ASSERT_EQUAL_INT(6, ui_render(&tree));
+    TEST_ASSERT_EQUAL_INT(0, ui_test_draws[3]);
+    TEST_ASSERT_EQUAL_HEX16(ui_test_colors[1], display_host_get_pixel(50, 40));
+    TEST_ASSERT_EQUAL_HEX16(ui_test_colors[5], display_host_get_pixel(50, 60));
+}
+
+void test_ui_damage_merges_rects() {
+    static UiTree tree;
+    ui_init(&tree);
+    
+    // Touching rects merge; separate ones stay apart
+    ui_damage(&tree, 0, 0, 10, 10);
+    ui_damage(&tree, 10, 0, 10, 10);
+    ui_damage(&tree, 100, 100, 5, 5);
+    TEST_ASSERT_EQUAL_UINT8(2, tree.damage_count);
+    
+    // A bridging rect pulls both into one
+    ui_damage(&tree, 15, 5, 90, 96);
+    TEST_ASSERT_EQUAL_UINT8(1, tree.damage_count);
+    TEST_ASSERT_EQUAL_INT16(0, tree.damage[0].x);
+    TEST_ASSERT_EQUAL_INT16(105, tree.damage[0].w);
+    
+    // Past the limit, rects merge by least growth and still cover everything
+    ui_init(&tree);
+    for (int i = 0; i < UI_DAMAGE_MAX + 4; i++) {
+        ui_damage(&tree, (int16_t)((i % 4) * 40), (int16_t)((i / 4) * 30), 5, 5);
+    }
+    TEST_ASSERT_TRUE(tree.damage_count <= UI_DAMAGE_MAX);
+    for (int i = 0; i < UI_DAMAGE_MAX + 4; i++) {
+        int16_t x = (int16_t)((i % 4) * 40 + 2);
+        int16_t y = (int16_t)((i / 4) * 30 + 2);
+        bool covered = false;
+        for (int d = 0; d < tree.damage_count; d++) {
+            const ClipRect* r = &tree.damage[d];
+            covered |= x >= r->x && x < r->x + r->w && y >= r->y && y < r->y + r->h;
+        }
+        TEST_ASSERT_TRUE(covered);
+    }
+    
+    // Off-screen parts are dropped
+    ui_init(&tree);
+    ui_damage(&tree, -10, LCD_HEIGHT - 5, 30, 30);
+    TEST_ASSERT_EQUAL_INT16(0, tree.damage[0].x);
+    TEST_ASSERT_EQUAL_INT16(5, tree.damage[0].h);
+}
+
+// ============================================================================
+// Test: Screen Layout
+// ============================================================================
+
+// Screens of the supported boards, portrait and landscape
+typedef BarLayout<170, 320, 2> Layout19Portrait;
+typedef BarLayout<320, 170, 2> Layout19Landscape;
+typedef BarLayout<240, 280, 2> Layout169Portrait;
+typedef BarLayout<280, 240, 2> Layout169Landscape;
+typedef BarLayout<172, 320, 2> Layout147Portrait;
+typedef BarLayout<320, 172, 2> Layout147Landscape;
+
+template <typename L>
+static void assert_layout_fits() {
+    TEST_ASSERT_TRUE(L::BARS_FIT_WIDTH);
+    TEST_ASSERT_TRUE(L::BARS_FIT_HEIGHT);
+    TEST_ASSERT_TRUE(L::SUMMARY_FITS);
+    TEST_ASSERT_TRUE(L::OVERLAY_FITS);
+    // Gauge bounds (border and both readouts) stay on screen
+    TEST_ASSERT_TRUE(L::tank_x(0) - 1 >= 0);
+    TEST_ASSERT_TRUE(L::GAUGE_Y - LAYOUT_LABEL_ROWS >= 0);
+    TEST_ASSERT_TRUE(L::GAUGE_Y - LAYOUT_LABEL_ROWS + L::GAUGE_ROWS <= L::SCREEN_H);
+    TEST_ASSERT_TRUE(L::tank_x(1) + GAUGE_WIDTH + 1 <= L::SCREEN_W);
+    TEST_ASSERT_TRUE(L::PERCENT_GAP >= LAYOUT_PERCENT_GAP_MIN);
+}
+
+void test_layout_default_board() {
+    // 1.9" portrait: the positions setup() used to compute at runtime
+    TEST_ASSERT_EQUAL_INT(15, ScreenLayout::tank_x(0));
+    TEST_ASSERT_EQUAL_INT(95, ScreenLayout::tank_x(1));
+    TEST_ASSERT_EQUAL_INT(19, ScreenLayout::GAUGE_Y);
+    TEST_ASSERT_EQUAL_INT(13, GAUGE_SEGMENT_HEIGHT);
+    TEST_ASSERT_EQUAL_INT(76, ScreenLayout::summary().x);
+    TEST_ASSERT_EQUAL_INT(23, ScreenLayout::summary().y);
+    TEST_ASSERT_EQUAL_INT(LCD_WIDTH / 2, dial_center_x(1));
+    TEST_ASSERT_EQUAL_INT(LCD_HEIGHT / 4, dial_center_y(1));
+
+    // The percentage readout ends on the last row
+    ClipRect bounds = gauge_bounds(ScreenLayout::tank_x(0), ScreenLayout::GAUGE_Y);
+    TEST_ASSERT_EQUAL_INT(LCD_HEIGHT, bounds.y + bounds.h);
+    TEST_ASSERT_TRUE(bounds.y >= 0);
+}
+
+void test_layout_fits_every_board() {
+    assert_layout_fits<Layout19Portrait>();
+    assert_layout_fits<Layout19Landscape>();
+    assert_layout_fits<Layout169Portrait>();
+    assert_layout_fits<Layout169Landscape>();
+    assert_layout_fits<Layout147Portrait>();
+    assert_layout_fits<Layout147Landscape>();
+
+    // Shorter screens get shorter segments, centered bars move with the width
+    TEST_ASSERT_EQUAL_INT(11, Layout169Portrait::SEGMENT_HEIGHT);
+    TEST_ASSERT_EQUAL_INT(5, Layout19Landscape::SEGMENT_HEIGHT);
+    TEST_ASSERT_EQUAL_INT(16, Layout147Portrait::tank_x(0));
+    TEST_ASSERT_EQUAL_INT(50, Layout169Portrait::tank_x(0));
+
+    // Dials stack in portrait and sit side by side in landscape
+    TEST_ASSERT_EQUAL_INT(Layout19Landscape::dial_y(0), Layout19Landscape::dial_y(1));
+    TEST_ASSERT_TRUE(Layout19Landscape::dial_x(1) - Layout19Landscape::dial_x(0) >= 2 * DIAL_RADIUS + 1);
+    TEST_ASSERT_TRUE(Layout19Landscape::DIALS_FIT);
+    TEST_ASSERT_TRUE(Layout19Portrait::DIALS_FIT);
+}
+
+void test_layout_flags_what_does_not_fit() {
+    TEST_ASSERT_FALSE((BarLayout<170, 320, 3>::BARS_FIT_WIDTH));
+    TEST_ASSERT_FALSE((BarLayout<320, 100, 2>::BARS_FIT_HEIGHT));
+    TEST_ASSERT_FALSE((BarLayout<320, 100, 2>::OVERLAY_FITS));
+    TEST_ASSERT_FALSE(Layout169Portrait::DIALS_FIT);     // 140-row cells, 145-pixel dials
+    TEST_ASSERT_TRUE((BarLayout<320, 170, 3>::BARS_FIT_WIDTH));
+}
+
+// ============================================================================
+// Test: Indexed Frame
+// ============================================================================
+
+static IndexedFrame test_frame;
+
+typedef struct {
+    int calls;
+    int rows;
+    int max_rows;
+    int mismatches;
+    bool swapped;
+    const uint16_t* last_buffer;
+    bool buffers_alternate;
+} IndexedCapture;
+
+// Check every chunk against the indexed pixels it came from
+static void capture_chunk(void* context, int16_t y, int16_t rows, const uint16_t* pixels) {
+    IndexedCapture* cap = (IndexedCapture*)context;
+    if (cap->calls > 0 && pixels == cap->last_buffer) {
+        cap->buffers_alternate = false;
+    }
+    cap->last_buffer = pixels;
+    cap->calls++;
+    cap->rows += rows;
+    if (rows > cap->max_rows) cap->max_rows = rows;
+    for (int16_t r = 0; r < rows; r++) {
+        for (int16_t x = 0; x < LCD_WIDTH; x++) {
+            uint16_t c = indexed_frame_pixel(&test_frame, x, y + r);
+            if (cap->swapped) c = (uint16_t)((c >> 8) | (c << 8));
+            if (pixels[r * LCD_WIDTH + x] != c) cap->mismatches++;
+        }
+    }
+}
+
+static IndexedCapture push_test_frame(bool swapped) {
+    IndexedCapture cap = {0, 0, 0, 0, swapped, nullptr, true};
+    indexed_frame_push(&test_frame, swapped, capture_chunk, &cap);
+    return cap;
+}
+
+void test_indexed_frame_fill_and_write() {
+    indexed_frame_init(&test_frame, UI_COLOR_BACKGROUND);
+    // Odd start and odd end: nibble edges around whole bytes
+    indexed_frame_fill(&test_frame, 3, 5, 6, 2, UI_COLOR_RED);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BACKGROUND, indexed_frame_pixel(&test_frame, 2, 5));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, indexed_frame_pixel(&test_frame, 3, 5));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, indexed_frame_pixel(&test_frame, 8, 6));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BACKGROUND, indexed_frame_pixel(&test_frame, 9, 6));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BACKGROUND, indexed_frame_pixel(&test_frame, 3, 7));
+    // One pixel inside a byte, and a fill hanging off the screen
+    indexed_frame_fill(&test_frame, 4, 10, 1, 1, UI_COLOR_GREEN);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_GREEN, indexed_frame_pixel(&test_frame, 4, 10));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_BACKGROUND, indexed_frame_pixel(&test_frame, 5, 10));
+    indexed_frame_fill(&test_frame, LCD_WIDTH - 2, LCD_HEIGHT - 1, 10, 10, UI_COLOR_TEXT);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_TEXT, indexed_frame_pixel(&test_frame, LCD_WIDTH - 1, LCD_HEIGHT - 1));
+
+    const uint16_t run[] = {UI_COLOR_RED, UI_COLOR_YELLOW, UI_COLOR_GREEN};
+    indexed_frame_write(&test_frame, -1, 20, 3, run);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_YELLOW, indexed_frame_pixel(&test_frame, 0, 20));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_GREEN, indexed_frame_pixel(&test_frame, 1, 20));
+    TEST_ASSERT_EQUAL_INT(5, test_frame.colors);
+
+    // Expansion matches the pixels in both byte orders
+    IndexedCapture cap = push_test_frame(false);
+    TEST_ASSERT_EQUAL_INT(LCD_HEIGHT, cap.rows);
+    TEST_ASSERT_EQUAL_INT(0, cap.mismatches);
+    indexed_frame_fill(&test_frame, 0, 0, LCD_WIDTH, LCD_HEIGHT, UI_COLOR_EMPTY);
+    indexed_frame_fill(&test_frame, 7, 30, 50, 40, UI_COLOR_BORDER);
+    cap = push_test_frame(true);
+    TEST_ASSERT_EQUAL_INT(0, cap.mismatches);
+}
+
+void test_indexed_frame_pushes_dirty_rows_in_chunks() {
+    indexed_frame_init(&test_frame, UI_COLOR_BACKGROUND);
+    IndexedCapture cap = push_test_frame(true);
+    TEST_ASSERT_EQUAL_INT(LCD_HEIGHT, cap.rows);
+    TEST_ASSERT_EQUAL_INT(DISPLAY_INDEXED_CHUNK_ROWS, cap.max_rows);
+    TEST_ASSERT_TRUE(cap.buffers_alternate);
+
+    // Nothing changed: nothing to send
+    cap = push_test_frame(true);
+    TEST_ASSERT_EQUAL_INT(0, cap.calls);
+
+    // Two separate bands: only their rows go out
+    indexed_frame_fill(&test_frame, 10, 40, 5, 3, UI_COLOR_RED);
+    indexed_frame_fill(&test_frame, 60, 200, 1, DISPLAY_INDEXED_CHUNK_ROWS + 1, UI_COLOR_GREEN);
+    TEST_ASSERT_TRUE(indexed_frame_row_dirty(&test_frame, 42));
+    TEST_ASSERT_FALSE(indexed_frame_row_dirty(&test_frame, 43));
+    cap = push_test_frame(true);
+    TEST_ASSERT_EQUAL_INT(3 + DISPLAY_INDEXED_CHUNK_ROWS + 1, cap.rows);
+    TEST_ASSERT_EQUAL_INT(3, cap.calls);
+    TEST_ASSERT_EQUAL_INT(0, cap.mismatches);
+    TEST_ASSERT_FALSE(indexed_frame_row_dirty(&test_frame, 40));
+}
+
+void test_indexed_frame_recolor_marks_rows_of_that_color() {
+    indexed_frame_init(&test_frame, UI_COLOR_BACKGROUND);
+    indexed_frame_fill(&test_frame, 20, 100, 30, 4, UI_COLOR_GREEN);
+    indexed_frame_fill(&test_frame, 20, 150, 30, 4, UI_COLOR_RED);
+    push_test_frame(true);
+
+    TEST_ASSERT_TRUE(indexed_frame_recolor(&test_frame, UI_COLOR_GREEN, UI_COLOR_YELLOW));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_YELLOW, indexed_frame_pixel(&test_frame, 25, 101));
+    IndexedCapture cap = push_test_frame(true);
+    TEST_ASSERT_EQUAL_INT(4, cap.rows);
+    TEST_ASSERT_EQUAL_INT(0, cap.mismatches);
+    TEST_ASSERT_FALSE(indexed_frame_recolor(&test_frame, UI_COLOR_DEBUG, UI_COLOR_RED));
+
+    // A 17th color takes the nearest entry
+    indexed_frame_init(&test_frame, 0x0000);
+    for (int i = 1; i < INDEXED_COLORS; i++) {
+        indexed_frame_fill(&test_frame, i, 0, 1, 1, (uint16_t)(i << 11));
+    }
+    indexed_frame_fill(&test_frame, 0, 1, 1, 1, (uint16_t)((7 << 11) | 1));
+    TEST_ASSERT_EQUAL_INT(INDEXED_COLORS, test_frame.colors);
+    TEST_ASSERT_EQUAL_HEX16(7 << 11, indexed_frame_pixel(&test_frame, 0, 1));
+}
+
+void test_indexed_display_matches_direct() {
+    display_init();
+    draw_gauge_direct(57.0f);
+    display_set_text_size(2);
+    display_set_text_color(UI_COLOR_TEXT);
+    display_set_cursor(3, 290);
+    display_print("Fuel 1\n2");
+    save_frame();
+
+    display_init();
+    TEST_ASSERT_TRUE(display_indexed_enable(true));
+    TEST_ASSERT_TRUE(display_indexed_active());
+    TEST_ASSERT_FALSE(display_canvas_begin(0, 0, 10, 10));
+    display_frame_begin();
+    draw_gauge_direct(57.0f);
+    display_set_text_size(2);
+    display_set_text_color(UI_COLOR_TEXT);
+    display_set_cursor(3, 290);
+    display_print("Fuel 1\n2");
+    display_frame_end();
+    display_wait();
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+
+    // A theme change is one palette write and a push of the rows using it
+    display_stats_reset();
+    TEST_ASSERT_TRUE(display_palette_replace(UI_COLOR_BORDER, UI_COLOR_DEBUG));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_DEBUG, display_host_get_pixel(TEST_GAUGE_X - 1, TEST_GAUGE_Y + 20));
+    uint32_t border_rows = 0;
+    for (int y = 0; y < LCD_HEIGHT; y++) {
+        for (int x = 0; x < LCD_WIDTH; x++) {
+            if (saved_frame[y * LCD_WIDTH + x] == UI_COLOR_BORDER) {
+                border_rows++;
+                break;
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(border_rows, display_stats_get().pixels / LCD_WIDTH);
+    TEST_ASSERT_FALSE(display_palette_replace(UI_COLOR_BORDER, UI_COLOR_DEBUG));
+
+    display_indexed_enable(false);
+    TEST_ASSERT_FALSE(display_indexed_active());
+    TEST_ASSERT_FALSE(display_palette_replace(UI_COLOR_DEBUG, UI_COLOR_BORDER));
+}
+
+void test_indexed_frame_benchmark() {
+    // Level change: direct drawing sends what changed, the indexed frame
+    // sends the changed rows at full width
+    display_init();
+    gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, 57.0f, 1);
+    display_stats_reset();
+    gauge_update_if_changed(TEST_GAUGE_X, TEST_GAUGE_Y, 57.0f, 43.0f, 1);
+    DisplayStats direct = display_stats_get();
+    save_frame();
+
+    display_init();
+    display_indexed_enable(true);
+    gauge_draw(TEST_GAUGE_X, TEST_GAUGE_Y, 57.0f, 1);
+    display_stats_reset();
+    display_frame_begin();
+    gauge_update_if_changed(TEST_GAUGE_X, TEST_GAUGE_Y, 57.0f, 43.0f, 1);
+    display_frame_end();
+    display_wait();
+    DisplayStats indexed = display_stats_get();
+    TEST_ASSERT_EQUAL_INT(0, count_frame_diffs());
+    display_indexed_enable(false);
+
+    // Full-frame expansion (every row dirty)
+    const int iterations = 200;
+    IndexedCapture cap = {0, 0, 0, 0, true, nullptr, true};
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        indexed_frame_fill(&test_frame, 0, 0, LCD_WIDTH, LCD_HEIGHT, (i & 1) ? UI_COLOR_RED : UI_COLOR_EMPTY);
+        cap.rows += indexed_frame_push(&test_frame, true, [](void*, int16_t, int16_t, const uint16_t*) {}, nullptr);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double expand_us = std::chrono::duration<double, std::micro>(t1 - t0).count() / iterations;
+    // Bus time of a full frame at the panel's 40 MHz write clock
+    double bus_us = (double)LCD_WIDTH * LCD_HEIGHT * 16 / 40.0;
+
+    char msg[240];
+    snprintf(msg, sizeof(msg),
+             "RAM: indexed frame %u bytes vs RGB565 frame %u | level change: direct %u tx %u px, "
+             "indexed %u tx %u px | full frame: expand %.1f us (host), bus %.0f us",
+             (unsigned)sizeof(IndexedFrame), (unsigned)(LCD_WIDTH * LCD_HEIGHT * 2),
+             (unsigned)direct.transactions, (unsigned)direct.pixels,
+             (unsigned)indexed.transactions, (unsigned)indexed.pixels, expand_us, bus_us);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_EQUAL_INT(iterations * LCD_HEIGHT, cap.rows);
+    TEST_ASSERT_TRUE(sizeof(IndexedFrame) * 3 < (size_t)LCD_WIDTH * LCD_HEIGHT * 2);
+    TEST_ASSERT_TRUE(indexed.transactions <= (uint32_t)(LCD_HEIGHT + DISPLAY_INDEXED_CHUNK_ROWS - 1) / DISPLAY_INDEXED_CHUNK_ROWS);
+}
+
+// ============================================================================
+// Test: Push Pipeline
+// ============================================================================
+
+// Fake DMA bus: one transfer at a time, finished by the test
+typedef struct {
+    bool busy;
+    int started;
+    int16_t y;
+    int16_t rows;
+    const uint16_t* pixels;
+    uint16_t first;             // First pixel when the transfer started
+    int overwritten;            // Transfers whose pixels changed while on the bus
+    int done_calls;
+    uint32_t push_us;
+    uint32_t bus_us;
+} FakeBus;
+
+static bool fake_bus_busy(void* context) {
+    return ((FakeBus*)context)->busy;
+}
+
+static void fake_bus_start(void* context, int16_t y, int16_t rows, const uint16_t* pixels) {
+    FakeBus* bus = (FakeBus*)context;
+    bus->busy = true;
+    bus->started++;
+    bus->y = y;
+    bus->rows = rows;
+    bus->pixels = pixels;
+    bus->first = pixels[0];
+}
+
+static void fake_bus_finish(FakeBus* bus) {
+    if (bus->busy && bus->pixels[0] != bus->first) {
+        bus->overwritten++;
+    }
+    bus->busy = false;
+}
+
+static void fake_bus_done(void* context, uint32_t push_us, uint32_t bus_us) {
+    FakeBus* bus = (FakeBus*)context;
+    bus->done_calls++;
+    bus->push_us = push_us;
+    bus->bus_us = bus_us;
+}
+
+void test_push_pipeline_expands_while_bus_busy() {
+    // A different color per chunk, so a reused buffer shows
+    indexed_frame_init(&test_frame, UI_COLOR_BACKGROUND);
+    for (int y = 0; y < LCD_HEIGHT; y += DISPLAY_INDEXED_CHUNK_ROWS) {
+        indexed_frame_fill(&test_frame, 0, y, LCD_WIDTH, DISPLAY_INDEXED_CHUNK_ROWS,
+                           (y / DISPLAY_INDEXED_CHUNK_ROWS) & 1 ? UI_COLOR_RED : UI_COLOR_GREEN);
+    }
+    FakeBus bus = {};
+    PushPipeline p;
+    push_pipeline_init(&p, &test_frame, fake_bus_busy, fake_bus_start, fake_bus_done, &bus);
+    TEST_ASSERT_TRUE(push_pipeline_begin(&p, false, 1000));
+    TEST_ASSERT_FALSE(push_pipeline_begin(&p, false, 1000));
+
+    // First chunk on the bus, the second already expanded
+    TEST_ASSERT_EQUAL_INT(1, bus.started);
+    TEST_ASSERT_NOT_NULL(p.queued);
+    TEST_ASSERT_TRUE(p.queued != bus.pixels);
+    TEST_ASSERT_TRUE(push_pipeline_service(&p, 1100));
+    TEST_ASSERT_EQUAL_INT(1, bus.started);
+
+    const int chunks = (LCD_HEIGHT + DISPLAY_INDEXED_CHUNK_ROWS - 1) / DISPLAY_INDEXED_CHUNK_ROWS;
+    uint32_t now = 1100;
+    while (push_pipeline_service(&p, now)) {
+        TEST_ASSERT_EQUAL_HEX16((bus.y / DISPLAY_INDEXED_CHUNK_ROWS) & 1 ? UI_COLOR_RED : UI_COLOR_GREEN,
+                                bus.pixels[LCD_WIDTH * bus.rows - 1]);
+        now += 500;
+        fake_bus_finish(&bus);
+    }
+    TEST_ASSERT_EQUAL_INT(chunks, bus.started);
+    TEST_ASSERT_EQUAL_INT(0, bus.overwritten);
+    TEST_ASSERT_EQUAL_INT(1, bus.done_calls);
+    TEST_ASSERT_EQUAL_UINT32(now - 1000, bus.push_us);
+    // Each chunk started where the one before was seen done
+    TEST_ASSERT_EQUAL_UINT32(bus.push_us, bus.bus_us);
+    TEST_ASSERT_FALSE(push_pipeline_active(&p));
+
+    // Nothing dirty: done at once
+    TEST_ASSERT_TRUE(push_pipeline_begin(&p, false, now));
+    TEST_ASSERT_EQUAL_INT(2, bus.done_calls);
+    TEST_ASSERT_EQUAL_INT(0, (int)push_pipeline_bus_us(0));
+    TEST_ASSERT_EQUAL_UINT32(LCD_WIDTH * LCD_HEIGHT * 16 / (LCD_SPI_WRITE_HZ / 1000000),
+                             push_pipeline_bus_us(LCD_WIDTH * LCD_HEIGHT));
+}
+
+static int frames_done = 0;
+static DisplayTiming done_timing;
+
+static void count_frame_done(void* context, const DisplayTiming* timing) {
+    (void)context;
+    frames_done++;
+    done_timing = *timing;
+}
+
+// A frame that changes the whole screen
+static DisplayStats draw_test_frame(uint16_t color) {
+    display_frame_begin();
+    display_host_advance_us(300);
+    display_fill_rect(0, 0, LCD_WIDTH, LCD_HEIGHT, color);
+    return display_frame_end();
+}
+
+void test_display_push_runs_behind_loop() {
+    display_init();
+    display_indexed_enable(true);
+    display_wait();
+    display_set_frame_done(count_frame_done, nullptr);
+    frames_done = 0;
+
+    // The frame ends with its pixels still going out; the push is not in
+    // the frame's own counts
+    DisplayStats drawn = draw_test_frame(UI_COLOR_RED);
+    TEST_ASSERT_EQUAL_UINT32(1, drawn.primitives);
+    TEST_ASSERT_EQUAL_UINT32(0, drawn.transactions);
+#if DISPLAY_ASYNC_ENABLE
+    TEST_ASSERT_TRUE(display_push_busy());
+    TEST_ASSERT_EQUAL_INT(0, frames_done);
+#endif
+
+    // Loop work while the push goes on, the bus keeps going
+    int polls = 0;
+    while (display_push_busy()) {
+        display_host_advance_us(200);
+        polls++;
+    }
+#if DISPLAY_ASYNC_ENABLE
+    TEST_ASSERT_TRUE(polls > 1);
+    TEST_ASSERT_EQUAL_UINT32(0, done_timing.wait_us);
+#endif
+    TEST_ASSERT_EQUAL_INT(1, frames_done);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, display_host_get_pixel(LCD_WIDTH - 1, LCD_HEIGHT - 1));
+    TEST_ASSERT_EQUAL_UINT32(300, done_timing.draw_us);
+    TEST_ASSERT_EQUAL_UINT32(push_pipeline_bus_us(LCD_WIDTH * LCD_HEIGHT), done_timing.bus_us);
+    TEST_ASSERT_TRUE(done_timing.push_us >= done_timing.bus_us);
+    TEST_ASSERT_EQUAL_UINT32(done_timing.push_us - done_timing.bus_us, done_timing.bus_idle_us);
+    // Chunks start from transfer completion, not from the loop's pace
+    TEST_ASSERT_EQUAL_UINT32(0, done_timing.bus_idle_us);
+    TEST_ASSERT_EQUAL_UINT32(done_timing.draw_us + done_timing.push_us, done_timing.frame_us);
+
+    // The next frame right away: it waits for the bus, and the picture is whole
+    draw_test_frame(UI_COLOR_GREEN);
+    draw_test_frame(UI_COLOR_YELLOW);
+#if DISPLAY_ASYNC_ENABLE
+    TEST_ASSERT_EQUAL_INT(2, frames_done);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_GREEN, display_host_get_pixel(0, LCD_HEIGHT - 1));
+#endif
+    TEST_ASSERT_EQUAL_UINT32(done_timing.push_us, done_timing.wait_us);
+    TEST_ASSERT_EQUAL_UINT32(0, done_timing.bus_idle_us);
+    display_wait();
+    TEST_ASSERT_EQUAL_INT(3, frames_done);
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_YELLOW, display_host_get_pixel(0, LCD_HEIGHT - 1));
+
+    display_set_frame_done(nullptr, nullptr);
+    display_indexed_enable(false);
+}
+
+void test_display_timing_benchmark() {
+    // Same full-screen change three ways, with loop work in 400 us steps
+    display_init();
+    display_indexed_enable(false);
+    draw_test_frame(UI_COLOR_RED);
+    DisplayTiming direct = display_timing_get();
+
+    display_indexed_enable(true);
+    display_wait();
+    draw_test_frame(UI_COLOR_GREEN);
+    display_wait();
+    DisplayTiming blocking = display_timing_get();
+
+    draw_test_frame(UI_COLOR_RED);
+    int polls = 0;
+    while (display_push_busy()) {
+        display_host_advance_us(400);
+        polls++;
+    }
+    DisplayTiming async = display_timing_get();
+    display_indexed_enable(false);
+
+    char msg[240];
+    snprintf(msg, sizeof(msg),
+             "full-screen frame (us): direct draw %u wait %u | indexed, waited: push %u wait %u | "
+             "indexed, background (%d loop steps): push %u wait %u bus %u bus idle %u",
+             (unsigned)direct.draw_us, (unsigned)direct.wait_us,
+             (unsigned)blocking.push_us, (unsigned)blocking.wait_us, polls,
+             (unsigned)async.push_us, (unsigned)async.wait_us, (unsigned)async.bus_us,
+             (unsigned)async.bus_idle_us);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_EQUAL_UINT32(direct.wait_us, push_pipeline_bus_us(LCD_WIDTH * LCD_HEIGHT));
+    TEST_ASSERT_EQUAL_UINT32(blocking.push_us, blocking.wait_us);
+#if DISPLAY_ASYNC_ENABLE
+    TEST_ASSERT_EQUAL_UINT32(0, async.wait_us);
+#endif
+    TEST_ASSERT_EQUAL_UINT32(async.bus_us, blocking.bus_us);
+    TEST_ASSERT_EQUAL_UINT32(0, async.bus_idle_us);
+}
+
+void test_canvas_double_buffer_overlaps_bus() {
+    // Two canvases in one direct frame, 2000 us of drawing into the second
+    display_init();
+    display_indexed_enable(false);
+    display_wait();
+    display_frame_begin();
+    TEST_ASSERT_TRUE(display_canvas_begin(0, 0, 100, 100));
+    display_fill_rect(0, 0, 100, 100, UI_COLOR_RED);
+    display_canvas_end();
+    TEST_ASSERT_TRUE(display_canvas_begin(0, 100, 100, 100));
+    display_host_advance_us(2000);
+    display_fill_rect(0, 100, 100, 100, UI_COLOR_GREEN);
+    display_canvas_end();
+    display_frame_end();
+    display_wait();
+    DisplayTiming t = display_timing_get();
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "two canvases, %d buffers (us): bus %u wait %u",
+             DISPLAY_CANVAS_BUFFERS, (unsigned)t.bus_us, (unsigned)t.wait_us);
+    TEST_MESSAGE(msg);
+
+    uint32_t one = push_pipeline_bus_us(100 * 100);
+    TEST_ASSERT_EQUAL_UINT32(2 * one, t.bus_us);
+#if DISPLAY_CANVAS_BUFFERS > 1
+    // The second canvas is drawn while the first is on the bus
+    TEST_ASSERT_EQUAL_UINT32(one - 2000, t.wait_us);
+#else
+    TEST_ASSERT_EQUAL_UINT32(one, t.wait_us);
+#endif
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_RED, display_host_get_pixel(99, 99));
+    TEST_ASSERT_EQUAL_HEX16(UI_COLOR_GREEN, display_host_get_pixel(99, 199));
+}
+
 // ============================================================================
 // Test Runner
 // ============================================================================
@@ -271,5 +2922,142 @@ int main(int argc, char **argv) {
     RUN_TEST(test_full_chain_empty_tank);
     RUN_TEST(test_full_chain_half_tank);
     
+    // Multi-tank aggregation tests
+    RUN_TEST(test_aggregate_total_and_imbalance);
+    RUN_TEST(test_transfer_rate_opposite_signs);
+    RUN_TEST(test_transfer_rate_consumption_is_not_transfer);
+    RUN_TEST(test_aggregate_detects_transfer_trace);
+    RUN_TEST(test_summary_view_equal);
+    
+    // Trip computer tests
+    RUN_TEST(test_trip_mpg_calculation);
+    RUN_TEST(test_trip_distance_and_fuel_trace);
+    RUN_TEST(test_trip_counter_wrap_is_drift_free);
+    RUN_TEST(test_trip_refuel_resets_trip_keeps_lifetime);
+    RUN_TEST(test_trip_range_uses_economy);
+    
+    // LP-core sampling logic tests
+    RUN_TEST(test_lp_decimation_averages_samples);
+    RUN_TEST(test_lp_wakes_on_ignition_and_buffer_full);
+    RUN_TEST(test_lp_wakes_on_level_drop);
+    RUN_TEST(test_lp_slow_leak_across_buffer_full_wakes);
+    RUN_TEST(test_lp_batch_ingest_through_pipeline);
+    
+    // Time-aware damping tests
+    RUN_TEST(test_ema_alpha_limits);
+    RUN_TEST(test_ema_time_constant_with_irregular_steps);
+    RUN_TEST(test_ema_response_independent_of_sample_rate);
+    RUN_TEST(test_ingest_uses_sample_timestamps);
+    
+    // Batch conversion tests
+    RUN_TEST(test_batch_matches_scalar_chain);
+    RUN_TEST(test_batch_convert_throughput);
+    
+    // Display host harness tests
+    RUN_TEST(test_host_harness_draws_pixels);
+    RUN_TEST(test_gauge_sprite_single_transfer);
+    
+    // Incremental bar update tests
+    RUN_TEST(test_delta_rows_match_full_redraw);
+    RUN_TEST(test_delta_rows_one_pixel_cost);
+    
+    // Draw command batching tests
+    RUN_TEST(test_draw_batch_coalesces);
+    RUN_TEST(test_frame_batch_gauge_identical);
+    RUN_TEST(test_frame_batch_coalesces_row_fills);
+    
+    // Row-color streaming tests
+    RUN_TEST(test_row_stream_matches_bar);
+    RUN_TEST(test_row_stream_vs_sprite_benchmark);
+    
+    // Row color table tests
+    RUN_TEST(test_row_lut_discrete_pixel_identical);
+    RUN_TEST(test_row_lut_covers_every_row);
+    
+    // Glyph cache readout tests
+    RUN_TEST(test_glyph_readout_matches_font);
+    RUN_TEST(test_glyph_readout_sends_changed_chars);
+    
+    // Clip region tests
+    RUN_TEST(test_clip_visible_subtracts_exclusions);
+    RUN_TEST(test_clip_gauge_leaves_overlay_untouched);
+    RUN_TEST(test_clip_canvas_split_one_window_per_piece);
+    RUN_TEST(test_clip_clear_ignores_exclusions);
+    
+    
+    // Level animation tests
+    RUN_TEST(test_anim_ease_endpoints_and_monotonic);
+    RUN_TEST(test_anim_frame_rate_independent);
+    RUN_TEST(test_anim_retarget_continues_from_shown);
+    RUN_TEST(test_anim_subpixel_target_stays_idle);
+    RUN_TEST(test_anim_frames_end_on_full_redraw);
+    
+    
+    // Fuel history tests
+    RUN_TEST(test_history_cascades_averages);
+    RUN_TEST(test_history_samples_on_interval);
+    RUN_TEST(test_history_page_scrolls_one_row_per_sample);
+    
+    
+    // Dial gauge tests
+    RUN_TEST(test_dial_band_pixels);
+    RUN_TEST(test_dial_delta_spans_match_full_draw);
+    RUN_TEST(test_dial_one_step_cost);
+    
+    // Compile-time gauge layout tests
+    RUN_TEST(test_gauge_template_layout);
+    RUN_TEST(test_gauge_template_horizontal_fill);
+    RUN_TEST(test_gauge_template_sizes_coexist);
+    
+    // Low fuel alert tests
+    RUN_TEST(test_alert_effect_colors);
+    RUN_TEST(test_alert_hysteresis);
+    RUN_TEST(test_alert_toggle_bounded_bytes);
+    RUN_TEST(test_alert_slot_survives_updates);
+    
+    // Page compositor tests
+    RUN_TEST(test_page_show_restores_in_one_push);
+    RUN_TEST(test_page_over_budget_draws_directly);
+    RUN_TEST(test_page_switch_gauges_background_plus_dynamic);
+    
+    // Flash asset tests
+    RUN_TEST(test_asset_round_trip_both_formats);
+    RUN_TEST(test_asset_flash_images_match_encoder);
+    RUN_TEST(test_asset_clipped_and_malformed);
+    
+    // Display hysteresis tests
+    RUN_TEST(test_shown_value_holds_on_reversal_only);
+    RUN_TEST(test_gauge_noise_replay_redraws);
+    RUN_TEST(test_debug_overlay_ignores_adc_jitter);
+    
+    // Text formatter tests
+    RUN_TEST(test_text_format_padding_and_alignment);
+    RUN_TEST(test_text_format_matches_printf);
+    RUN_TEST(test_text_width_from_font_metrics);
+    RUN_TEST(test_text_format_benchmark);
+    
+    // Widget tree tests
+    RUN_TEST(test_ui_dirty_widget_draws_alone);
+    RUN_TEST(test_ui_overlay_keeps_its_pixels);
+    RUN_TEST(test_ui_damage_merges_rects);
+    
+    // Layout tests
+    RUN_TEST(test_layout_default_board);
+    RUN_TEST(test_layout_fits_every_board);
+    RUN_TEST(test_layout_flags_what_does_not_fit);
+    
+    // Indexed frame tests
+    RUN_TEST(test_indexed_frame_fill_and_write);
+    RUN_TEST(test_indexed_frame_pushes_dirty_rows_in_chunks);
+    RUN_TEST(test_indexed_frame_recolor_marks_rows_of_that_color);
+    RUN_TEST(test_indexed_display_matches_direct);
+    RUN_TEST(test_indexed_frame_benchmark);
+    
+    // Push pipeline tests
+    RUN_TEST(test_push_pipeline_expands_while_bus_busy);
+    RUN_TEST(test_display_push_runs_behind_loop);
+    RUN_TEST(test_display_timing_benchmark);
+    RUN_TEST(test_canvas_double_buffer_overlaps_bus);
+    
     return UNITY_END();
 }
@@ -0,0 +1,283 @@
+"""
+Convert assets/*.png into compressed RGB565 streams in flash
+
+Writes src/display/asset_data.h and asset_data.cpp with one Asset per PNG
+(assets/fuel_pump.png -> asset_fuel_pump). Each image is encoded both as
+RLE565 and, if it has at most 16 colors, as palette runs; the smaller stream
+is kept. The formats are described in src/display/asset.h and the encoders
+match asset_encode() byte for byte.
+
+Transparent pixels (alpha < 128) become the background color. Outputs are
+only rewritten when their content changes, so an unchanged asset does not
+trigger a rebuild.
+
+Usage:
+    python3 tools/asset_pack.py          (standalone)
+    extra_scripts = pre:tools/asset_pack.py   (PlatformIO, runs every build)
+
+Only the Python standard library is used (no Pillow): 8-bit grayscale, RGB,
+RGBA and gray+alpha PNGs plus 1/2/4/8-bit indexed PNGs, non-interlaced.
+"""
+
+import glob
+import os
+import struct
+import zlib
+
+BACKGROUND = 0x0000             # COLOR_BACKGROUND
+RLE_RUN_MAX = 128
+PALETTE_MAX = 16
+PALETTE_SHORT_MAX = 15
+PALETTE_RUN_MAX = 271
+
+FORMAT_RLE565 = 0
+FORMAT_PALETTE = 1
+
+
+# =============================================================================
+# PNG decoding
+# =============================================================================
+
+def _paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(path):
+    """Return (width, height, rows) with rows of (r, g, b, a) tuples."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s: not a PNG" % path)
+
+    pos = 8
+    idat = b""
+    plte = []
+    trns = b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, ctype, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            plte = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+
+    if interlace:
+        raise ValueError("%s: interlaced PNGs are not supported" % path)
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[ctype]
+    if ctype != 3 and depth != 8:
+        raise ValueError("%s: only 8-bit channels are supported" % path)
+
+    bits = depth * channels
+    stride = (width * bits + 7) // 8
+    bpp = max(1, bits // 8)
+    raw = zlib.decompress(idat)
+
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        start = y * (stride + 1)
+        ftype = raw[start]
+        line = bytearray(raw[start + 1:start + 1 + stride])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif ftype == 4:
+                line[i] = (line[i] + _paeth(a, b, c)) & 0xFF
+        prev = line
+
+        row = []
+        for x in range(width):
+            if ctype == 3:
+                per_byte = 8 // depth
+                shift = 8 - depth * (x % per_byte + 1)
+                index = (line[x // per_byte] >> shift) & ((1 << depth) - 1)
+                alpha = trns[index] if index < len(trns) else 255
+                row.append(plte[index] + (alpha,))
+            elif ctype == 0:
+                g = line[x]
+                row.append((g, g, g, 255))
+            elif ctype == 4:
+                g = line[2 * x]
+                row.append((g, g, g, line[2 * x + 1]))
+            elif ctype == 2:
+                row.append(tuple(line[3 * x:3 * x + 3]) + (255,))
+            else:
+                row.append(tuple(line[4 * x:4 * x + 4]))
+        rows.append(row)
+    return width, height, rows
+
+
+def to_rgb565(rows):
+    pixels = []
+    for row in rows:
+        for r, g, b, a in row:
+            if a < 128:
+                pixels.append(BACKGROUND)
+            else:
+                pixels.append(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+    return pixels
+
+
+# =============================================================================
+# Encoding (mirrors asset_encode() in src/display/asset.cpp)
+# =============================================================================
+
+def encode_rle565(px):
+    out = bytearray()
+    n = len(px)
+    i = 0
+    while i < n:
+        run = 1
+        while i + run < n and run < RLE_RUN_MAX and px[i + run] == px[i]:
+            run += 1
+        if run >= 2:
+            out += bytes((0x80 | (run - 1), px[i] & 0xFF, px[i] >> 8))
+            i += run
+            continue
+
+        # Literals up to the start of the next repeat
+        j = i + 1
+        while j < n and j - i < RLE_RUN_MAX and not (j + 1 < n and px[j + 1] == px[j]):
+            j += 1
+        out.append(j - i - 1)
+        for c in px[i:j]:
+            out += bytes((c & 0xFF, c >> 8))
+        i = j
+    return bytes(out)
+
+
+def encode_palette(px):
+    palette = []
+    for c in px:
+        if c not in palette:
+            if len(palette) == PALETTE_MAX:
+                return None, None
+            palette.append(c)
+
+    out = bytearray()
+    n = len(px)
+    i = 0
+    while i < n:
+        run = 1
+        while i + run < n and run < PALETTE_RUN_MAX and px[i + run] == px[i]:
+            run += 1
+        index = palette.index(px[i])
+        if run <= PALETTE_SHORT_MAX:
+            out.append(((run - 1) << 4) | index)
+        else:
+            out += bytes(((PALETTE_SHORT_MAX << 4) | index, run - 16))
+        i += run
+    return palette, bytes(out)
+
+
+# =============================================================================
+# Output
+# =============================================================================
+
+def _hex_lines(values, fmt, per_line):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(fmt % v for v in values[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def pack(asset_dir, out_dir):
+    header = [
+        "#ifndef ASSET_DATA_H",
+        "#define ASSET_DATA_H",
+        "",
+        "// Generated by tools/asset_pack.py from assets/*.png - do not edit",
+        "",
+        '#include "asset.h"',
+        "",
+    ]
+    source = [
+        "// Generated by tools/asset_pack.py from assets/*.png - do not edit",
+        "",
+        '#include "asset_data.h"',
+    ]
+    report = []
+
+    for path in sorted(glob.glob(os.path.join(asset_dir, "*.png"))):
+        name = "asset_" + os.path.splitext(os.path.basename(path))[0]
+        width, height, rows = read_png(path)
+        px = to_rgb565(rows)
+
+        stream = encode_rle565(px)
+        fmt = FORMAT_RLE565
+        palette = None
+        pal, pal_stream = encode_palette(px)
+        if pal is not None and 2 * len(pal) + len(pal_stream) < len(stream):
+            fmt, palette, stream = FORMAT_PALETTE, pal, pal_stream
+
+        header.append("extern const Asset %s;%s// %dx%d" %
+                      (name, " " * max(1, 24 - len(name)), width, height))
+        source.append("")
+        if palette:
+            source.append("static const uint16_t %s_palette[] = {" % name)
+            source.append(_hex_lines(palette, "0x%04X", 8))
+            source.append("};")
+            source.append("")
+        source.append("static const uint8_t %s_data[] = {" % name)
+        source.append(_hex_lines(stream, "0x%02X", 12))
+        source.append("};")
+        source.append("")
+        source.append("const Asset %s = {" % name)
+        source.append("    %d, %d, %s, %d, %s," % (
+            width, height,
+            "ASSET_FORMAT_PALETTE" if palette else "ASSET_FORMAT_RLE565",
+            len(palette) if palette else 0,
+            name + "_palette" if palette else "nullptr"))
+        source.append("    %s_data, sizeof(%s_data)" % (name, name))
+        source.append("};")
+
+        stored = len(stream) + (2 * len(palette) if palette else 0)
+        report.append("%s: %dx%d, %d bytes (%s, raw %d)" % (
+            name, width, height, stored, "palette" if palette else "rle565", 2 * len(px)))
+
+    header += ["", "#endif // ASSET_DATA_H"]
+    _write_if_changed(os.path.join(out_dir, "asset_data.h"), "\n".join(header) + "\n")
+    _write_if_changed(os.path.join(out_dir, "asset_data.cpp"), "\n".join(source) + "\n")
+    return report
+
+
+def _write_if_changed(path, text):
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == text:
+                return
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def main(project_dir):
+    report = pack(os.path.join(project_dir, "assets"),
+                  os.path.join(project_dir, "src", "display"))
+    for line in report:
+        print("[ASSETS] " + line)
+
+
+try:
+    Import("env")  # noqa: F821 - defined when run as a PlatformIO extra script
+    main(env["PROJECT_DIR"])  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        main(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))